@@ -0,0 +1,88 @@
+#include "testCommon.h"
+#include "correlator.h"
+#include "simdKernels.h"
+#include <cstdio>
+
+namespace
+{
+    /// @brief The default signal length the crossover is measured on
+    constexpr size_t BENCH_SIGNAL_SAMPLES = 1 << 14;
+
+    /// @brief The shortest reference length measured, the lengths double up to BENCH_MAX_TAPS
+    constexpr size_t BENCH_MIN_TAPS = 4;
+
+    /// @brief The longest reference length measured
+    constexpr size_t BENCH_MAX_TAPS = 1 << 12;
+
+    /// @brief The amount of runs of every measurement, the fastest one is kept
+    constexpr unsigned int BENCH_RUNS = 5;
+
+    /**
+     * @brief Time the correlation of a signal against a reference with one method
+     *
+     * @param p_reference - the reference
+     * @param p_method - how the correlations are computed
+     * @param p_signal - the signal
+     *
+     * @return the time in second, the FFT plan and the reference spectrum are built before the timing
+     */
+    double timeCorrelation(const std::vector<std::complex<double>> &p_reference, const CorrelationMethod p_method,
+                           const std::vector<std::complex<double>> &p_signal)
+    {
+        Correlator correlator(p_reference, p_method);
+        std::vector<std::complex<double>> output;
+        return timeFastest(BENCH_RUNS, [&]() { output = correlator.correlate(p_signal); });
+    }
+}
+
+/**
+ * @brief Time the direct and the overlap-save correlations on doubling reference lengths and print the crossover,
+ * the value to set in /correlation/fftMinTaps
+ *
+ * Usage: correlationBench [signal samples]
+ */
+int main(int argc, char **argv)
+{
+    initTestDatabase();
+    const size_t sampleCount = (argc > 1) ? std::stoul(argv[1]) : BENCH_SIGNAL_SAMPLES;
+    std::default_random_engine generator(0);
+    std::normal_distribution<double> distribution(0, 1);
+    std::vector<std::complex<double>> signal(sampleCount);
+    for (std::complex<double> &sample : signal)
+    {
+        sample = {distribution(generator), distribution(generator)};
+    }
+
+    std::printf("%zu samples, %s kernels\n", sampleCount, SimdKernels::getInstance().getLevelName());
+    std::printf("%8s %12s %12s\n", "taps", "direct (ms)", "FFT (ms)");
+    // The direct cost grows with the length and the overlap-save one with its log, the first length where the
+    // overlap-save correlation wins twice in a row is taken as the crossover
+    size_t minFftTaps = 0;
+    unsigned int fftWins = 0;
+    for (size_t tapCount = BENCH_MIN_TAPS; tapCount <= std::min(BENCH_MAX_TAPS, sampleCount); tapCount *= 2)
+    {
+        std::vector<std::complex<double>> reference(signal.begin(), signal.begin() + tapCount);
+        double directTime = timeCorrelation(reference, CorrelationMethod::DIRECT, signal);
+        double fftTime = timeCorrelation(reference, CorrelationMethod::OVERLAP_SAVE, signal);
+        std::printf("%8zu %12.3f %12.3f\n", tapCount, directTime * 1e3, fftTime * 1e3);
+        if (fftTime < directTime)
+        {
+            minFftTaps = (fftWins == 0) ? tapCount : minFftTaps;
+            ++fftWins;
+        }
+        else
+        {
+            fftWins = 0;
+        }
+    }
+    if (fftWins < 2)
+    {
+        std::printf("The FFT does not stay faster up to %zu taps\n", BENCH_MAX_TAPS);
+    }
+    else
+    {
+        std::printf("Correlations are faster on the FFT from %zu taps, the server uses %zu\n", minFftTaps,
+                    CorrelationCrossover::getInstance().getMinFftTaps());
+    }
+    return 0;
+}
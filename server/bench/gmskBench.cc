@@ -0,0 +1,63 @@
+#include "testCommon.h"
+#include "gmsk.h"
+#include "modulator.h"
+#include <cstdio>
+
+namespace
+{
+    /// @brief The default amount of bits of the message
+    constexpr size_t BENCH_MESSAGE_BITS = 1200;
+
+    /// @brief The amount of runs of every measurement, the fastest one is kept
+    constexpr unsigned int BENCH_RUNS = 3;
+
+    /**
+     * @brief Time the 2G modulation and demodulation of one message on one carrier and print a row of the table
+     *
+     * @param p_scheme - ASK or GMSK
+     * @param p_detector - the GMSK detector of the database, ignored for ASK
+     * @param p_frequency - the carrier frequency
+     * @param p_message - the message
+     */
+    void benchScheme(const ModulationScheme p_scheme, const std::string &p_detector, const double p_frequency,
+                     const BitBuffer &p_message)
+    {
+        setTestValue(GMSK_DETECTOR_KEY, "char", p_detector);
+        Modulator modulator;
+        modulator.setFrequency(p_frequency);
+        modulator.setBinaryInput(p_message);
+        std::vector<double> signal;
+        double modulateTime = timeFastest(BENCH_RUNS, [&]() { signal = modulator.modulate<double>(p_scheme); });
+        BitBuffer received;
+        double demodulateTime = timeFastest(BENCH_RUNS, [&]() { received = modulator.demodulate(signal, p_scheme); });
+        std::vector<std::complex<double>> baseband = modulator.modulateBaseband(p_scheme);
+        modulator.addNoise(baseband);
+        BitBuffer basebandReceived = modulator.demodulateBaseband(baseband, p_scheme);
+        std::printf("%6.1f %-6s %-12s %10zu %16.2f %16.2f %8zu %8zu\n", p_frequency, getSchemeName(p_scheme),
+                    (p_scheme == ModulationScheme::GMSK) ? p_detector.c_str() : "-", signal.size(),
+                    signal.size() / modulateTime / 1e6, signal.size() / demodulateTime / 1e6, p_message.countErrors(received, 0),
+                    p_message.countErrors(basebandReceived, 0));
+    }
+}
+
+/**
+ * @brief Compare the GMSK and ASK modulation of the 2G network in samples per second and bit errors
+ *
+ * Usage: gmskBench [message bits]
+ */
+int main(int argc, char **argv)
+{
+    initTestDatabase();
+    const size_t bitCount = (argc > 1) ? std::stoul(argv[1]) : BENCH_MESSAGE_BITS;
+    BitBuffer message = generateTestMessage(bitCount, 0);
+    std::printf("%zu bits, channel noise of the sessions\n", bitCount);
+    std::printf("%6s %-6s %-12s %10s %16s %16s %8s %8s\n", "f (Hz)", "scheme", "detector", "samples", "modulate Msa/s",
+                "demodulate Msa/s", "errors", "baseband");
+    for (double frequency : {1.0, 3.0, 7.0, 10.0})
+    {
+        benchScheme(ModulationScheme::ASK, "viterbi", frequency, message);
+        benchScheme(ModulationScheme::GMSK, "viterbi", frequency, message);
+        benchScheme(ModulationScheme::GMSK, "differential", frequency, message);
+    }
+    return 0;
+}
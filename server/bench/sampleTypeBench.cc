@@ -0,0 +1,65 @@
+#include "testCommon.h"
+#include "modulator.h"
+#include <cstdio>
+
+namespace
+{
+    /// @brief The default amount of bits of the message
+    constexpr size_t BENCH_MESSAGE_BITS = 20000;
+
+    /// @brief The default standard deviation of the noise added between modulation and demodulation
+    constexpr double BENCH_NOISE_SIGMA = 0.5;
+
+    /// @brief The carrier frequency of the bench, a symbol is one carrier cycle of 50 samples at the default sample rate
+    constexpr double BENCH_CARRIER_FREQUENCY = 100;
+
+    /// @brief The amount of runs of every measurement, the fastest one is kept
+    constexpr unsigned int BENCH_RUNS = 5;
+
+    /**
+     * @brief Time the modulation and demodulation of one message in one sample type and print a row of the table
+     *
+     * @tparam T - the sample type
+     * @param p_typeName - the name of the sample type
+     * @param p_scheme - the scheme
+     * @param p_message - the message
+     * @param p_sigma - the standard deviation of the noise
+     */
+    template <typename T>
+    void benchSampleType(const char *p_typeName, const ModulationScheme p_scheme, const BitBuffer &p_message, const double p_sigma)
+    {
+        Modulator modulator;
+        modulator.setFrequency(BENCH_CARRIER_FREQUENCY);
+        modulator.setBinaryInput(p_message);
+        std::vector<T> signal;
+        double modulateTime = timeFastest(BENCH_RUNS, [&]() { signal = modulator.modulate<T>(p_scheme); });
+        addTestNoise(signal, p_sigma, 1);
+        BitBuffer received;
+        double demodulateTime = timeFastest(BENCH_RUNS, [&]() { received = modulator.demodulate(signal, p_scheme); });
+        std::printf("%-8s %-8s %10zu %16.3f %16.3f %10.5f\n", getSchemeName(p_scheme), p_typeName, signal.size(),
+                    signal.size() / modulateTime / 1e6, signal.size() / demodulateTime / 1e6,
+                    static_cast<double>(p_message.countErrors(received, 0)) / p_message.size());
+    }
+}
+
+/**
+ * @brief Modulate, add noise and demodulate a message in every sample type, printing samples per second and BER
+ *
+ * Usage: sampleTypeBench [message bits] [noise sigma]
+ */
+int main(int argc, char **argv)
+{
+    initTestDatabase();
+    const size_t bitCount = (argc > 1) ? std::stoul(argv[1]) : BENCH_MESSAGE_BITS;
+    const double sigma = (argc > 2) ? std::stod(argv[2]) : BENCH_NOISE_SIGMA;
+    std::printf("%zu bits, noise sigma %g, %g Hz carrier\n", bitCount, sigma, BENCH_CARRIER_FREQUENCY);
+    std::printf("%-8s %-8s %10s %16s %16s %10s\n", "scheme", "type", "samples", "modulate Msa/s", "demodulate Msa/s", "BER");
+    for (ModulationScheme scheme : {ModulationScheme::ASK, ModulationScheme::PSK, ModulationScheme::FSK, ModulationScheme::QAM16})
+    {
+        BitBuffer message = generateTestMessage(bitCount, static_cast<unsigned int>(scheme));
+        benchSampleType<double>("double", scheme, message, sigma);
+        benchSampleType<float>("float", scheme, message, sigma);
+        benchSampleType<int16_t>("int16", scheme, message, sigma);
+    }
+    return 0;
+}
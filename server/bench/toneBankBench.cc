@@ -0,0 +1,84 @@
+#include "testCommon.h"
+#include "modulator.h"
+#include "simdKernels.h"
+#include <cstdio>
+
+namespace
+{
+    /// @brief The default amount of bits of the message, whole symbols of every FSK order
+    constexpr size_t BENCH_MESSAGE_BITS = 24000;
+
+    /// @brief The default standard deviation of the noise added to the signal, relative to a unit carrier
+    constexpr double BENCH_NOISE_SIGMA = 0.5;
+
+    /// @brief The default carrier frequency
+    constexpr double BENCH_CARRIER_FREQUENCY = 3;
+
+    /// @brief The amount of runs of every measurement, the fastest one is kept
+    constexpr unsigned int BENCH_RUNS = 5;
+
+    /**
+     * @brief Time both FSK detectors on one sample path and print a row of the table per detector
+     *
+     * @tparam T - the sample type
+     * @param p_modulator - the modulator, set up for the scheme
+     * @param p_scheme - the FSK scheme
+     * @param p_signal - the noisy signal in double
+     * @param p_message - the message
+     * @param p_name - the name of the sample path
+     */
+    template <typename T>
+    void benchSamplePath(Modulator &p_modulator, const ModulationScheme p_scheme, const std::vector<double> &p_signal,
+                         const BitBuffer &p_message, const char *p_name)
+    {
+        std::vector<T> signal(p_signal.size());
+        for (size_t sampleIdx = 0; sampleIdx < p_signal.size(); ++sampleIdx)
+        {
+            signal[sampleIdx] = SampleTraits<T>::fromDouble(p_signal[sampleIdx]);
+        }
+        for (FskDetection detection : {FskDetection::CORRELATOR, FskDetection::GOERTZEL})
+        {
+            p_modulator.setFskDetection(detection);
+            BitBuffer received;
+            double time = timeFastest(BENCH_RUNS, [&]() { received = p_modulator.demodulate(signal, p_scheme); });
+            std::printf("%-6s %-18s %-10s %10.2f %16.2f %8zu\n", getSchemeName(p_scheme), p_name,
+                        (detection == FskDetection::GOERTZEL) ? "goertzel" : "correlator", time * 1e3,
+                        signal.size() / time / 1e6, p_message.countErrors(received, 0));
+        }
+    }
+}
+
+/**
+ * @brief Compare the Goertzel tone bank with the template correlator of the FSK receivers in time and bit errors
+ *
+ * Usage: toneBankBench [message bits] [noise sigma] [carrier frequency]
+ */
+int main(int argc, char **argv)
+{
+    initTestDatabase();
+    const size_t bitCount = (argc > 1) ? std::stoul(argv[1]) : BENCH_MESSAGE_BITS;
+    const double sigma = (argc > 2) ? std::stod(argv[2]) : BENCH_NOISE_SIGMA;
+    const double frequency = (argc > 3) ? std::stod(argv[3]) : BENCH_CARRIER_FREQUENCY;
+    BitBuffer message = generateTestMessage(bitCount, 0);
+    std::printf("%zu bits, sigma %g, %g Hz, %s kernels, single thread\n", bitCount, sigma, frequency,
+                SimdKernels::getInstance().getLevelName());
+    std::printf("%-6s %-18s %-10s %10s %16s %8s\n", "scheme", "samples", "detector", "time (ms)", "demodulate Msa/s", "errors");
+
+    // One thread so the table compares the detectors and not the split
+    setTestValue(THREAD_COUNT_KEY, "u32", "1");
+    for (ModulationScheme scheme : {ModulationScheme::FSK, ModulationScheme::FSK8})
+    {
+        Modulator modulator;
+        modulator.setFrequency(frequency);
+        modulator.setNoisy(false);
+        modulator.setBinaryInput(message);
+        std::vector<double> signal = modulator.modulate<double>(scheme);
+        addTestNoise(signal, sigma, 1);
+        benchSamplePath<double>(modulator, scheme, signal, message, "double");
+        benchSamplePath<float>(modulator, scheme, signal, message, "float");
+        benchSamplePath<int16_t>(modulator, scheme, signal, message, "int16");
+        modulator.setArithmetic(Arithmetic::FIXED_POINT);
+        benchSamplePath<int16_t>(modulator, scheme, signal, message, "fixed-point int16");
+    }
+    return 0;
+}
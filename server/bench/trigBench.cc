@@ -0,0 +1,51 @@
+#include "testCommon.h"
+#include "sineTable.h"
+#include <cstdio>
+
+namespace
+{
+    /// @brief The amount of random phases turned into phasors by every run
+    constexpr size_t BENCH_PHASE_COUNT = 1 << 20;
+
+    /// @brief The amount of runs of every measurement, the fastest one is kept
+    constexpr unsigned int BENCH_RUNS = 10;
+}
+
+/**
+ * @brief Time the quarter-wave sine table against std::polar on random phases of the oscillator phase scale
+ */
+int main()
+{
+    std::default_random_engine generator(1);
+    std::uniform_int_distribution<uint64_t> distribution;
+    std::vector<uint64_t> phases(BENCH_PHASE_COUNT);
+    for (uint64_t &phase : phases)
+    {
+        phase = distribution(generator);
+    }
+
+    // The sums keep the phasors alive, the compiler cannot drop the loops
+    std::complex<double> tableSum = 0;
+    double tableTime = timeFastest(BENCH_RUNS,
+                                   [&]()
+                                   {
+                                       for (uint64_t phase : phases)
+                                       {
+                                           tableSum += lookupPhasor(phase);
+                                       }
+                                   });
+    std::complex<double> polarSum = 0;
+    double polarTime = timeFastest(BENCH_RUNS,
+                                   [&]()
+                                   {
+                                       for (uint64_t phase : phases)
+                                       {
+                                           polarSum += std::polar(1.0, 2 * M_PI * (static_cast<double>(phase) * 0x1p-64));
+                                       }
+                                   });
+    std::printf("%u table bits, %zu random phases, error bound %g\n", SINE_TABLE_BITS, BENCH_PHASE_COUNT, SINE_TABLE_MAX_ERROR);
+    std::printf("table      %6.2f ns per phasor\n", tableTime * 1e9 / BENCH_PHASE_COUNT);
+    std::printf("std::polar %6.2f ns per phasor\n", polarTime * 1e9 / BENCH_PHASE_COUNT);
+    std::printf("checksums %g %g\n", std::abs(tableSum), std::abs(polarSum));
+    return 0;
+}
@@ -0,0 +1,179 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @brief The amount of bits packed in one word of a bit buffer
+constexpr size_t BIT_BUFFER_WORD_BITS = 64;
+
+/**
+ * @brief Binary data series packed 64 bits per word, the first bit is the most significant bit of the first word
+ *
+ * A symbol of k bits is read with one shift and one mask, and appended the same way, the bits of a symbol
+ * stay in the order they are written in the binary series. The bits after the last one are always 0, so
+ * buffers compare and count errors word by word.
+ */
+class BitBuffer
+{
+public:
+    /// @brief Default constructor, an empty buffer
+    BitBuffer();
+
+    /**
+     * @brief Validate an ASCII binary series and pack it in one pass with the selected SIMD kernel
+     *
+     * @param p_ascii - a series of '0' and '1' characters
+     * @param p_bits - the packed series, left empty when the series is not binary
+     *
+     * @return true - the series only holds '0' and '1', false - otherwise
+     */
+    static bool pack(const std::string &p_ascii, BitBuffer &p_bits);
+
+    /**
+     * @brief Unpack the series to ASCII, for the client reply and the logs
+     *
+     * @return a series of '0' and '1' characters
+     */
+    std::string toString() const;
+
+    /**
+     * @brief Get the amount of bits
+     *
+     * @return the amount of bits of the series
+     */
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief Check whether the series holds no bit
+     *
+     * @return true - the series is empty, false - otherwise
+     */
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /**
+     * @brief Read one bit
+     *
+     * @param p_bitIdx - index of the bit, below size()
+     *
+     * @return 0 or 1
+     */
+    unsigned int getBit(const size_t p_bitIdx) const
+    {
+        return static_cast<unsigned int>(m_words[p_bitIdx / BIT_BUFFER_WORD_BITS] >> (BIT_BUFFER_WORD_BITS - 1 - p_bitIdx % BIT_BUFFER_WORD_BITS)) & 1;
+    }
+
+    /**
+     * @brief Read consecutive bits as one value, e.g. the bits of a symbol
+     *
+     * @param p_firstBit - index of the first bit, the most significant one of the value
+     * @param p_count - the amount of bits, 1 to 32, p_firstBit + p_count must not exceed size()
+     *
+     * @return the value of the bits
+     */
+    unsigned int getBits(const size_t p_firstBit, const unsigned int p_count) const
+    {
+        const size_t wordIdx = p_firstBit / BIT_BUFFER_WORD_BITS;
+        const unsigned int offset = p_firstBit % BIT_BUFFER_WORD_BITS;
+        // Left align the bits from p_firstBit, a symbol crossing a word boundary takes its last bits from the next word
+        uint64_t window = m_words[wordIdx] << offset;
+        if (offset + p_count > BIT_BUFFER_WORD_BITS)
+        {
+            window |= m_words[wordIdx + 1] >> (BIT_BUFFER_WORD_BITS - offset);
+        }
+        return static_cast<unsigned int>(window >> (BIT_BUFFER_WORD_BITS - p_count));
+    }
+
+    /**
+     * @brief Append consecutive bits given as one value, e.g. the bits of a decided symbol
+     *
+     * @param p_value - the bits, the most significant one is appended first, higher bits must be 0
+     * @param p_count - the amount of bits, 1 to 32
+     */
+    void pushBits(const unsigned int p_value, const unsigned int p_count)
+    {
+        const unsigned int offset = m_size % BIT_BUFFER_WORD_BITS;
+        if (offset == 0)
+        {
+            m_words.push_back(0);
+        }
+        const uint64_t bits = p_value;
+        if (offset + p_count <= BIT_BUFFER_WORD_BITS)
+        {
+            m_words.back() |= bits << (BIT_BUFFER_WORD_BITS - offset - p_count);
+        }
+        else
+        {
+            const unsigned int spill = offset + p_count - BIT_BUFFER_WORD_BITS;
+            m_words.back() |= bits >> spill;
+            m_words.push_back(bits << (BIT_BUFFER_WORD_BITS - spill));
+        }
+        m_size += p_count;
+    }
+
+    /**
+     * @brief Overwrite one bit
+     *
+     * @param p_bitIdx - index of the bit, below size()
+     * @param p_value - 0 or 1
+     */
+    void setBit(const size_t p_bitIdx, const unsigned int p_value);
+
+    /**
+     * @brief Append another series, word by word when this one ends on a word boundary
+     *
+     * @param p_bits - the series to append
+     */
+    void append(const BitBuffer &p_bits);
+
+    /**
+     * @brief Change the amount of bits, new bits are 0
+     *
+     * @param p_size - the new amount of bits
+     */
+    void resize(const size_t p_size);
+
+    /**
+     * @brief Allocate the words of a series of known length up front
+     *
+     * @param p_size - the expected amount of bits
+     */
+    void reserve(const size_t p_size);
+
+    /**
+     * @brief Remove every bit
+     */
+    void clear();
+
+    /**
+     * @brief Count the received bits from p_firstBit that differ from this series, the ones past its end all count
+     *
+     * @param p_received - the received series
+     * @param p_firstBit - index of the first received bit to check
+     *
+     * @return the amount of bit errors
+     */
+    size_t countErrors(const BitBuffer &p_received, const size_t p_firstBit) const;
+
+    /**
+     * @brief Compare two series bit for bit
+     *
+     * @return true - same length and same bits, false - otherwise
+     */
+    bool operator==(const BitBuffer &p_other) const;
+
+    bool operator!=(const BitBuffer &p_other) const;
+
+private:
+    /// @brief The packed bits, the unused low bits of the last word are 0
+    std::vector<uint64_t> m_words;
+
+    /// @brief The amount of bits
+    size_t m_size;
+};
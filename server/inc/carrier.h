@@ -1,12 +1,16 @@
 #pragma once
 #include <string>
 #include "serverCommon.h"
+#include "modulationScheme.h"
+#include "sampleTraits.h"
 
 class Carrier
 {
 private:
 	bool m_flagCarrier;
 	std::string m_network;
+	ModulationScheme m_scheme;
+	Arithmetic m_arithmetic;
 	size_t m_frequency;
 
 public:
@@ -35,6 +39,20 @@ public:
 	 */
 	std::string getNetwork();
 
+	/**
+	 * @brief function is called to get the modulation scheme of the network, resolved once when the network is set up
+	 *
+	 * @return modulation scheme of the network, UNKNOWN when no network has been set up
+	 */
+	ModulationScheme getScheme();
+
+	/**
+	 * @brief function is called to get the arithmetic the network is simulated in, resolved once when the network is set up
+	 *
+	 * @return FIXED_POINT when the network is listed in /fixedPointCarriers, FLOATING_POINT otherwise
+	 */
+	Arithmetic getArithmetic();
+
 	/**
 	 * @brief function is called to set frequency
 	 *
@@ -76,4 +94,29 @@ public:
 	 * @return false - server isn't supported, true - server is supported
 	 */
 	bool checkSupportedFrequency(const ssize_t &p_freq);
+
+private:
+	/**
+	 * @brief function is called to read the constellation order configured for a network
+	 *
+	 * @param p_network - network that is set up
+	 * @return the configured order, 0 when the network has no order setting
+	 */
+	unsigned long readSchemeOrder(const std::string &p_network);
+
+	/**
+	 * @brief function is called to read the modulation configured for a network
+	 *
+	 * @param p_network - network that is set up
+	 * @return the configured modulation, empty when the network has no modulation setting
+	 */
+	std::string readSchemeModulation(const std::string &p_network);
+
+	/**
+	 * @brief function is called to read the arithmetic configured for a network
+	 *
+	 * @param p_network - network that is set up
+	 * @return FIXED_POINT when the network is a fixed-point carrier, FLOATING_POINT when it is not or nothing is configured
+	 */
+	Arithmetic readArithmetic(const std::string &p_network);
 };
\ No newline at end of file
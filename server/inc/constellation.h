@@ -0,0 +1,91 @@
+#pragma once
+#include <complex>
+#include <vector>
+
+/// @brief The point layouts a constellation can be generated with
+enum class ConstellationShape
+{
+    PSK,
+    QAM
+};
+
+/**
+ * @brief Gray mapped M-PSK or square M-QAM constellation with lookup tables for mapping and slicing
+ *
+ * Symbol values are read MSB first from the binary series. Mapping a symbol value to its point and
+ * slicing a received point back to the bits of its nearest symbol are both table lookups, so the cost
+ * per symbol does not grow with the order. Neighbouring points differ in one bit only, a symbol error
+ * caused by noise costs a single bit error.
+ */
+class Constellation
+{
+public:
+    /**
+     * @brief Customize Constructor to build the lookup tables of a constellation
+     *
+     * @param p_shape - PSK (points on the unit circle) or QAM (square grid)
+     * @param p_order - the amount of points, a power of 2 (and of 4 for QAM)
+     */
+    Constellation(const ConstellationShape p_shape, const unsigned int p_order);
+
+    /**
+     * @brief Get the amount of points
+     *
+     * @return the order of the constellation
+     */
+    unsigned int getOrder() const;
+
+    /**
+     * @brief Get the amount of bits carried by one symbol
+     *
+     * @return log2 of the order
+     */
+    unsigned int getBitsPerSymbol() const;
+
+    /**
+     * @brief Get the point of every symbol value
+     *
+     * @return the I (real) and Q (imaginary) amplitude of every symbol, indexed by symbol value
+     */
+    const std::vector<std::complex<double>> &getPoints() const;
+
+    /**
+     * @brief Find the symbol whose point is the nearest to a received point
+     *
+     * @param p_point - the received I/Q point
+     *
+     * @return the symbol value of the nearest point
+     */
+    unsigned int slice(const std::complex<double> &p_point) const;
+
+private:
+    /// @brief PSK or QAM
+    ConstellationShape m_shape;
+
+    /// @brief The amount of points
+    unsigned int m_order;
+
+    /// @brief log2 of the order
+    unsigned int m_bitsPerSymbol;
+
+    /// @brief QAM: the amount of amplitude levels on each axis
+    unsigned int m_levelCount;
+
+    /// @brief PSK: the phase of the first point in radian
+    double m_phaseOffset;
+
+    /// @brief The point of every symbol value
+    std::vector<std::complex<double>> m_points;
+
+    /// @brief QAM: the Gray code of every amplitude level, PSK: the symbol value of every phase sector
+    std::vector<unsigned int> m_decisionTable;
+
+    /**
+     * @brief Convert a Gray code back to the binary index it encodes
+     *
+     * @param p_gray - a Gray code
+     *
+     * @return the binary index
+     */
+    static unsigned int decodeGray(unsigned int p_gray);
+};
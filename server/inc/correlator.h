@@ -0,0 +1,142 @@
+#pragma once
+#include "fft.h"
+#include <complex>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// @brief The reference length key from which correlations run on the FFT, 0 selects DEFAULT_CORRELATION_FFT_MIN_TAPS
+constexpr const char *CORRELATION_FFT_MIN_TAPS_KEY = "/correlation/fftMinTaps";
+
+/// @brief The reference length from which correlations run on the FFT when the database does not set one, measured
+/// with bench/correlationBench
+constexpr size_t DEFAULT_CORRELATION_FFT_MIN_TAPS = 256;
+
+/// @brief The overlap-save block is at least this many times the reference length, so most of every block is output
+constexpr size_t CORRELATION_FFT_BLOCK_FACTOR = 4;
+
+/// @brief How a correlation is computed
+enum class CorrelationMethod
+{
+    /// @brief One multiply-add per output and tap, O(N * M)
+    DIRECT,
+
+    /// @brief Overlap-save blocks multiplied by the reference spectrum, O(N * log M)
+    OVERLAP_SAVE
+};
+
+/**
+ * @brief Sliding correlation of complex signals against one reference, e.g. a long matched filter or a sync word
+ *
+ * Output n is sum x[n + k] * conj(r[k]) over the reference, for every n where the reference lies inside the signal.
+ * Short references are correlated directly with the SIMD slide kernel, long ones by overlap-save: the signal is cut
+ * into FFT blocks overlapping by the reference length and every block spectrum is multiplied by the conjugated
+ * reference spectrum, computed once. The plans come from FftPlanCache.
+ */
+class Correlator
+{
+public:
+    /**
+     * @brief Customize Constructor, the method is selected from the reference length, see CorrelationCrossover
+     *
+     * @param p_reference - the reference, at least one sample
+     */
+    explicit Correlator(const std::vector<std::complex<double>> &p_reference);
+
+    /**
+     * @brief Customize Constructor with a given method
+     *
+     * @param p_reference - the reference, at least one sample
+     * @param p_method - how the correlations are computed
+     */
+    Correlator(const std::vector<std::complex<double>> &p_reference, const CorrelationMethod p_method);
+
+    /**
+     * @brief Correlate a signal against the reference
+     *
+     * @param p_signal - the signal
+     *
+     * @return p_signal.size() - getTapCount() + 1 correlations, empty when the signal is shorter than the reference
+     */
+    std::vector<std::complex<double>> correlate(const std::vector<std::complex<double>> &p_signal) const;
+
+    /**
+     * @brief Get the reference length
+     *
+     * @return the amount of reference samples
+     */
+    size_t getTapCount() const;
+
+    /**
+     * @brief Get the method the correlations are computed with
+     *
+     * @return the method
+     */
+    CorrelationMethod getMethod() const;
+
+private:
+    /// @brief The reference
+    std::vector<std::complex<double>> m_reference;
+
+    /// @brief How the correlations are computed
+    CorrelationMethod m_method;
+
+    /// @brief The overlap-save block transform, nullptr for direct correlations
+    std::shared_ptr<const FftPlan> m_plan;
+
+    /// @brief The conjugated spectrum of the reference zero padded to the block size, divided by the block size
+    std::vector<std::complex<double>> m_spectrum;
+
+    /**
+     * @brief Correlate in the time domain with the SIMD slide kernel
+     *
+     * @param p_signal - the signal, not shorter than the reference
+     * @param p_output - the correlations, already sized
+     */
+    void correlateDirect(const std::vector<std::complex<double>> &p_signal, std::vector<std::complex<double>> &p_output) const;
+
+    /**
+     * @brief Correlate block by block in the frequency domain
+     *
+     * @param p_signal - the signal, not shorter than the reference
+     * @param p_output - the correlations, already sized
+     */
+    void correlateOverlapSave(const std::vector<std::complex<double>> &p_signal,
+                              std::vector<std::complex<double>> &p_output) const;
+};
+
+/**
+ * @brief Process-wide reference length from which the overlap-save correlation is faster than the direct one
+ *
+ * The length is read from the server database on the first request. It is measured off line by
+ * bench/correlationBench, so the server does not time correlations when it starts.
+ */
+class CorrelationCrossover
+{
+public:
+    /**
+     * @brief The function that allows retrieving the crossover singleton object
+     */
+    static CorrelationCrossover &getInstance();
+
+    /**
+     * @brief Get the shortest reference correlated by overlap-save, reading it on the first request
+     *
+     * @return the reference length
+     */
+    size_t getMinFftTaps();
+
+private:
+    /// @brief Protects the crossover, it is read once for every caller
+    std::mutex m_mutex;
+
+    /// @brief true - the crossover was read
+    bool m_isResolved;
+
+    /// @brief The shortest reference correlated by overlap-save
+    size_t m_minFftTaps;
+
+    CorrelationCrossover();
+    CorrelationCrossover(const CorrelationCrossover &) = delete;
+    CorrelationCrossover &operator=(const CorrelationCrossover &) = delete;
+};
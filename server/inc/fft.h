@@ -0,0 +1,117 @@
+#pragma once
+#include <complex>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// @brief The maximum amount of plans kept in the cache before it is cleared
+constexpr size_t FFT_PLAN_CACHE_MAX_ENTRIES = 16;
+
+/**
+ * @brief Get the smallest power of 2 that is not below a value
+ *
+ * @param p_value - the lower bound
+ *
+ * @return the power of 2
+ */
+inline size_t getNextPowerOfTwo(const size_t p_value)
+{
+    size_t size = 1;
+    while (size < p_value)
+    {
+        size <<= 1;
+    }
+    return size;
+}
+
+/**
+ * @brief In-place complex FFT of one power of 2 size, with its bit reversal table and twiddles precomputed
+ *
+ * The transform is decimation in time: after the bit reversal, pairs of radix-2 stages are fused into
+ * one radix-4 pass, so the data is swept log4(N) times, a radix-2 pass runs first when log2(N) is odd.
+ */
+class FftPlan
+{
+public:
+    /**
+     * @brief Customize Constructor to precompute the tables of a size
+     *
+     * @param p_size - the transform size, a power of 2
+     */
+    explicit FftPlan(const size_t p_size);
+
+    /**
+     * @brief Get the transform size
+     *
+     * @return the transform size
+     */
+    size_t getSize() const;
+
+    /**
+     * @brief Forward transform, X[k] = sum x[n] * e^{-j*2*pi*k*n/N}
+     *
+     * @param p_data - getSize() samples, replaced by their spectrum
+     */
+    void forward(std::complex<double> *p_data) const;
+
+    /**
+     * @brief Inverse transform without the 1 / N factor, x[n] = sum X[k] * e^{j*2*pi*k*n/N}
+     *
+     * @param p_data - getSize() bins, replaced by their samples
+     */
+    void inverse(std::complex<double> *p_data) const;
+
+private:
+    /// @brief The transform size
+    size_t m_size;
+
+    /// @brief The index pairs swapped by the bit reversal, each pair once
+    std::vector<std::pair<size_t, size_t>> m_swaps;
+
+    /// @brief e^{-j*2*pi*k/N} for k in [0, N / 2)
+    std::vector<std::complex<double>> m_twiddles;
+
+    /**
+     * @brief Run the butterflies of the transform
+     *
+     * @param p_data - getSize() values transformed in place
+     * @param p_isInverse - true - the twiddles are conjugated
+     */
+    void transform(std::complex<double> *p_data, const bool p_isInverse) const;
+};
+
+/**
+ * @brief Process-wide cache of FFT plans keyed by size
+ *
+ * Plans are immutable once built, readers keep them alive through shared pointers even if the cache
+ * is cleared in the meantime.
+ */
+class FftPlanCache
+{
+public:
+    /**
+     * @brief The function that allows retrieving the cache singleton object
+     */
+    static FftPlanCache &getInstance();
+
+    /**
+     * @brief Get the plan of a size, building it on the first request
+     *
+     * @param p_size - the transform size, a power of 2
+     *
+     * @return the plan
+     */
+    std::shared_ptr<const FftPlan> getPlan(const size_t p_size);
+
+private:
+    /// @brief Protects m_plans, the cache is shared by every request
+    std::mutex m_mutex;
+
+    /// @brief The cached plans
+    std::map<size_t, std::shared_ptr<const FftPlan>> m_plans;
+
+    FftPlanCache() = default;
+    FftPlanCache(const FftPlanCache &) = delete;
+    FftPlanCache &operator=(const FftPlanCache &) = delete;
+};
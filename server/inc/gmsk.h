@@ -0,0 +1,244 @@
+#pragma once
+#include <complex>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "bitBuffer.h"
+
+/// @brief The bandwidth-time product key of the GMSK Gaussian filter
+constexpr const char *GMSK_BANDWIDTH_TIME_KEY = "/modulation/gmsk/bt";
+
+/// @brief The GMSK detector key: "viterbi" or "differential"
+constexpr const char *GMSK_DETECTOR_KEY = "/modulation/gmsk/detector";
+
+/// @brief The bandwidth-time product of GMSK when the database has no setting, the GSM value
+constexpr double DEFAULT_GMSK_BANDWIDTH_TIME = 0.3;
+
+/// @brief The longest frequency pulse in symbols, the tables hold 2^span trajectories
+constexpr unsigned int GMSK_MAX_SPAN = 8;
+
+/// @brief The two-sided bandwidth GMSK occupies in multiples of the symbol rate, the 99 % bandwidth of MSK
+constexpr double GMSK_OCCUPIED_BANDWIDTH = 1.2;
+
+/// @brief The integration steps of the frequency pulse per sample when a table is built
+constexpr unsigned int GMSK_INTEGRATION_STEPS = 16;
+
+/// @brief The maximum amount of tables kept in the cache before it is cleared
+constexpr size_t GMSK_TABLE_CACHE_MAX_ENTRIES = 16;
+
+/// @brief The GMSK receivers
+enum class GmskDetection
+{
+    VITERBI,
+    DIFFERENTIAL
+};
+
+/// @brief The GMSK settings read from the server database
+struct GmskParameters
+{
+    /// @brief The bandwidth-time product of the Gaussian filter
+    double bandwidthTime;
+
+    /// @brief The receiver
+    GmskDetection detection;
+};
+
+/// @brief The precomputed phase trajectories of GMSK at one BT and one oversampling
+struct GmskTable
+{
+    /// @brief The amount of samples of one symbol
+    unsigned int samplesPerSymbol;
+
+    /// @brief The frequency pulse length in symbols, a bit changes the phase during span symbols
+    unsigned int span;
+
+    /// @brief samplesPerSymbol phasors for each of the 2^span bit patterns. Bit i of a pattern is the bit sent
+    /// i symbols ago, sample n of pattern p is e^{j*pi*sum_i a_i*q(iT + nT/samplesPerSymbol)} with a_i = +1 for
+    /// bit 1 and -1 for bit 0, q the phase pulse rising from 0 to 1/2. Older bits only add whole quarter turns.
+    std::vector<std::complex<double>> trajectories;
+};
+
+/**
+ * @brief Process-wide cache of GMSK tables keyed by (BT, oversampling)
+ *
+ * Tables are immutable once built, readers keep them alive through shared pointers even if the cache
+ * is cleared in the meantime.
+ */
+class GmskTableCache
+{
+public:
+    /**
+     * @brief The function that allows retrieving the cache singleton object
+     */
+    static GmskTableCache &getInstance();
+
+    /**
+     * @brief Get the table of a filter, building it on the first request
+     *
+     * @param p_bandwidthTime - the bandwidth-time product of the Gaussian filter
+     * @param p_samplesPerSymbol - the amount of samples of one symbol
+     *
+     * @return the table
+     */
+    std::shared_ptr<const GmskTable> getTable(const double p_bandwidthTime, const unsigned int p_samplesPerSymbol);
+
+private:
+    /// @brief Protects m_tables, the cache is shared by every request
+    std::mutex m_mutex;
+
+    /// @brief The cached tables
+    std::map<std::pair<double, unsigned int>, std::shared_ptr<const GmskTable>> m_tables;
+
+    GmskTableCache() = default;
+    GmskTableCache(const GmskTableCache &) = delete;
+    GmskTableCache &operator=(const GmskTableCache &) = delete;
+
+    /**
+     * @brief Integrate the Gaussian frequency pulse and tabulate the trajectory of every bit pattern
+     *
+     * @return the new table
+     */
+    static std::shared_ptr<const GmskTable> buildTable(const double p_bandwidthTime, const unsigned int p_samplesPerSymbol);
+};
+
+/**
+ * @brief GMSK complex envelope generator, one symbol at a time
+ *
+ * The span - 1 bits before the message are 0, and span - 1 symbols of 0 bits follow it so the pulse of the
+ * last bit is sent whole. A symbol is one table row rotated by the quarter turns of the bits already finished.
+ */
+class GmskModulator
+{
+public:
+    /// @brief Default constructor, a disabled generator
+    GmskModulator();
+
+    /**
+     * @brief Customize Constructor to generate symbols from a cached table
+     *
+     * @param p_table - the phase trajectories
+     */
+    explicit GmskModulator(std::shared_ptr<const GmskTable> p_table);
+
+    /**
+     * @brief Check whether a table is set
+     *
+     * @return true - symbols can be generated, false - otherwise
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Get the amount of samples of one symbol
+     *
+     * @return the oversampling of the table
+     */
+    unsigned int getSamplesPerSymbol() const;
+
+    /**
+     * @brief Get the amount of symbols sent for a message
+     *
+     * @param p_bitCount - the amount of bits of the message
+     *
+     * @return the bits plus the span - 1 flush symbols
+     */
+    size_t getSymbolCount(const size_t p_bitCount) const;
+
+    /**
+     * @brief Generate the envelope of the next symbol, symbols must be generated in order. A message appended
+     * after the flush symbols of the previous one continues its phase, seek() to 0 starts a new burst
+     *
+     * @param p_binaryData - the message
+     * @param p_symbolIdx - index of the symbol
+     * @param p_envelope - output buffer of samplesPerSymbol complex samples
+     */
+    void modulateSymbol(const BitBuffer &p_binaryData, const size_t p_symbolIdx, std::complex<double> *p_envelope);
+
+    /**
+     * @brief Move the generator to a symbol, the quarter turns of the bits finished before it are summed up
+     *
+     * @param p_binaryData - the message
+     * @param p_symbolIdx - index of the next symbol to generate
+     */
+    void seek(const BitBuffer &p_binaryData, const size_t p_symbolIdx);
+
+    /**
+     * @brief Generate the envelope of a whole message, starting at phase 0
+     *
+     * @param p_binaryData - the message
+     *
+     * @return samplesPerSymbol complex samples per symbol
+     */
+    std::vector<std::complex<double>> modulate(const BitBuffer &p_binaryData);
+
+private:
+    /// @brief The cached trajectories, nullptr for a disabled generator
+    std::shared_ptr<const GmskTable> m_table;
+
+    /// @brief The phase of the finished bits in quarter turns, modulo 4
+    unsigned int m_quarterTurns;
+};
+
+/**
+ * @brief GMSK receiver of complex envelopes
+ *
+ * The Viterbi detector runs over 4 * 2^(span - 1) states, the last span - 1 bits and the quarter turns of the
+ * finished bits. Branch metrics are the correlations of a received symbol with the 2^span table rows, computed
+ * once per symbol and rotated per state. The differential detector compares the phase of the symbol before and
+ * after the center of each pulse, it needs no phase reference but loses a few dB.
+ */
+class GmskDemodulator
+{
+public:
+    /**
+     * @brief Customize Constructor to detect symbols with a cached table
+     *
+     * @param p_table - the phase trajectories, the one the signal was generated with
+     */
+    explicit GmskDemodulator(std::shared_ptr<const GmskTable> p_table);
+
+    /**
+     * @brief Detect the message of a received envelope
+     *
+     * @param p_envelope - samplesPerSymbol complex samples per symbol, flush symbols included
+     * @param p_detection - the receiver
+     *
+     * @return a binary data series representing message signal
+     */
+    BitBuffer detect(const std::vector<std::complex<double>> &p_envelope, const GmskDetection p_detection) const;
+
+    /**
+     * @brief Keep only the GMSK band of an envelope mixed down from passband, the image of the signal at twice
+     * the carrier is removed in the frequency domain
+     *
+     * @param p_envelope - samplesPerSymbol complex samples per symbol, filtered in place
+     */
+    void removeImage(std::vector<std::complex<double>> &p_envelope) const;
+
+private:
+    /// @brief The cached trajectories
+    std::shared_ptr<const GmskTable> m_table;
+
+    /**
+     * @brief Maximum likelihood sequence detection of the bits
+     *
+     * @param p_envelope - the received envelope
+     * @param p_symbolCount - the amount of whole symbols of the envelope
+     * @param p_bitCount - the amount of bits of the message
+     *
+     * @return a binary data series representing message signal
+     */
+    BitBuffer detectViterbi(const std::vector<std::complex<double>> &p_envelope, const size_t p_symbolCount,
+                            const size_t p_bitCount) const;
+
+    /**
+     * @brief One-symbol differential detection of the bits
+     *
+     * @param p_envelope - the received envelope
+     * @param p_bitCount - the amount of bits of the message
+     *
+     * @return a binary data series representing message signal
+     */
+    BitBuffer detectDifferential(const std::vector<std::complex<double>> &p_envelope, const size_t p_bitCount) const;
+};
@@ -0,0 +1,370 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include "bitBuffer.h"
+#include "constellation.h"
+#include "modulationScheme.h"
+#include "waveformCache.h"
+
+/// @brief The amplitude of carrier signal wave (value 1.0 is used to simplify equations)
+constexpr double CARRIER_AMPLITUDE = 1.0;
+
+/// @brief The default value of amplitude index (only changed when applied ASK)
+constexpr double DEFAULT_AMPLITUDE_INDEX = 1.0;
+
+/// @brief The default value of frequency index (only changed when applied FSK)
+constexpr double DEFAULT_FREQUENCY_INDEX = 1.0;
+
+/// @brief Coherent detectors only need the highest tone below Nyquist
+constexpr double NYQUIST_SAMPLES_PER_CYCLE = 2.0;
+
+/// @brief The envelope detector averages |x|, which only approaches 2/pi of the amplitude with dense sampling
+constexpr double ENVELOPE_MIN_SAMPLES_PER_CYCLE = 8.0;
+
+/**
+ * @brief Get the amount of bits carried by a symbol of a constellation
+ *
+ * @param p_order - the amount of points of the constellation, a power of 2
+ *
+ * @return log2 of the order
+ */
+constexpr unsigned int getBitsPerPoint(const unsigned int p_order)
+{
+    return (p_order <= 1) ? 0 : 1 + getBitsPerPoint(p_order / 2);
+}
+
+/// @brief The scheme settings read from the server database, shared by every modulation policy
+struct ModulationParameters
+{
+    /// @brief The amplitude index (ASK) of bit 0
+    double askZeroSign;
+
+    /// @brief The amplitude index (ASK) of bit 1
+    double askOneSign;
+
+    /// @brief e^{j*phase} of the phase index (PSK) of bit 0
+    std::complex<double> pskZeroShift;
+
+    /// @brief e^{j*phase} of the phase index (PSK) of bit 1
+    std::complex<double> pskOneShift;
+
+    /// @brief The frequency index (FSK) of bit 0
+    double fskZeroSign;
+
+    /// @brief The frequency index (FSK) of bit 1
+    double fskOneSign;
+};
+
+/**
+ * @brief The correlations of one received symbol against the reference tones of a scheme
+ *
+ * @tparam ToneCount - the amount of tones the scheme transmits on
+ */
+template <size_t ToneCount>
+struct SymbolCorrelation
+{
+    /// @brief Sum of |x[n]|, only accumulated by envelope detecting schemes
+    double envelope;
+
+    /// @brief Sum of x[n] * Re(tone[n]) for every tone
+    std::array<double, ToneCount> inPhase;
+
+    /// @brief Sum of x[n] * Im(tone[n]) for every tone, only accumulated by schemes with a quadrature component
+    std::array<double, ToneCount> quadrature;
+};
+
+/**
+ * @brief A modulation policy describes one scheme at compile time
+ *
+ * Every policy provides:
+ * - SCHEME, the enum value the policy is selected with (also the waveform cache key)
+ * - BITS_PER_SYMBOL and TONE_COUNT
+ * - USES_ENVELOPE (detect on sum |x| instead of correlating) and USES_QUADRATURE (correlate the sine reference too)
+ * - MIN_SAMPLES_PER_CYCLE, the sampling density of the highest tone the detector needs
+ * - PULSE_SHAPING, whether every symbol is one I/Q point on one tone, so it can be sent with shaped pulses
+ * - SUPPORTS_OFDM, whether the points can be spread over OFDM subcarriers instead of a single carrier
+ * - CONTINUOUS_PHASE, whether the signal is a continuous phase trajectory (GMSK) instead of independent symbols
+ * - TONE_BANK, whether a symbol is only told apart by which tone carries it, so the tone powers alone decide it
+ * - getToneIndices, the frequency of every tone as a multiple of the carrier frequency
+ * - getAlphabet, the tone and I/Q gains of every symbol value
+ * - decide, appending the bits of one received symbol from its correlations
+ *
+ * Continuous phase policies have no alphabet and no decide, the modulator routes them to the GMSK modem
+ * before any symbol template or correlator is instantiated.
+ *
+ * The modulator and demodulator are instantiated once per policy, so the per-sample loops are fixed at
+ * compile time and never branch on the scheme.
+ */
+
+/// @brief On-off keying of the carrier amplitude (2G)
+struct AskPolicy
+{
+    static constexpr ModulationScheme SCHEME = ModulationScheme::ASK;
+    static constexpr unsigned int BITS_PER_SYMBOL = 1;
+    static constexpr size_t TONE_COUNT = 1;
+    static constexpr bool USES_ENVELOPE = true;
+    static constexpr bool USES_QUADRATURE = false;
+    static constexpr double MIN_SAMPLES_PER_CYCLE = ENVELOPE_MIN_SAMPLES_PER_CYCLE;
+    static constexpr bool PULSE_SHAPING = false;
+    static constexpr bool SUPPORTS_OFDM = false;
+    static constexpr bool CONTINUOUS_PHASE = false;
+    static constexpr bool TONE_BANK = false;
+
+    static std::array<double, TONE_COUNT> getToneIndices(const ModulationParameters &)
+    {
+        return {DEFAULT_FREQUENCY_INDEX};
+    }
+
+    static std::vector<SymbolShape> getAlphabet(const ModulationParameters &p_parameters)
+    {
+        return {{0, p_parameters.askZeroSign * CARRIER_AMPLITUDE, 0.0},
+                {0, p_parameters.askOneSign * CARRIER_AMPLITUDE, 0.0}};
+    }
+
+    static void decide(const SymbolCorrelation<TONE_COUNT> &p_correlation, const unsigned int p_samplesPerSymbol,
+                       const ModulationParameters &p_parameters, BitBuffer &p_bits)
+    {
+        p_bits.pushBits((p_correlation.envelope / p_samplesPerSymbol > p_parameters.askZeroSign) ? 1 : 0, BITS_PER_SYMBOL);
+    }
+};
+
+/// @brief Binary phase keying of the carrier (3G)
+struct PskPolicy
+{
+    static constexpr ModulationScheme SCHEME = ModulationScheme::PSK;
+    static constexpr unsigned int BITS_PER_SYMBOL = 1;
+    static constexpr size_t TONE_COUNT = 1;
+    static constexpr bool USES_ENVELOPE = false;
+    static constexpr double MIN_SAMPLES_PER_CYCLE = NYQUIST_SAMPLES_PER_CYCLE;
+    static constexpr bool USES_QUADRATURE = true;
+    static constexpr bool PULSE_SHAPING = true;
+    static constexpr bool SUPPORTS_OFDM = false;
+    static constexpr bool CONTINUOUS_PHASE = false;
+    static constexpr bool TONE_BANK = false;
+
+    static std::array<double, TONE_COUNT> getToneIndices(const ModulationParameters &)
+    {
+        return {DEFAULT_FREQUENCY_INDEX};
+    }
+
+    static std::vector<SymbolShape> getAlphabet(const ModulationParameters &p_parameters)
+    {
+        // Re(e^{j(wt + phase)}) = cos(phase) * cos(wt) - sin(phase) * sin(wt)
+        return {{0, DEFAULT_AMPLITUDE_INDEX * p_parameters.pskZeroShift.real(), -DEFAULT_AMPLITUDE_INDEX * p_parameters.pskZeroShift.imag()},
+                {0, DEFAULT_AMPLITUDE_INDEX * p_parameters.pskOneShift.real(), -DEFAULT_AMPLITUDE_INDEX * p_parameters.pskOneShift.imag()}};
+    }
+
+    static void decide(const SymbolCorrelation<TONE_COUNT> &p_correlation, const unsigned int,
+                       const ModulationParameters &p_parameters, BitBuffer &p_bits)
+    {
+        // Sum x * Re(carrier * shift) for the phase of bit 0 and bit 1, the signal is closer to the larger one
+        double correlation0 = p_parameters.pskZeroShift.real() * p_correlation.inPhase[0] - p_parameters.pskZeroShift.imag() * p_correlation.quadrature[0];
+        double correlation1 = p_parameters.pskOneShift.real() * p_correlation.inPhase[0] - p_parameters.pskOneShift.imag() * p_correlation.quadrature[0];
+        p_bits.pushBits((correlation0 > correlation1) ? 0 : 1, BITS_PER_SYMBOL);
+    }
+};
+
+/**
+ * @brief M-ary frequency keying, every symbol value has its own tone (4G)
+ *
+ * The tones are evenly spaced from the bit 0 tone with the spacing between the bit 0 and bit 1 tones, so the
+ * binary scheme keeps its two original tones.
+ *
+ * @tparam Scheme - the enum value the policy is selected with
+ * @tparam Order - the amount of tones, a power of 2
+ */
+template <ModulationScheme Scheme, unsigned int Order>
+struct MfskPolicy
+{
+    static constexpr ModulationScheme SCHEME = Scheme;
+    static constexpr unsigned int BITS_PER_SYMBOL = getBitsPerPoint(Order);
+    static constexpr size_t TONE_COUNT = Order;
+    static constexpr bool USES_ENVELOPE = false;
+    static constexpr double MIN_SAMPLES_PER_CYCLE = NYQUIST_SAMPLES_PER_CYCLE;
+    static constexpr bool USES_QUADRATURE = false;
+    static constexpr bool PULSE_SHAPING = false;
+    static constexpr bool SUPPORTS_OFDM = false;
+    static constexpr bool CONTINUOUS_PHASE = false;
+    static constexpr bool TONE_BANK = true;
+
+    static std::array<double, TONE_COUNT> getToneIndices(const ModulationParameters &p_parameters)
+    {
+        std::array<double, TONE_COUNT> toneIndices;
+        for (size_t toneIdx = 0; toneIdx < TONE_COUNT; ++toneIdx)
+        {
+            toneIndices[toneIdx] = p_parameters.fskZeroSign + toneIdx * (p_parameters.fskOneSign - p_parameters.fskZeroSign);
+        }
+        return toneIndices;
+    }
+
+    static std::vector<SymbolShape> getAlphabet(const ModulationParameters &)
+    {
+        // Every symbol value has its own tone, each tone keeps running on the same sample clock
+        std::vector<SymbolShape> alphabet;
+        for (unsigned int toneIdx = 0; toneIdx < TONE_COUNT; ++toneIdx)
+        {
+            alphabet.push_back({toneIdx, DEFAULT_AMPLITUDE_INDEX, 0.0});
+        }
+        return alphabet;
+    }
+
+    static void decide(const SymbolCorrelation<TONE_COUNT> &p_correlation, const unsigned int,
+                       const ModulationParameters &, BitBuffer &p_bits)
+    {
+        // The symbol value is the index of the strongest tone, the first one wins a tie
+        unsigned int strongest = 0;
+        for (unsigned int toneIdx = 1; toneIdx < TONE_COUNT; ++toneIdx)
+        {
+            if (p_correlation.inPhase[toneIdx] > p_correlation.inPhase[strongest])
+            {
+                strongest = toneIdx;
+            }
+        }
+        p_bits.pushBits(strongest, BITS_PER_SYMBOL);
+    }
+};
+
+using FskPolicy = MfskPolicy<ModulationScheme::FSK, 2>;
+using Fsk4Policy = MfskPolicy<ModulationScheme::FSK4, 4>;
+using Fsk8Policy = MfskPolicy<ModulationScheme::FSK8, 8>;
+
+/**
+ * @brief M-PSK and square M-QAM schemes sliced with a Gray mapped constellation (3G with order 4 or 8, 5G)
+ *
+ * @tparam Scheme - the enum value the policy is selected with
+ * @tparam Shape - PSK or QAM
+ * @tparam Order - the amount of constellation points
+ */
+template <ModulationScheme Scheme, ConstellationShape Shape, unsigned int Order>
+struct ConstellationPolicy
+{
+    static constexpr ModulationScheme SCHEME = Scheme;
+    static constexpr unsigned int BITS_PER_SYMBOL = getBitsPerPoint(Order);
+    static constexpr size_t TONE_COUNT = 1;
+    static constexpr bool USES_ENVELOPE = false;
+    static constexpr double MIN_SAMPLES_PER_CYCLE = NYQUIST_SAMPLES_PER_CYCLE;
+    static constexpr bool USES_QUADRATURE = true;
+    static constexpr bool PULSE_SHAPING = true;
+    // OFDM is the multicarrier waveform of the QAM network (5G)
+    static constexpr bool SUPPORTS_OFDM = (Shape == ConstellationShape::QAM);
+    static constexpr bool CONTINUOUS_PHASE = false;
+    static constexpr bool TONE_BANK = false;
+
+    /**
+     * @brief Get the lookup tables of the constellation, built on the first call
+     *
+     * @return the constellation shared by every modulator
+     */
+    static const Constellation &getConstellation()
+    {
+        static const Constellation s_constellation(Shape, Order);
+        return s_constellation;
+    }
+
+    static std::array<double, TONE_COUNT> getToneIndices(const ModulationParameters &)
+    {
+        return {DEFAULT_FREQUENCY_INDEX};
+    }
+
+    static std::vector<SymbolShape> getAlphabet(const ModulationParameters &)
+    {
+        // I scales the cosine wave and Q scales the sine wave
+        std::vector<SymbolShape> alphabet;
+        for (const std::complex<double> &point : getConstellation().getPoints())
+        {
+            alphabet.push_back({0, point.real() * CARRIER_AMPLITUDE, point.imag() * CARRIER_AMPLITUDE});
+        }
+        return alphabet;
+    }
+
+    static void decide(const SymbolCorrelation<TONE_COUNT> &p_correlation, const unsigned int p_samplesPerSymbol,
+                       const ModulationParameters &, BitBuffer &p_bits)
+    {
+        // Averaging x * cos (or x * sin) over a symbol recovers half of I (or Q), hence the factor 2
+        std::complex<double> point(2 * p_correlation.inPhase[0] / p_samplesPerSymbol,
+                                   2 * p_correlation.quadrature[0] / p_samplesPerSymbol);
+        // The symbol value is its bits, MSB first
+        p_bits.pushBits(getConstellation().slice(point), BITS_PER_SYMBOL);
+    }
+};
+
+using QpskPolicy = ConstellationPolicy<ModulationScheme::QPSK, ConstellationShape::PSK, 4>;
+using Psk8Policy = ConstellationPolicy<ModulationScheme::PSK8, ConstellationShape::PSK, 8>;
+using Qam16Policy = ConstellationPolicy<ModulationScheme::QAM16, ConstellationShape::QAM, 16>;
+using Qam64Policy = ConstellationPolicy<ModulationScheme::QAM64, ConstellationShape::QAM, 64>;
+using Qam256Policy = ConstellationPolicy<ModulationScheme::QAM256, ConstellationShape::QAM, 256>;
+
+/// @brief Gaussian minimum shift keying, one bit per symbol on a constant envelope (2G)
+struct GmskPolicy
+{
+    static constexpr ModulationScheme SCHEME = ModulationScheme::GMSK;
+    static constexpr unsigned int BITS_PER_SYMBOL = 1;
+    static constexpr size_t TONE_COUNT = 1;
+    static constexpr bool USES_ENVELOPE = false;
+    static constexpr bool USES_QUADRATURE = true;
+    static constexpr double MIN_SAMPLES_PER_CYCLE = NYQUIST_SAMPLES_PER_CYCLE;
+    static constexpr bool PULSE_SHAPING = false;
+    static constexpr bool SUPPORTS_OFDM = false;
+    static constexpr bool CONTINUOUS_PHASE = true;
+    static constexpr bool TONE_BANK = false;
+
+    static std::array<double, TONE_COUNT> getToneIndices(const ModulationParameters &)
+    {
+        return {DEFAULT_FREQUENCY_INDEX};
+    }
+};
+
+/**
+ * @brief Call a generic visitor with the policy of a scheme, the only place a scheme enum is branched on
+ *
+ * @param p_scheme - a modulation scheme
+ * @param p_visitor - callable taking a default constructed policy, e.g. [&](auto p_policy) { ... }
+ * @param p_unknown - the result for an unknown scheme
+ *
+ * @return the result of the visitor
+ */
+template <typename Result, typename Visitor>
+Result visitSchemePolicy(const ModulationScheme &p_scheme, Visitor &&p_visitor, Result p_unknown)
+{
+    switch (p_scheme)
+    {
+    case ModulationScheme::ASK:
+        return p_visitor(AskPolicy());
+    case ModulationScheme::PSK:
+        return p_visitor(PskPolicy());
+    case ModulationScheme::FSK:
+        return p_visitor(FskPolicy());
+    case ModulationScheme::FSK4:
+        return p_visitor(Fsk4Policy());
+    case ModulationScheme::FSK8:
+        return p_visitor(Fsk8Policy());
+    case ModulationScheme::QPSK:
+        return p_visitor(QpskPolicy());
+    case ModulationScheme::PSK8:
+        return p_visitor(Psk8Policy());
+    case ModulationScheme::QAM16:
+        return p_visitor(Qam16Policy());
+    case ModulationScheme::QAM64:
+        return p_visitor(Qam64Policy());
+    case ModulationScheme::QAM256:
+        return p_visitor(Qam256Policy());
+    case ModulationScheme::GMSK:
+        return p_visitor(GmskPolicy());
+    default:
+        return p_unknown;
+    }
+}
+
+/**
+ * @brief Get the amount of bits carried by one symbol of a scheme
+ *
+ * @param p_scheme - a modulation scheme
+ *
+ * @return the bits per symbol, 0 for an unknown scheme
+ */
+inline unsigned int getSchemeBitsPerSymbol(const ModulationScheme &p_scheme)
+{
+    return visitSchemePolicy(p_scheme, [](auto p_policy) { return decltype(p_policy)::BITS_PER_SYMBOL; }, 0u);
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <string>
+
+/// @brief The modulation schemes implemented by the server modulator
+enum class ModulationScheme
+{
+    ASK,
+    PSK,
+    FSK,
+    QAM16,
+    QPSK,
+    PSK8,
+    QAM64,
+    QAM256,
+    FSK4,
+    FSK8,
+    GMSK,
+    UNKNOWN
+};
+
+/// @brief The constellation order key of the PSK network (3G): 2, 4 or 8
+constexpr const char *PSK_ORDER_KEY = "/modulation/psk/order";
+
+/// @brief The tone count key of the FSK network (4G): 2, 4 or 8
+constexpr const char *FSK_ORDER_KEY = "/modulation/fsk/order";
+
+/// @brief The constellation order key of the QAM network (5G): 16, 64 or 256
+constexpr const char *QAM_ORDER_KEY = "/modulation/qam/order";
+
+/// @brief The modulation key of the 2G network: "gmsk" or "ask"
+constexpr const char *GSM_MODULATION_KEY = "/modulation/2g/scheme";
+
+/**
+ * @brief Resolve the modulation scheme a carrier network is transmitted with
+ *
+ * @param p_network - a network type: "2G", "3G", "4G" or "5G"
+ * @param p_order - the constellation order configured for 3G or 5G or the tone count of 4G, 0 selects the default order
+ * @param p_modulation - the modulation configured for 2G, "gmsk" selects GMSK, anything else ASK
+ *
+ * @return the modulation scheme of the network, UNKNOWN when the network or the order is not supported
+ */
+inline ModulationScheme getNetworkScheme(const std::string &p_network, const unsigned long p_order = 0,
+                                         const std::string &p_modulation = "")
+{
+    if (p_network == "2G")
+    {
+        return (p_modulation == "gmsk") ? ModulationScheme::GMSK : ModulationScheme::ASK;
+    }
+    if (p_network == "3G")
+    {
+        switch (p_order)
+        {
+        case 0:
+        case 2:
+            return ModulationScheme::PSK;
+        case 4:
+            return ModulationScheme::QPSK;
+        case 8:
+            return ModulationScheme::PSK8;
+        default:
+            return ModulationScheme::UNKNOWN;
+        }
+    }
+    if (p_network == "4G")
+    {
+        switch (p_order)
+        {
+        case 0:
+        case 2:
+            return ModulationScheme::FSK;
+        case 4:
+            return ModulationScheme::FSK4;
+        case 8:
+            return ModulationScheme::FSK8;
+        default:
+            return ModulationScheme::UNKNOWN;
+        }
+    }
+    if (p_network == "5G")
+    {
+        switch (p_order)
+        {
+        case 0:
+        case 16:
+            return ModulationScheme::QAM16;
+        case 64:
+            return ModulationScheme::QAM64;
+        case 256:
+            return ModulationScheme::QAM256;
+        default:
+            return ModulationScheme::UNKNOWN;
+        }
+    }
+    return ModulationScheme::UNKNOWN;
+}
@@ -0,0 +1,361 @@
+#pragma once
+#include <memory>
+#include <random>
+#include <vector>
+#include "bitBuffer.h"
+#include "gmsk.h"
+#include "ofdm.h"
+#include "oscillator.h"
+#include "pulseShaper.h"
+#include "sampleTraits.h"
+#include "waveformCache.h"
+
+/// @brief The amount of samples a consumer pulls from a modulation session at a time
+constexpr size_t MODULATION_CHUNK_SIZE = 4096;
+
+/**
+ * @brief Modulated signal of one message, produced chunk by chunk into caller-provided buffers
+ *
+ * A session only keeps the message, the cached symbol templates and the position it stopped at,
+ * so the memory of a request no longer grows with the message length and consumers can start
+ * writing samples before the whole message is modulated.
+ */
+class ModulationSession
+{
+public:
+    /// @brief Default constructor, an empty session that produces no samples
+    ModulationSession();
+
+    /**
+     * @brief Customize Constructor to start modulating a message
+     *
+     * @param p_template - the cached symbol templates of the scheme
+     * @param p_binaryData - a binary data series, trailing bits that do not fill a symbol are dropped
+     * @param p_bitsPerSymbol - the amount of bits carried by one symbol
+     * @param p_isNoisy - true - Gaussian noise is added to every produced sample
+     */
+    ModulationSession(std::shared_ptr<const WaveformTemplate> p_template, const BitBuffer &p_binaryData,
+                      const unsigned int p_bitsPerSymbol, const bool p_isNoisy);
+
+    /**
+     * @brief Customize Constructor to start modulating a message with shaped pulses, every symbol is interpolated
+     * by the polyphase filter from the symbols around it and mixed up to the carrier
+     *
+     * @param p_shaper - the pulse shaper, enabled
+     * @param p_points - the complex envelope of every symbol value
+     * @param p_binaryData - a binary data series, trailing bits that do not fill a symbol are dropped
+     * @param p_bitsPerSymbol - the amount of bits carried by one symbol
+     * @param p_samplesPerSymbol - the amount of samples of one symbol, the oversampling of the shaper filter
+     * @param p_carrier - the carrier oscillator at time 0
+     * @param p_isNoisy - true - Gaussian noise is added to every produced sample
+     */
+    ModulationSession(PulseShaper p_shaper, std::vector<std::complex<double>> p_points, const BitBuffer &p_binaryData,
+                      const unsigned int p_bitsPerSymbol, const unsigned int p_samplesPerSymbol, const Oscillator &p_carrier,
+                      const bool p_isNoisy);
+
+    /**
+     * @brief Customize Constructor to start modulating a message as OFDM, one OFDM symbol is generated at a time
+     *
+     * @param p_engine - the OFDM symbol mapper, a passband one
+     * @param p_points - the complex envelope of every symbol value
+     * @param p_binaryData - a binary data series, trailing bits that do not fill a symbol are dropped
+     * @param p_bitsPerSymbol - the amount of bits carried by one constellation point
+     * @param p_isNoisy - true - Gaussian noise is added to every produced sample
+     */
+    ModulationSession(std::shared_ptr<const OfdmEngine> p_engine, std::vector<std::complex<double>> p_points,
+                      const BitBuffer &p_binaryData, const unsigned int p_bitsPerSymbol, const bool p_isNoisy);
+
+    /**
+     * @brief Customize Constructor to start modulating a resource grid already mapped to points, the payloads
+     * of every client of the grid are sent in one pass
+     *
+     * @param p_engine - the OFDM symbol mapper, a passband one
+     * @param p_elements - the complex envelope of every resource element, 0 for null ones, a whole number of OFDM symbols
+     * @param p_isNoisy - true - Gaussian noise is added to every produced sample
+     */
+    ModulationSession(std::shared_ptr<const OfdmEngine> p_engine, std::vector<std::complex<double>> p_elements,
+                      const bool p_isNoisy);
+
+    /**
+     * @brief Customize Constructor to start modulating a message as GMSK, the phase trajectory of every symbol
+     * is looked up and mixed up to the carrier
+     *
+     * @param p_gmsk - the GMSK generator, enabled
+     * @param p_binaryData - a binary data series
+     * @param p_carrier - the carrier oscillator at time 0
+     * @param p_isNoisy - true - Gaussian noise is added to every produced sample
+     */
+    ModulationSession(GmskModulator p_gmsk, const BitBuffer &p_binaryData, const Oscillator &p_carrier, const bool p_isNoisy);
+
+    /**
+     * @brief Write the next samples of the signal, resuming where the previous call stopped
+     *
+     * @tparam T - the sample type: double, float or int16_t (scaled by INT16_SAMPLE_SCALE)
+     * @param p_signal - output buffer of at least p_count samples
+     * @param p_count - the maximum amount of samples to write
+     *
+     * @return the amount of samples written, 0 once the whole signal has been produced
+     */
+    template <typename T>
+    size_t produce(T *p_signal, const size_t p_count);
+
+    /**
+     * @brief Start over with another message of the same scheme, the templates, filters and tables of the session
+     * are kept and its oscillators go back to time 0. Resource grid sessions cannot be restarted.
+     *
+     * @param p_binaryData - a binary data series, trailing bits that do not fill a symbol are dropped
+     */
+    void restart(const BitBuffer &p_binaryData);
+
+    /**
+     * @brief Continue the signal with another message of the same scheme, the oscillators keep running so the new
+     * message starts where the previous one stopped, with no phase or sample clock jump
+     *
+     * @param p_binaryData - a binary data series, the samples of the previous message not produced yet are dropped
+     */
+    void append(const BitBuffer &p_binaryData);
+
+    /**
+     * @brief Shape the pulses of the appended messages as one stream instead of tail biting every message: the
+     * window of a symbol reads the last symbols of the previous messages and no symbol wraps around its message.
+     * The stream is delayed by the half of the pulse after its peak, so a symbol is shaped once every pulse it
+     * overlaps has started, and endStream() produces the tails of the last pulses. Call it before the first sample
+     * is produced, it has no effect on sessions without shaped pulses.
+     */
+    void setContinuous();
+
+    /**
+     * @brief Close a continuous stream, the session then produces the symbols that hold the tails of the pulses of
+     * the last message, with no symbol after it. The session cannot be appended to afterwards.
+     */
+    void endStream();
+
+    /**
+     * @brief Move the session to the first sample of a symbol, the oscillators are moved to its time and the noise
+     * generator is derived from the session seed and the symbol, so copies of one session can produce disjoint symbol
+     * ranges of the same signal with independent and reproducible noise. Only sessions that were not continued with
+     * append() can be moved.
+     *
+     * @param p_symbolIdx - index of the symbol, OFDM symbol for an OFDM session
+     */
+    void seek(const size_t p_symbolIdx);
+
+    /**
+     * @brief Select the arithmetic of the int16 samples, only sessions stitched from waveform templates have a
+     * fixed-point path, the others always stage their samples in single precision
+     *
+     * @param p_arithmetic - the arithmetic of the int16 samples
+     */
+    void setArithmetic(const Arithmetic p_arithmetic);
+
+    /**
+     * @brief Get the amount of symbols of the signal
+     *
+     * @return the amount of symbols, OFDM symbols for an OFDM session and flush symbols included for GMSK
+     */
+    size_t getSymbolCount() const;
+
+    /**
+     * @brief Get the amount of samples of one symbol
+     *
+     * @return the amount of samples of one symbol, a whole OFDM symbol for an OFDM session
+     */
+    unsigned int getSamplesPerSymbol() const;
+
+    /**
+     * @brief Get the amount of samples of the whole signal
+     *
+     * @return the amount of samples of the whole signal
+     */
+    size_t getTotalSamples() const;
+
+    /**
+     * @brief Get the amount of samples produced so far
+     *
+     * @return the amount of samples produced so far
+     */
+    size_t getProducedSamples() const;
+
+    /**
+     * @brief Check whether the whole signal has been produced
+     *
+     * @return true - no sample is left, false - otherwise
+     */
+    bool isFinished() const;
+
+private:
+    /// @brief The cached symbol templates of the scheme
+    std::shared_ptr<const WaveformTemplate> m_template;
+
+    /// @brief The pulse shaper, disabled when the symbols are stitched from m_template
+    PulseShaper m_shaper;
+
+    /// @brief The complex envelope of every symbol value, only used with shaped pulses and OFDM.
+    /// The complex envelope of every resource element when a resource grid is sent (m_bitsPerSymbol is 0)
+    std::vector<std::complex<double>> m_points;
+
+    /// @brief The carrier the shaped envelope is mixed up to, only used with shaped pulses and GMSK
+    Oscillator m_carrier;
+
+    /// @brief The OFDM symbol mapper, nullptr unless the message is sent as OFDM
+    std::shared_ptr<const OfdmEngine> m_ofdm;
+
+    /// @brief The GMSK generator, disabled unless the message is sent as GMSK
+    GmskModulator m_gmsk;
+
+    /// @brief The envelope of the current symbol, only used with shaped pulses, OFDM and GMSK
+    std::vector<std::complex<double>> m_envelope;
+
+    /// @brief The in-phase parts of the symbols the pulses of the current symbol belong to, only used with shaped pulses
+    std::vector<double> m_windowI;
+
+    /// @brief The quadrature parts of the symbols the pulses of the current symbol belong to, only used with shaped pulses
+    std::vector<double> m_windowQ;
+
+    /// @brief The points of the current OFDM symbol, one per subcarrier, only used with OFDM
+    std::vector<std::complex<double>> m_ofdmPoints;
+
+    /// @brief true - the pulses are shaped as one stream across the appended messages, see setContinuous()
+    bool m_isContinuous;
+
+    /// @brief true - endStream() was called, the current symbols only hold the tails of the previous pulses
+    bool m_isStreamEnded;
+
+    /// @brief The last getSpan() - 1 points of the previous messages of a continuous stream, 0 before the stream starts
+    std::vector<std::complex<double>> m_history;
+
+    /// @brief A binary data series
+    BitBuffer m_binaryInput;
+
+    /// @brief The amount of bits carried by one symbol
+    unsigned int m_bitsPerSymbol;
+
+    /// @brief The amount of samples of one symbol
+    unsigned int m_samplesPerSymbol;
+
+    /// @brief The amount of symbols of the message, OFDM symbols for an OFDM message
+    size_t m_symbolCount;
+
+    /// @brief The symbols of the messages appended before the current one, OFDM symbols are timed from the first message
+    size_t m_firstSymbol;
+
+    /// @brief The symbol being produced
+    size_t m_symbolIdx;
+
+    /// @brief The first sample of the current symbol not produced yet
+    unsigned int m_sampleOffset;
+
+    /// @brief One oscillator per tone ticking once per symbol, giving the tone phase at the current symbol
+    std::vector<Oscillator> m_symbolClocks;
+
+    /// @brief true - Gaussian noise is added to every produced sample
+    bool m_isNoisy;
+
+    /// @brief The arithmetic int16 samples are produced in
+    Arithmetic m_arithmetic;
+
+    /// @brief The seed of the noise drawn once per session, the generator of every symbol range is derived from it
+    unsigned int m_seed;
+
+    /// @brief The generator of the Gaussian noise
+    std::default_random_engine m_generator;
+
+    /// @brief The distribution of the Gaussian noise
+    std::normal_distribution<double> m_noise;
+
+    /// @brief Staging buffer of the samples of integer sample types before they are quantized
+    std::vector<float> m_scratch;
+
+    /**
+     * @brief Get the value of a symbol of the message
+     *
+     * @param p_symbolIdx - index of the symbol
+     *
+     * @return the symbol value, bits are read most significant first
+     */
+    unsigned int readSymbol(const size_t p_symbolIdx) const;
+
+    /**
+     * @brief Get the point a pulse of the window of a shaped symbol belongs to
+     *
+     * @param p_symbolIdx - index of the symbol in the message, negative for the previous messages of a continuous stream
+     *
+     * @return the point, wrapped around the message unless the stream is continuous, 0 outside of a continuous stream
+     */
+    const std::complex<double> &getWindowPoint(long p_symbolIdx) const;
+
+    /**
+     * @brief Get the amount of symbols of the message, OFDM symbols for an OFDM message and flush symbols included for GMSK
+     *
+     * @return the amount of symbols of the message
+     */
+    size_t countSymbols() const;
+
+    /**
+     * @brief Seed the noise generator for the symbol range starting at a symbol
+     *
+     * @param p_symbolIdx - index of the first symbol of the range
+     */
+    void seedNoise(const size_t p_symbolIdx);
+
+    /**
+     * @brief Write the next noiseless samples of the signal in a floating point type, or in int16 for a fixed-point template session
+     *
+     * @param p_signal - output buffer of at least p_count samples
+     * @param p_count - the maximum amount of samples to write
+     *
+     * @return the amount of samples written
+     */
+    template <typename C>
+    size_t render(C *p_signal, const size_t p_count);
+
+    /**
+     * @brief Write part of the current symbol
+     *
+     * @param p_signal - output buffer of at least p_count samples
+     * @param p_count - the amount of samples to write, starting at m_sampleOffset
+     */
+    template <typename C>
+    void renderSymbol(C *p_signal, const unsigned int p_count);
+
+    /**
+     * @brief Write part of the current symbol with shaped pulses, the envelope of the symbol is interpolated
+     * when its first sample is written
+     *
+     * @param p_signal - output buffer of at least p_count samples
+     * @param p_count - the amount of samples to write, starting at m_sampleOffset
+     */
+    template <typename C>
+    void renderShapedSymbol(C *p_signal, const unsigned int p_count);
+
+    /**
+     * @brief Write part of the current OFDM symbol, the whole OFDM symbol is generated when its first sample is written
+     *
+     * @param p_signal - output buffer of at least p_count samples
+     * @param p_count - the amount of samples to write, starting at m_sampleOffset
+     */
+    template <typename C>
+    void renderOfdmSymbol(C *p_signal, const unsigned int p_count);
+
+    /**
+     * @brief Write part of the current GMSK symbol, its envelope is looked up when its first sample is written
+     *
+     * @param p_signal - output buffer of at least p_count samples
+     * @param p_count - the amount of samples to write, starting at m_sampleOffset
+     */
+    template <typename C>
+    void renderGmskSymbol(C *p_signal, const unsigned int p_count);
+
+    /**
+     * @brief Add Gaussian noise to produced samples when the session is noisy
+     *
+     * @param p_signal - the produced samples
+     * @param p_count - the amount of produced samples
+     */
+    template <typename C>
+    void addNoise(C *p_signal, const size_t p_count);
+};
+
+extern template size_t ModulationSession::produce<double>(double *p_signal, const size_t p_count);
+extern template size_t ModulationSession::produce<float>(float *p_signal, const size_t p_count);
+extern template size_t ModulationSession::produce<int16_t>(int16_t *p_signal, const size_t p_count);
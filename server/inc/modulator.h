@@ -3,15 +3,19 @@
 #include <vector>
 #include <cmath>
 #include <complex>
-
-/// @brief The amplitude of carrier signal wave (value 1.0 is used to simplify equations)
-constexpr double CARRIER_AMPLITUDE = 1.0;
-
-/// @brief The default value of amplitude index (only changed when applied ASK)
-constexpr double DEFAULT_AMPLITUDE_INDEX = 1.0;
-
-/// @brief The default value of frequency index (only changed when applied FSK)
-constexpr double DEFAULT_FREQUENCY_INDEX = 1.0;
+#include <functional>
+#include "oscillator.h"
+#include "waveformCache.h"
+#include "modulationSession.h"
+#include "sampleTraits.h"
+#include "modulationPolicy.h"
+#include "resampler.h"
+#include "pulseShaper.h"
+#include "ofdm.h"
+#include "gmsk.h"
+#include "resourceGrid.h"
+#include "parallel.h"
+#include "bitBuffer.h"
 
 /// @brief The default value of phase angle (only changed when applied PSK)
 constexpr double DEFAULT_PHASE = -M_PI / 2;
@@ -22,6 +26,27 @@ constexpr double NOISE_LEVEL = 0.01;
 /// @brief The sample rate key
 constexpr const char *SAMPLE_RATE_KEY = "/fs";
 
+/// @brief The symbol rate key, 0 keeps one symbol per carrier cycle
+constexpr const char *SYMBOL_RATE_KEY = "/symbolRate";
+
+/// @brief The oversampling key: samples per symbol the signal is simulated at, 0 follows /fs
+constexpr const char *OVERSAMPLING_KEY = "/oversampling";
+
+/// @brief The simulation mode key: "passband" (real carrier samples) or "baseband" (complex envelope samples)
+constexpr const char *SIMULATION_MODE_KEY = "/simulationMode";
+
+/// @brief The pipeline mode key: "tiled" (fused cache-sized tiles) or "materialized" (one pass per stage over the whole signal)
+constexpr const char *PIPELINE_MODE_KEY = "/pipelineMode";
+
+/// @brief The baseband samples per symbol key
+constexpr const char *BASEBAND_SAMPLES_PER_SYMBOL_KEY = "/basebandSamplesPerSymbol";
+
+/// @brief The amount of complex samples of one baseband symbol when the database has no setting
+constexpr unsigned int DEFAULT_BASEBAND_SAMPLES_PER_SYMBOL = 8;
+
+/// @brief Mean of |cos| over a carrier cycle, scales the baseband envelope to what an envelope detector sees at passband
+constexpr double BASEBAND_ENVELOPE_SCALE = 2 / M_PI;
+
 /// @brief The amplitude index (ASK) key of bit 0
 constexpr const char *ASK_ZERO_SIGN_KEY = "/modulation/ask/zeroSign";
 
@@ -40,11 +65,91 @@ constexpr const char *FSK_ZERO_SIGN_KEY = "/modulation/fsk/zeroSign";
 /// @brief The frequency index (FSK) key of bit 1
 constexpr const char *FSK_ONE_SIGN_KEY = "/modulation/fsk/oneSign";
 
-/// @brief The sizeo of bits chunk when using 16QAM to modulate
-constexpr unsigned int BIT_SIZE_16QAM = 4;
+/// @brief The FSK detector key: "correlator" (coherent template correlation) or "goertzel" (tone bank of Goertzel filters)
+constexpr const char *FSK_DETECTOR_KEY = "/modulation/fsk/detector";
+
+/// @brief The signal representations the server can simulate a transmission with
+enum class SimulationMode
+{
+    PASSBAND,
+    BASEBAND
+};
+
+/// @brief How an uplink walks through modulation, channel and demodulation
+enum class PipelineMode
+{
+    MATERIALIZED,
+    TILED
+};
+
+/// @brief How the symbols of a tone bank scheme (FSK) are detected
+enum class FskDetection
+{
+    /// @brief Correlate against the cosine template of every tone rotated to the reference phase
+    CORRELATOR,
 
-/// @brief The amplitude levels for 16QAM constellation diagram
-constexpr double IQ_VALUES[] = {-0.75, -0.25, 0.25, 0.75};
+    /// @brief Measure the power of every tone with a Goertzel filter, no template and insensitive to the phase
+    GOERTZEL
+};
+
+/// @brief What an uplink measured on the received samples
+struct LinkStatistics
+{
+    /// @brief The amount of received samples
+    size_t sampleCount;
+
+    /// @brief The amount of tiles the signal went through the link in
+    size_t tileCount;
+
+    /// @brief Sum of the squared received samples
+    double energy;
+
+    /// @brief The largest absolute received sample
+    double peakAmplitude;
+
+    /// @brief The amount of demodulated bits that differ from the binary input
+    size_t bitErrors;
+};
+
+/**
+ * @brief The waveforms of several messages modulated together, stored back to back in one buffer
+ *
+ * @tparam T - the sample type: double, float or int16_t (scaled by INT16_SAMPLE_SCALE)
+ */
+template <typename T>
+struct ModulationBatch
+{
+    /// @brief The samples of every message, message i spans [offsets[i], offsets[i + 1])
+    std::vector<T> samples;
+
+    /// @brief The first sample of every message followed by the total amount of samples
+    std::vector<size_t> offsets;
+};
+
+/**
+ * @brief The receiver state of a signal demodulated chunk by chunk, see Modulator::startDemodulation
+ *
+ * @tparam T - the sample type: double, float or int16_t (scaled by INT16_SAMPLE_SCALE)
+ */
+template <typename T>
+struct DemodulationStream
+{
+    /// @brief The modulation scheme of the signal
+    ModulationScheme scheme;
+
+    /// @brief The amount of samples of one symbol, selected when the stream was started
+    unsigned int samplesPerSymbol;
+
+    /// @brief true - every symbol is decided as soon as its samples are received, false - the receiver needs the
+    /// whole signal (shaped pulses, OFDM, GMSK) and decides it when the stream is finished
+    bool isSymbolBySymbol;
+
+    /// @brief One reference tone per tone of the scheme, at the first pending sample
+    std::vector<Oscillator> references;
+
+    /// @brief The samples received after the last decided symbol, less than one symbol when decided symbol by symbol
+    std::vector<T> pending;
+};
 
 class Modulator
 {
@@ -65,26 +170,190 @@ public:
      * @param p_carrierFrequency - carrier wave frequency
      * @param p_binaryData - a binary data series
      */
-    Modulator(const double p_carrierFrequency, const std::string &p_binaryData);
+    Modulator(const double p_carrierFrequency, const BitBuffer &p_binaryData);
+
+    /**
+     * @brief Modulate signal based on the modulation scheme of the network
+     *
+     * @tparam T - the sample type: double, float or int16_t (scaled by INT16_SAMPLE_SCALE)
+     * @param p_scheme - the modulation scheme, resolved by Carrier::setNetwork
+     *
+     * @return a vector of samples representing modulated signal
+     */
+    template <typename T = double>
+    std::vector<T> modulate(const ModulationScheme &p_scheme);
+
+    /**
+     * @brief Modulate several messages sharing the scheme and the carrier frequency in one call, the scheme is
+     * dispatched and its templates, filters or tables are looked up once for the whole batch
+     *
+     * @tparam T - the sample type: double, float or int16_t (scaled by INT16_SAMPLE_SCALE)
+     * @param p_messages - the binary data series, each a whole number of symbols
+     * @param p_scheme - the modulation scheme, one that does not use a resource grid
+     *
+     * @return the waveforms of the messages in order, the binary input is left at the last message
+     */
+    template <typename T = double>
+    ModulationBatch<T> modulateBatch(const std::vector<BitBuffer> &p_messages, const ModulationScheme &p_scheme);
+
+    /**
+     * @brief Start modulating the binary input based on the modulation scheme, samples are produced on demand
+     *
+     * @param p_scheme - the modulation scheme, resolved by Carrier::setNetwork
+     *
+     * @return a session producing the modulated signal chunk by chunk, empty for an unknown scheme
+     */
+    ModulationSession startModulation(const ModulationScheme &p_scheme);
+
+    /**
+     * @brief Demodulate signal based on the modulation scheme of the network
+     *
+     * @tparam T - the sample type: double, float or int16_t (scaled by INT16_SAMPLE_SCALE)
+     * @param p_signal - a vector of samples representing modulated signal
+     * @param p_scheme - the modulation scheme, resolved by Carrier::setNetwork
+     *
+     * @return a binary data series representing message signal
+     */
+    template <typename T = double>
+    BitBuffer demodulate(const std::vector<T> &p_signal, const ModulationScheme &p_scheme);
+
+    /**
+     * @brief Pass a modulation session through the noisy channel and the demodulator tile by tile, every tile is
+     * modulated, measured, exported and demodulated while it is still in cache. Schemes whose receiver needs the
+     * whole signal (shaped pulses, OFDM, GMSK) go through the same stages on one tile holding the whole signal.
+     *
+     * @tparam T - the sample type: double, float or int16_t (scaled by INT16_SAMPLE_SCALE)
+     * @param p_session - a noisy session started by startModulation with the same scheme, consumed
+     * @param p_scheme - the modulation scheme, resolved by Carrier::setNetwork
+     * @param p_statistics - output, what was measured on the received samples
+     * @param p_export - called with the samples of every tile in order, empty when the signal is not exported
+     *
+     * @return a binary data series representing message signal
+     */
+    template <typename T = double>
+    BitBuffer receiveTiled(ModulationSession &p_session, const ModulationScheme &p_scheme, LinkStatistics &p_statistics,
+                           const std::function<void(const T *, size_t)> &p_export);
+
+    /**
+     * @brief Start demodulating a signal received in chunks of any size, e.g. a live stream or a capture too large
+     * to hold in memory
+     *
+     * @tparam T - the sample type: double, float or int16_t (scaled by INT16_SAMPLE_SCALE)
+     * @param p_scheme - the modulation scheme, resolved by Carrier::setNetwork
+     *
+     * @return the receiver state at the first sample of the signal, decides nothing for an unknown scheme
+     */
+    template <typename T = double>
+    DemodulationStream<T> startDemodulation(const ModulationScheme &p_scheme);
+
+    /**
+     * @brief Demodulate the next chunk of a stream, the symbol left incomplete by the previous chunks is completed
+     * first and the samples after the last whole symbol are kept for the next one. The carrier settings must not
+     * change while the stream runs.
+     *
+     * @tparam T - the sample type
+     * @param p_stream - a stream started by startDemodulation, updated
+     * @param p_signal - the next samples of the signal
+     * @param p_count - the amount of samples, any
+     *
+     * @return the bits of the symbols completed by the chunk, the same bits demodulate gives for them
+     */
+    template <typename T>
+    BitBuffer demodulateChunk(DemodulationStream<T> &p_stream, const T *p_signal, const size_t p_count);
 
     /**
-     * @brief Modulate signal based on network type
+     * @brief End a stream, a trailing partial symbol is decided on its own like demodulate does, schemes whose
+     * receiver needs the whole signal demodulate it here
      *
-     * @param p_networkTypes - a network type
+     * @tparam T - the sample type
+     * @param p_stream - a stream started by startDemodulation, left without pending samples
      *
-     * @return a vector of real number (type double) representing modulated signal
+     * @return the bits not returned by demodulateChunk yet
      */
-    std::vector<double> modulate(const std::string &p_networkTypes);
+    template <typename T>
+    BitBuffer finishDemodulation(DemodulationStream<T> &p_stream);
 
     /**
-     * @brief Demodulate signal based on network type
+     * @brief Modulate the binary input into complex baseband samples, the complex envelope of the carrier
      *
-     * @param p_signal - a vector of real number (type double) representing modulated signal
-     * @param p_networkTypes - a network type
+     * @param p_scheme - the modulation scheme, resolved by Carrier::setNetwork
      *
-     * @return a set of real number (type double) representing modulated signal
+     * @return a vector of complex samples, getBasebandSamplesPerSymbol() per symbol, empty for an unknown scheme
      */
-    std::string demodulate(const std::vector<double> &p_signal, const std::string &p_networkTypes);
+    std::vector<std::complex<double>> modulateBaseband(const ModulationScheme &p_scheme);
+
+    /**
+     * @brief Demodulate complex baseband samples
+     *
+     * @param p_signal - a vector of complex samples produced by modulateBaseband
+     * @param p_scheme - the modulation scheme, resolved by Carrier::setNetwork
+     *
+     * @return a binary data series representing message signal
+     */
+    BitBuffer demodulateBaseband(const std::vector<std::complex<double>> &p_signal, const ModulationScheme &p_scheme);
+
+    /**
+     * @brief Mix complex baseband samples up to the carrier on the server sample clock, only needed for visualization
+     *
+     * @param p_signal - a vector of complex samples produced by modulateBaseband
+     *
+     * @return the passband signal, samples in between baseband samples are linearly interpolated
+     */
+    std::vector<double> upconvert(const std::vector<std::complex<double>> &p_signal);
+
+    /**
+     * @brief Check whether the downlink payloads of a scheme are scheduled on an OFDMA resource grid
+     *
+     * @param p_scheme - the modulation scheme, resolved by Carrier::setNetwork
+     *
+     * @return true - the scheme is sent as OFDM, false - every payload is modulated on its own
+     */
+    bool usesResourceGrid(const ModulationScheme &p_scheme);
+
+    /**
+     * @brief Get the amount of OFDM subcarriers, the width of a resource grid
+     *
+     * @return the amount of OFDM subcarriers, 0 when OFDM is disabled
+     */
+    unsigned int getOfdmSubcarriers() const;
+
+    /**
+     * @brief Start modulating the payloads of every client of a resource grid in one pass
+     *
+     * @param p_grid - the resource grid of the slot, getOfdmSubcarriers() wide
+     * @param p_scheme - the modulation scheme, one that usesResourceGrid()
+     *
+     * @return a session producing the modulated slot chunk by chunk, empty for a scheme without OFDM
+     */
+    ModulationSession startGridModulation(const ResourceGrid &p_grid, const ModulationScheme &p_scheme);
+
+    /**
+     * @brief Demodulate a slot and split it back into the payload of every client
+     *
+     * @tparam T - the sample type of the signal
+     * @param p_signal - a vector of samples produced by startGridModulation
+     * @param p_grid - the resource grid the slot was modulated from
+     * @param p_scheme - the modulation scheme, one that usesResourceGrid()
+     *
+     * @return one binary data series per allocation of the grid, in allocation order
+     */
+    template <typename T = double>
+    std::vector<BitBuffer> demodulateGrid(const std::vector<T> &p_signal, const ResourceGrid &p_grid,
+                                          const ModulationScheme &p_scheme);
+
+    /**
+     * @brief Create a resampler converting signals from the simulation sample rate to the /fs output rate
+     *
+     * @return a resampler set up for the sample rate of the last modulated or demodulated scheme
+     */
+    FarrowResampler createOutputResampler();
+
+    /**
+     * @brief Get the amount of complex samples of one baseband symbol
+     *
+     * @return the baseband samples per symbol
+     */
+    unsigned int getBasebandSamplesPerSymbol();
 
     /**
      * @brief Set carrier wave frequency for server
@@ -93,12 +362,34 @@ public:
      */
     void setFrequency(const double &p_frequency);
 
+    /**
+     * @brief Select the arithmetic of the int16 sample path, schemes stitched from waveform templates and correlated
+     * symbol by symbol run in fixed point, shaped pulses, OFDM and GMSK keep floating point
+     *
+     * @param p_arithmetic - the arithmetic of the carrier, see Carrier::getArithmetic
+     */
+    void setArithmetic(const Arithmetic p_arithmetic);
+
+    /**
+     * @brief Select the detector of the FSK schemes, overriding the database setting until the next setFrequency
+     *
+     * @param p_detection - the correlator or the Goertzel tone bank
+     */
+    void setFskDetection(const FskDetection p_detection);
+
+    /**
+     * @brief Select whether the modulation sessions add the channel noise, a noiseless signal is exactly reproducible
+     *
+     * @param p_isNoisy - true - Gaussian noise of NOISE_LEVEL is added to every produced sample (default)
+     */
+    void setNoisy(const bool p_isNoisy);
+
     /**
      * @brief Set binary data input for server
      *
      * @param p_binaryData - a binary data series
      */
-    void setBinaryInput(const std::string &p_binaryData);
+    void setBinaryInput(const BitBuffer &p_binaryData);
 
     /**
      * @brief Generate random binary data
@@ -107,50 +398,78 @@ public:
      *
      * @return a binary data series
      */
-    std::string randomBinaryMessageGenerator(const int p_length);
+    BitBuffer randomBinaryMessageGenerator(const int p_length);
 
     /**
      * @brief Add Gaussian noise to the signal
      *
-     * @param p_signal - a vector of real number (type double) representing modulated signal
+     * @tparam T - the sample type: double, float or int16_t (scaled by INT16_SAMPLE_SCALE)
+     * @param p_signal - a vector of samples representing modulated signal
+     */
+    template <typename T>
+    void addNoise(std::vector<T> &p_signal);
+
+    /**
+     * @brief Add complex Gaussian noise to a baseband signal, NOISE_LEVEL on each of I and Q
      *
-     * @return value of signal at specific time
+     * @param p_signal - a vector of complex samples representing modulated signal
      */
-    void addNoise(std::vector<double> &p_signal);
+    void addNoise(std::vector<std::complex<double>> &p_signal);
 
 private:
     /// @brief Carrier wave frequency
     double m_carrierFrequency;
 
-    /// @brief The amount of samples transmitted in 1 second
-    int m_sampleRate;
+    /// @brief The amount of samples simulated in 1 second, always a whole number of samples per symbol
+    double m_sampleRate;
+
+    /// @brief The amount of samples written to the output in 1 second (/fs)
+    int m_outputRate;
 
-    /// @brief The amount of bits transmitted in 1 second
-    unsigned int m_bitRate;
+    /// @brief The amount of symbols transmitted in 1 second
+    double m_symbolRate;
 
-    /// @brief The amount of bits transmitted in 1 second
+    /// @brief The configured samples per symbol, 0 follows the output rate
+    unsigned int m_oversampling;
+
+    /// @brief The amount of samples of one symbol at the simulation sample rate
     unsigned int m_samplesPerBit;
 
+    /// @brief The amount of complex samples of one symbol in baseband mode
+    unsigned int m_basebandSamplesPerSymbol;
+
+    /// @brief The amount of complex samples of one symbol of the last baseband signal, a whole OFDM symbol for OFDM
+    size_t m_basebandSymbolLength;
+
     /// @brief A binary data series
-    std::string m_binaryInput;
+    BitBuffer m_binaryInput;
+
+    /// @brief The ASK, PSK and FSK signs of bit 0 and bit 1
+    ModulationParameters m_parameters;
 
-    /// @brief key of bit 0 sign for ASK
-    float m_askZeroSign;
+    /// @brief The pulse shape of linear schemes (PSK, M-PSK, M-QAM)
+    PulseShapingParameters m_pulseShaping;
 
-    /// @brief key of bit 1 sign for ASK
-    float m_askOneSign;
+    /// @brief The OFDM settings of the QAM network (5G)
+    OfdmParameters m_ofdm;
 
-    /// @brief key of bit 0 sign for PSK
-    float m_pskZeroSign;
+    /// @brief The GMSK settings of the 2G network
+    GmskParameters m_gmsk;
 
-    /// @brief key of bit 1 sign for PSK
-    float m_pskOneSign;
+    /// @brief The amount of threads long signals are split over, resolved from the configured count
+    unsigned int m_threadCount;
 
-    /// @brief key of bit 0 sign for FSK
-    float m_fskZeroSign;
+    /// @brief The arithmetic of the int16 sample path
+    Arithmetic m_arithmetic;
 
-    /// @brief key of bit 1 sign for FSK
-    float m_fskOneSign;
+    /// @brief The detector of the FSK schemes
+    FskDetection m_fskDetection;
+
+    /// @brief true - the modulation sessions add Gaussian noise to every produced sample
+    bool m_isNoisy;
+
+    /// @brief How the carrier and baseband oscillators re-anchor their phasor
+    TrigMode m_trigMode;
 
     /**
      * @brief Reading all modulation and sample rate values in server database
@@ -158,78 +477,448 @@ private:
     void readDatabase();
 
     /**
-     * @brief Calculate signal value given amplitude, frequency, time and phase of the signal wave
+     * @brief Create an oscillator running at a multiple of the carrier frequency on the server sample clock
      *
-     * @param p_amplitudeIndex - the amplitude index in ASK modulation
      * @param p_frequencyIndex - the frequency index in FSK modulation
-     * @param p_time - time variable
-     * @param p_phase - the phase increment in PSK modulation
+     * @param p_phase - the initial phase angle of the carrier wave
+     *
+     * @return an oscillator starting at time 0
+     */
+    Oscillator getCarrierOscillator(const double &p_frequencyIndex, const double &p_phase);
+
+    /**
+     * @brief Read the sample rate in server database
+     *
+     * @return the amount of samples transmitted in 1 second
+     */
+    int readSampleRate();
+
+    /**
+     * @brief Read the baseband samples per symbol in server database
+     *
+     * @return the baseband samples per symbol, DEFAULT_BASEBAND_SAMPLES_PER_SYMBOL when it is not set
+     */
+    unsigned int readBasebandSamplesPerSymbol();
+
+    /**
+     * @brief Read the symbol rate and the oversampling in server database
+     */
+    void readSymbolTiming();
+
+    /**
+     * @brief Read the pulse shape, its roll-off or BT and its span in server database, rectangular when it is not set
+     */
+    void readPulseShaping();
+
+    /**
+     * @brief Read the subcarrier count and the cyclic prefix in server database, OFDM is disabled when they are not set
+     */
+    void readOfdm();
+
+    /**
+     * @brief Read the GMSK bandwidth-time product and detector in server database
+     */
+    void readGmsk();
+
+    /**
+     * @brief Read the FSK detector in server database, the correlator when it is not set
+     */
+    void readFskDetection();
+
+    /**
+     * @brief Read the thread count in server database, every hardware thread is used when it is not set
+     */
+    void readThreadCount();
+
+    /**
+     * @brief Read the trig mode of the oscillators in server database, libm when it is not set
+     */
+    void readTrigMode();
+
+    /**
+     * @brief Produce a whole signal, long signals are split into symbol ranges produced concurrently by copies
+     * of the session moved to the start of their range
+     *
+     * @tparam T - the sample type
+     * @param p_session - a session that has not produced any sample yet, consumed
+     * @param p_signal - output buffer of getTotalSamples() samples
+     */
+    template <typename T>
+    void produceSymbolRanges(ModulationSession &p_session, T *p_signal);
+
+    /**
+     * @brief Select the OFDM symbol grid: the carrier is put on a whole bin, the subcarrier spacing follows
+     * from it and the FFT size is the smallest power of 2 keeping the highest subcarrier below Nyquist.
+     * The simulation sample rate and the samples per symbol are set to the passband grid in both modes.
+     *
+     * @param p_isBaseband - true - the engine generates complex baseband OFDM symbols
+     *
+     * @return the OFDM symbol mapper
+     */
+    std::shared_ptr<const OfdmEngine> createOfdmEngine(const bool p_isBaseband);
+
+    /**
+     * @brief Select the samples per symbol and the simulation sample rate of a scheme, the configured
+     * oversampling is raised to the minimum that keeps the highest tone of the scheme below Nyquist
+     *
+     * @tparam Policy - the modulation policy of the scheme, see modulationPolicy.h
+     */
+    template <typename Policy>
+    void selectSamplesPerSymbol();
+
+    /**
+     * @brief Create an oscillator running at the offset of a tone from the carrier on the baseband sample clock
+     *
+     * @param p_frequencyIndex - the frequency index of the tone
+     * @param p_phase - the initial phase angle of the carrier wave
+     *
+     * @return an oscillator starting at time 0
+     */
+    Oscillator getBasebandOscillator(const double &p_frequencyIndex, const double &p_phase);
+
+    /**
+     * @brief Check the binary input fills a whole number of symbols of a scheme
+     *
+     * @param p_bitsPerSymbol - the amount of bits carried by one symbol
+     */
+    void checkBinaryInput(const unsigned int p_bitsPerSymbol);
+
+    /**
+     * @brief Get the value of a symbol of the binary input
+     *
+     * @param p_symbolIdx - index of the symbol
+     * @param p_bitsPerSymbol - the amount of bits carried by one symbol
+     *
+     * @return the symbol value, bits are read most significant first
+     */
+    unsigned int readSymbol(const size_t p_symbolIdx, const unsigned int p_bitsPerSymbol) const;
+
+    /**
+     * @brief Get the complex envelope I - jQ of every symbol of a linear scheme
+     *
+     * @tparam Policy - the modulation policy of the scheme, see modulationPolicy.h
+     *
+     * @return the envelope of every symbol value
+     */
+    template <typename Policy>
+    std::vector<std::complex<double>> getEnvelopePoints();
+
+    /**
+     * @brief Decide the symbols of a linear scheme from their received complex envelopes
+     *
+     * @tparam Policy - the modulation policy of the scheme, see modulationPolicy.h
+     * @param p_points - the received complex envelope of every symbol
+     * @param p_samplesPerSymbol - the amount of samples of one symbol
+     *
+     * @return a binary data series representing message signal
+     */
+    template <typename Policy>
+    BitBuffer decideEnvelopePoints(const std::vector<std::complex<double>> &p_points, const unsigned int p_samplesPerSymbol);
+
+    /**
+     * @brief Generate the OFDM symbols carrying the binary input
+     *
+     * @tparam Policy - the modulation policy of the scheme, see modulationPolicy.h
+     * @param p_engine - the OFDM symbol mapper
      *
-     * @return value of signal at specific time
+     * @return getSymbolLength() complex samples per OFDM symbol
      */
-    double getSignalValue(const double &p_amplitudeIndex, const double &p_frequencyIndex, const double &p_time, const double &p_phase);
+    template <typename Policy>
+    std::vector<std::complex<double>> modulateOfdmSymbols(const OfdmEngine &p_engine);
 
     /**
-     * @brief ASK Modulation
+     * @brief Demodulate OFDM symbols, the empty subcarriers at the end of the last OFDM symbol are dropped
      *
-     * @return a vector of real number (type double) representing modulated signal
+     * @tparam Policy - the modulation policy of the scheme, see modulationPolicy.h
+     * @param p_engine - the OFDM symbol mapper
+     * @param p_samples - complex samples, transformed in place
+     *
+     * @return a binary data series representing message signal
      */
-    std::vector<double> askModulation();
+    template <typename Policy>
+    BitBuffer demodulateOfdmSymbols(const OfdmEngine &p_engine, std::vector<std::complex<double>> &p_samples);
 
     /**
-     * @brief PSK Modulation
+     * @brief Get the received point of every subcarrier of every whole OFDM symbol
+     *
+     * @param p_engine - the OFDM symbol mapper
+     * @param p_samples - complex samples, transformed in place
      *
-     * @return a vector of real number (type double) representing modulated signal
+     * @return getSubcarriers() points per OFDM symbol
      */
-    std::vector<double> pskModulation();
+    std::vector<std::complex<double>> receiveOfdmElements(const OfdmEngine &p_engine, std::vector<std::complex<double>> &p_samples);
 
     /**
-     * @brief FSK Modulation
+     * @brief Map a resource grid to the points of a scheme and start its modulation
+     *
+     * @tparam Policy - the modulation policy of the scheme, see modulationPolicy.h
+     * @param p_grid - the resource grid of the slot
+     *
+     * @return a session producing the modulated slot
+     */
+    template <typename Policy>
+    ModulationSession createGridSession(const ResourceGrid &p_grid);
+
+    /**
+     * @brief Demodulate a slot and decide the points of every allocation of its resource grid
+     *
+     * @tparam Policy - the modulation policy of the scheme, see modulationPolicy.h
+     * @tparam T - the sample type of the signal
+     * @param p_signal - a vector of samples produced by createGridSession
+     * @param p_grid - the resource grid the slot was modulated from
      *
-     * @return a vector of real number (type double) representing modulated signal
+     * @return one binary data series per allocation of the grid
      */
-    std::vector<double> fskModulation();
+    template <typename Policy, typename T>
+    std::vector<BitBuffer> demodulateGridSymbols(const std::vector<T> &p_signal, const ResourceGrid &p_grid);
 
     /**
-     * @brief 16 QAM Modulation
+     * @brief Start a GMSK modulation session of the binary input
      *
-     * @return a vector of real number (type double) representing modulated signal
+     * @return a session producing the modulated signal
      */
-    std::vector<double> qam16Modulation();
+    ModulationSession createGmskSession();
 
     /**
-     * @brief ASK Demodulation
+     * @brief Demodulate a GMSK signal, the carrier is mixed down and the envelope is detected
      *
-     * @param p_signal - a vector of real number (type double) representing modulated signal
+     * @tparam T - the sample type of the signal
+     * @param p_signal - a vector of samples produced by createGmskSession
      *
      * @return a binary data series representing message signal
      */
-    std::string askDemodulation(const std::vector<double> &p_signal);
+    template <typename T>
+    BitBuffer demodulateGmsk(const std::vector<T> &p_signal);
 
     /**
-     * @brief PSK Demodulation
+     * @brief Generate the GMSK complex envelope of the binary input
      *
-     * @param p_signal - a vector of real number (type double) representing modulated signal
+     * @return getBasebandSamplesPerSymbol() complex samples per symbol, flush symbols included
+     */
+    std::vector<std::complex<double>> modulateBasebandGmsk();
+
+    /**
+     * @brief Detect a GMSK complex envelope
+     *
+     * @param p_signal - a vector of complex samples produced by modulateBasebandGmsk
      *
      * @return a binary data series representing message signal
      */
-    std::string pskDemodulation(const std::vector<double> &p_signal);
+    BitBuffer demodulateBasebandGmsk(const std::vector<std::complex<double>> &p_signal);
+
+    /**
+     * @brief Start a modulation session of the binary input, stitched from the cached waveform templates
+     *
+     * @tparam Policy - the modulation policy of the scheme, see modulationPolicy.h
+     *
+     * @return a session producing the modulated signal
+     */
+    template <typename Policy>
+    ModulationSession createSession();
+
+    /**
+     * @brief Get the cached waveform templates of a scheme at the current carrier and sample rate
+     *
+     * @tparam Policy - the modulation policy of the scheme, see modulationPolicy.h
+     *
+     * @return the symbol templates and tone basis of the scheme
+     */
+    template <typename Policy>
+    std::shared_ptr<const WaveformTemplate> getWaveformTemplate();
+
+    /**
+     * @brief Demodulate a signal by correlating every symbol against the reference tones of a scheme
+     *
+     * @tparam Policy - the modulation policy of the scheme, see modulationPolicy.h
+     * @tparam T - the sample type
+     * @param p_signal - a vector of samples representing modulated signal
+     *
+     * @return a binary data series representing message signal
+     */
+    template <typename Policy, typename T>
+    BitBuffer demodulateSymbols(const std::vector<T> &p_signal);
+
+    /**
+     * @brief Correlate a run of symbols split into contiguous ranges, one per thread, and append their decisions
+     *
+     * @tparam Policy - the modulation policy of the scheme, see modulationPolicy.h
+     * @tparam T - the sample type
+     * @param p_signal - samples starting on a symbol boundary
+     * @param p_count - the amount of samples, a trailing partial symbol is decided on its own
+     * @param p_references - the reference tones at the first sample, advanced by p_count samples
+     * @param p_outputBinary - the decided bits are appended to it
+     */
+    template <typename Policy, typename T>
+    void correlateSymbolRanges(const T *p_signal, const size_t p_count, std::array<Oscillator, Policy::TONE_COUNT> &p_references,
+                               BitBuffer &p_outputBinary);
 
     /**
-     * @brief FSK Demodulation
+     * @brief Demodulate the next chunk of a stream decided symbol by symbol
      *
-     * @param p_signal - a vector of real number (type double) representing modulated signal
+     * @tparam Policy - the modulation policy of the scheme, see modulationPolicy.h
+     * @tparam T - the sample type
+     * @param p_stream - the stream, its pending samples and references are updated
+     * @param p_signal - the next samples of the signal
+     * @param p_count - the amount of samples
+     * @param p_outputBinary - the bits of the completed symbols are appended to it
+     */
+    template <typename Policy, typename T>
+    void demodulateStreamSymbols(DemodulationStream<T> &p_stream, const T *p_signal, const size_t p_count,
+                                 BitBuffer &p_outputBinary);
+
+    /**
+     * @brief Create the reference tones of a scheme, carrying the same phase offset as the transmitted carrier
+     *
+     * @tparam Policy - the modulation policy of the scheme, see modulationPolicy.h
+     *
+     * @return one oscillator per tone, starting at time 0
+     */
+    template <typename Policy>
+    std::array<Oscillator, Policy::TONE_COUNT> createReferences();
+
+    /**
+     * @brief Correlate whole symbols against the reference tones and append their decisions
+     *
+     * All the symbols are correlated against the cached cosine/sine basis of every tone in one SIMD kernel call, in
+     * the precision of the samples (Q15 with 64-bit sums for int16 in fixed-point arithmetic), the sums are then
+     * rotated to the reference phase at the start of each symbol and decided. ASK sums the magnitudes instead and FSK
+     * runs the Goertzel tone bank when it is selected, see detectTones.
+     *
+     * @tparam Policy - the modulation policy of the scheme, see modulationPolicy.h
+     * @tparam T - the sample type
+     * @param p_signal - samples starting on a symbol boundary
+     * @param p_count - the amount of samples, a trailing partial symbol is decided on its own
+     * @param p_references - the reference tones, only read at symbol boundaries and advanced by p_count samples
+     * @param p_outputBinary - the decided bits are appended to it
+     */
+    template <typename Policy, typename T>
+    void correlateSymbols(const T *p_signal, const size_t p_count, std::array<Oscillator, Policy::TONE_COUNT> &p_references,
+                          BitBuffer &p_outputBinary);
+
+    /**
+     * @brief Measure the power of every tone of a tone bank scheme in whole symbols and append their decisions
+     *
+     * Every tone is a Goertzel filter run over the symbol, the recurrence needs no template and one multiply per
+     * sample, so an M-ary scheme costs M filters instead of M template correlations. Samples other than double are
+     * converted one tile at a time.
+     *
+     * @tparam Policy - the modulation policy of a scheme with TONE_BANK, see modulationPolicy.h
+     * @tparam T - the sample type
+     * @param p_signal - samples starting on a symbol boundary
+     * @param p_count - the amount of samples, a trailing partial symbol is decided on its own
+     * @param p_references - the reference tones, not read, only advanced by p_count samples
+     * @param p_outputBinary - the decided bits are appended to it
+     */
+    template <typename Policy, typename T>
+    void detectTones(const T *p_signal, const size_t p_count, std::array<Oscillator, Policy::TONE_COUNT> &p_references,
+                     BitBuffer &p_outputBinary);
+
+    /**
+     * @brief Check whether the receiver of a scheme decides every symbol from its own samples only
+     *
+     * @tparam Policy - the modulation policy of a scheme with symbol decisions, see modulationPolicy.h
+     *
+     * @return true - the signal can be demodulated tile by tile, false - the receiver needs the whole signal
+     */
+    template <typename Policy>
+    bool decidesSymbolBySymbol();
+
+    /**
+     * @brief Run the tiled link of a scheme decided symbol by symbol
+     *
+     * @tparam Policy - the modulation policy of the scheme, see modulationPolicy.h
+     * @tparam T - the sample type
      *
      * @return a binary data series representing message signal
      */
-    std::string fskDemodulation(const std::vector<double> &p_signal);
+    template <typename Policy, typename T>
+    BitBuffer receiveSymbolTiles(ModulationSession &p_session, LinkStatistics &p_statistics,
+                                 const std::function<void(const T *, size_t)> &p_export);
+
+    /**
+     * @brief Turn the I/Q correlations of a symbol into least squares I/Q gains, so a symbol that does not
+     * span a whole number of carrier cycles is not skewed by the cosine and sine references leaking into each other
+     *
+     * @param p_inPhase - sum of x * cos, replaced by the in-phase gain * m_samplesPerBit / 2
+     * @param p_quadrature - sum of x * sin, replaced by the quadrature gain * m_samplesPerBit / 2
+     * @param p_squares - sum of the squared reference phasors over the symbol
+     * @param p_count - the amount of samples of the symbol
+     */
+    void equalizeCorrelation(double &p_inPhase, double &p_quadrature, const std::complex<double> &p_squares, const size_t p_count);
+
+    /**
+     * @brief Generate the complex envelope of every symbol of the binary input
+     *
+     * @tparam Policy - the modulation policy of the scheme, see modulationPolicy.h
+     *
+     * @return a vector of complex samples
+     */
+    template <typename Policy>
+    std::vector<std::complex<double>> modulateBasebandSymbols();
 
     /**
-     * @brief 16 QAM Demodulation
+     * @brief Demodulate a baseband signal, the correlations are scaled to match the passband demodulator
+     * so the same policy decisions apply
      *
-     * @param p_signal - a vector of real number (type double) representing modulated signal
+     * @tparam Policy - the modulation policy of the scheme, see modulationPolicy.h
+     * @param p_signal - a vector of complex samples
      *
      * @return a binary data series representing message signal
      */
-    std::string qam16Demodulation(const std::vector<double> &p_signal);
-};
\ No newline at end of file
+    template <typename Policy>
+    BitBuffer demodulateBasebandSymbols(const std::vector<std::complex<double>> &p_signal);
+};
+
+extern template std::vector<double> Modulator::modulate<double>(const ModulationScheme &p_scheme);
+extern template std::vector<float> Modulator::modulate<float>(const ModulationScheme &p_scheme);
+extern template std::vector<int16_t> Modulator::modulate<int16_t>(const ModulationScheme &p_scheme);
+
+extern template ModulationBatch<double> Modulator::modulateBatch<double>(const std::vector<BitBuffer> &p_messages,
+                                                                        const ModulationScheme &p_scheme);
+extern template ModulationBatch<float> Modulator::modulateBatch<float>(const std::vector<BitBuffer> &p_messages,
+                                                                      const ModulationScheme &p_scheme);
+extern template ModulationBatch<int16_t> Modulator::modulateBatch<int16_t>(const std::vector<BitBuffer> &p_messages,
+                                                                          const ModulationScheme &p_scheme);
+
+extern template BitBuffer Modulator::demodulate<double>(const std::vector<double> &p_signal, const ModulationScheme &p_scheme);
+extern template BitBuffer Modulator::demodulate<float>(const std::vector<float> &p_signal, const ModulationScheme &p_scheme);
+extern template BitBuffer Modulator::demodulate<int16_t>(const std::vector<int16_t> &p_signal, const ModulationScheme &p_scheme);
+
+extern template BitBuffer Modulator::receiveTiled<double>(ModulationSession &p_session, const ModulationScheme &p_scheme,
+                                                          LinkStatistics &p_statistics,
+                                                          const std::function<void(const double *, size_t)> &p_export);
+extern template BitBuffer Modulator::receiveTiled<float>(ModulationSession &p_session, const ModulationScheme &p_scheme,
+                                                         LinkStatistics &p_statistics,
+                                                         const std::function<void(const float *, size_t)> &p_export);
+extern template BitBuffer Modulator::receiveTiled<int16_t>(ModulationSession &p_session, const ModulationScheme &p_scheme,
+                                                           LinkStatistics &p_statistics,
+                                                           const std::function<void(const int16_t *, size_t)> &p_export);
+
+extern template DemodulationStream<double> Modulator::startDemodulation<double>(const ModulationScheme &p_scheme);
+extern template DemodulationStream<float> Modulator::startDemodulation<float>(const ModulationScheme &p_scheme);
+extern template DemodulationStream<int16_t> Modulator::startDemodulation<int16_t>(const ModulationScheme &p_scheme);
+
+extern template BitBuffer Modulator::demodulateChunk<double>(DemodulationStream<double> &p_stream, const double *p_signal,
+                                                             const size_t p_count);
+extern template BitBuffer Modulator::demodulateChunk<float>(DemodulationStream<float> &p_stream, const float *p_signal,
+                                                            const size_t p_count);
+extern template BitBuffer Modulator::demodulateChunk<int16_t>(DemodulationStream<int16_t> &p_stream, const int16_t *p_signal,
+                                                              const size_t p_count);
+
+extern template BitBuffer Modulator::finishDemodulation<double>(DemodulationStream<double> &p_stream);
+extern template BitBuffer Modulator::finishDemodulation<float>(DemodulationStream<float> &p_stream);
+extern template BitBuffer Modulator::finishDemodulation<int16_t>(DemodulationStream<int16_t> &p_stream);
+
+extern template std::vector<BitBuffer> Modulator::demodulateGrid<double>(const std::vector<double> &p_signal,
+                                                                         const ResourceGrid &p_grid,
+                                                                         const ModulationScheme &p_scheme);
+extern template std::vector<BitBuffer> Modulator::demodulateGrid<float>(const std::vector<float> &p_signal,
+                                                                        const ResourceGrid &p_grid,
+                                                                        const ModulationScheme &p_scheme);
+extern template std::vector<BitBuffer> Modulator::demodulateGrid<int16_t>(const std::vector<int16_t> &p_signal,
+                                                                          const ResourceGrid &p_grid,
+                                                                          const ModulationScheme &p_scheme);
+
+extern template void Modulator::addNoise<double>(std::vector<double> &p_signal);
+extern template void Modulator::addNoise<float>(std::vector<float> &p_signal);
+extern template void Modulator::addNoise<int16_t>(std::vector<int16_t> &p_signal);
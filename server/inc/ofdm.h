@@ -0,0 +1,127 @@
+#pragma once
+#include <complex>
+#include <memory>
+#include <vector>
+#include "fft.h"
+
+/// @brief The subcarrier count key of the QAM network (5G), 0 keeps the single carrier waveform
+constexpr const char *OFDM_SUBCARRIERS_KEY = "/modulation/ofdm/subcarriers";
+
+/// @brief The cyclic prefix key, a fraction of the useful OFDM symbol length
+constexpr const char *OFDM_CYCLIC_PREFIX_KEY = "/modulation/ofdm/cyclicPrefix";
+
+/// @brief The cyclic prefix fraction when the database has no setting
+constexpr double DEFAULT_OFDM_CYCLIC_PREFIX = 0.125;
+
+/// @brief The OFDM settings read from the server database
+struct OfdmParameters
+{
+    /// @brief The amount of subcarriers carrying a constellation point, 0 disables OFDM
+    unsigned int subcarriers;
+
+    /// @brief The cyclic prefix length, a fraction of the FFT size
+    double cyclicPrefix;
+};
+
+/**
+ * @brief OFDM symbol mapper: every OFDM symbol carries one constellation point per subcarrier
+ *
+ * The subcarriers are centered on a carrier bin: bin 0 gives a complex baseband signal, a positive bin
+ * gives a passband signal whose real part is transmitted, the carrier then sits on a whole bin so its
+ * mixing image never leaks into the subcarriers. Each OFDM symbol is one inverse FFT preceded by a
+ * cyclic prefix, so a receiver recovers all its points with one forward FFT instead of correlating
+ * every sample against every subcarrier. Subcarriers left over in the last OFDM symbol stay empty.
+ */
+class OfdmEngine
+{
+public:
+    /**
+     * @brief Customize Constructor to set up the symbol grid
+     *
+     * @param p_subcarriers - the amount of subcarriers
+     * @param p_fftSize - the FFT size, a power of 2
+     * @param p_prefixLength - the amount of cyclic prefix samples
+     * @param p_carrierBin - the bin the subcarriers are centered on, 0 for a complex baseband signal
+     * @param p_initialPhase - the carrier phase at time 0
+     */
+    OfdmEngine(const unsigned int p_subcarriers, const size_t p_fftSize, const size_t p_prefixLength,
+               const size_t p_carrierBin, const double p_initialPhase);
+
+    /**
+     * @brief Get the amount of subcarriers
+     *
+     * @return the amount of points carried by one OFDM symbol
+     */
+    unsigned int getSubcarriers() const;
+
+    /**
+     * @brief Get the amount of samples of one OFDM symbol
+     *
+     * @return the FFT size plus the cyclic prefix
+     */
+    size_t getSymbolLength() const;
+
+    /**
+     * @brief Get the amount of OFDM symbols needed to carry some points
+     *
+     * @param p_pointCount - the amount of constellation points
+     *
+     * @return the amount of OFDM symbols
+     */
+    size_t getSymbolCount(const size_t p_pointCount) const;
+
+    /**
+     * @brief Generate the samples of one OFDM symbol
+     *
+     * @param p_points - the points of the symbol, one per subcarrier from the lowest frequency
+     * @param p_count - the amount of points, at most getSubcarriers(), the other subcarriers stay empty
+     * @param p_symbolIdx - index of the OFDM symbol, sets the carrier phase it starts at
+     * @param p_samples - output buffer of getSymbolLength() complex samples, the real part is the passband signal
+     */
+    void modulateSymbol(const std::complex<double> *p_points, const size_t p_count, const size_t p_symbolIdx,
+                        std::complex<double> *p_samples) const;
+
+    /**
+     * @brief Recover the points of one OFDM symbol
+     *
+     * @param p_samples - getSymbolLength() complex samples, the useful part is transformed in place
+     * @param p_symbolIdx - index of the OFDM symbol
+     * @param p_points - output buffer of getSubcarriers() points
+     */
+    void demodulateSymbol(std::complex<double> *p_samples, const size_t p_symbolIdx, std::complex<double> *p_points) const;
+
+private:
+    /// @brief The amount of subcarriers
+    unsigned int m_subcarriers;
+
+    /// @brief The amount of cyclic prefix samples
+    size_t m_prefixLength;
+
+    /// @brief The bin the subcarriers are centered on, 0 for a complex baseband signal
+    size_t m_carrierBin;
+
+    /// @brief The carrier phase at time 0
+    double m_initialPhase;
+
+    /// @brief The cached FFT plan
+    std::shared_ptr<const FftPlan> m_plan;
+
+    /**
+     * @brief Get the FFT bin of a subcarrier
+     *
+     * @param p_subcarrier - index of the subcarrier, from the lowest frequency
+     *
+     * @return the bin in range [0, FFT size)
+     */
+    size_t getBin(const unsigned int p_subcarrier) const;
+
+    /**
+     * @brief Get the carrier phasor at the start of the useful part of an OFDM symbol, the carrier runs
+     * continuously through the cyclic prefixes
+     *
+     * @param p_symbolIdx - index of the OFDM symbol
+     *
+     * @return the carrier phasor
+     */
+    std::complex<double> getSymbolPhasor(const size_t p_symbolIdx) const;
+};
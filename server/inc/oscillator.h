@@ -0,0 +1,161 @@
+#pragma once
+#include <cstdint>
+#include <cmath>
+#include <complex>
+#include "sineTable.h"
+
+/// @brief The number of samples generated by rotation before the phasor is re-anchored to the phase accumulator
+constexpr unsigned int OSCILLATOR_RENORMALIZE_INTERVAL = 1024;
+
+/// @brief The scale of the phase accumulator, one full carrier cycle equals 2^64 accumulator steps
+constexpr double OSCILLATOR_PHASE_SCALE = 18446744073709551616.0;
+
+/**
+ * @brief Numerically controlled oscillator producing e^{j(2*pi*f*n/fs + phase)} sample by sample
+ *
+ * The exact phase lives in a 64-bit phase accumulator, so the sample clock never drifts no matter how
+ * long the message is. The output phasor is advanced by a complex rotation (one complex multiply per
+ * sample, no libm call) and re-anchored to the accumulator every OSCILLATOR_RENORMALIZE_INTERVAL samples,
+ * which keeps the rounding error of the recurrence bounded.
+ */
+class Oscillator
+{
+public:
+    /// @brief Default constructor, the oscillator stays at DC until it is configured
+    Oscillator();
+
+    /**
+     * @brief Customize Constructor to set up oscillator frequency and initial phase
+     *
+     * @param p_frequency - oscillator frequency
+     * @param p_sampleRate - the amount of samples generated in 1 second
+     * @param p_phase - initial phase angle in radian
+     */
+    Oscillator(const double p_frequency, const double p_sampleRate, const double p_phase = 0.0);
+
+    /**
+     * @brief Set up oscillator frequency and initial phase, the sample clock is reset to 0
+     *
+     * @param p_frequency - oscillator frequency
+     * @param p_sampleRate - the amount of samples generated in 1 second
+     * @param p_phase - initial phase angle in radian
+     */
+    void configure(const double p_frequency, const double p_sampleRate, const double p_phase = 0.0);
+
+    /**
+     * @brief Select how the phasor is re-anchored to the phase accumulator, the rotation between anchors is unchanged
+     *
+     * @param p_mode - libm for an exact anchor, table for the quarter-wave sine table
+     */
+    void setTrigMode(const TrigMode p_mode);
+
+    /**
+     * @brief Reset the sample clock to 0, the oscillator restarts at its initial phase
+     */
+    void reset();
+
+    /**
+     * @brief Jump the sample clock forward without generating the skipped samples
+     *
+     * @param p_samples - the amount of samples to skip
+     */
+    void skip(const uint64_t p_samples);
+
+    /**
+     * @brief Get the phasor of the current sample
+     *
+     * @return e^{j*phase} of the current sample
+     */
+    const std::complex<double> &value() const
+    {
+        return m_phasor;
+    }
+
+    /**
+     * @brief Get the phasor of the current sample and advance the oscillator to the next sample
+     *
+     * @return e^{j*phase} of the current sample
+     */
+    std::complex<double> next()
+    {
+        std::complex<double> current = m_phasor;
+        m_phaseAccumulator += m_phaseIncrement;
+        if (++m_samplesSinceRenormalize < OSCILLATOR_RENORMALIZE_INTERVAL)
+        {
+            m_phasor = multiply(m_phasor, m_rotation);
+        }
+        else
+        {
+            renormalize();
+        }
+        return current;
+    }
+
+    /**
+     * @brief Get the rotation applied to the phasor for every sample
+     *
+     * @return e^{j*2*pi*f/fs}
+     */
+    const std::complex<double> &getRotation() const
+    {
+        return m_rotation;
+    }
+
+    /**
+     * @brief Get the exact phase of the current sample from the phase accumulator
+     *
+     * @return phase angle in radian, in range [0, 2*pi) plus the initial phase
+     */
+    double getPhase() const;
+
+    /**
+     * @brief Get the phase error between the rotated phasor and the phase accumulator
+     *
+     * @return absolute phase error of the current sample in radian
+     */
+    double getPhaseError() const;
+
+private:
+    /// @brief Phase of the current sample, in units of 2*pi / 2^64
+    uint64_t m_phaseAccumulator;
+
+    /// @brief Phase step per sample, in units of 2*pi / 2^64
+    uint64_t m_phaseIncrement;
+
+    /// @brief Phase angle in radian added to the accumulator phase
+    double m_initialPhase;
+
+    /// @brief The initial phase in accumulator units, added to the accumulator when the phasor is read from the sine table
+    uint64_t m_phaseOffset;
+
+    /// @brief How the phasor is re-anchored to the phase accumulator
+    TrigMode m_trigMode;
+
+    /// @brief The amount of samples generated by rotation since the last re-anchoring
+    unsigned int m_samplesSinceRenormalize;
+
+    /// @brief e^{j*phase} of the current sample
+    std::complex<double> m_phasor;
+
+    /// @brief e^{j*2*pi*f/fs}, the rotation applied to the phasor for every sample
+    std::complex<double> m_rotation;
+
+    /**
+     * @brief Re-anchor the phasor to the phase of the phase accumulator, exactly or from the sine table
+     */
+    void renormalize();
+
+    /**
+     * @brief Multiply two complex numbers without the NaN/Inf checks of std::complex operator*
+     *
+     * @param p_lhs - left operand
+     * @param p_rhs - right operand
+     *
+     * @return product of the operands
+     */
+    static std::complex<double> multiply(const std::complex<double> &p_lhs, const std::complex<double> &p_rhs)
+    {
+        return {p_lhs.real() * p_rhs.real() - p_lhs.imag() * p_rhs.imag(),
+                p_lhs.real() * p_rhs.imag() + p_lhs.imag() * p_rhs.real()};
+    }
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include <functional>
+#include <vector>
+
+/// @brief The thread count key, 0 uses every hardware thread
+constexpr const char *THREAD_COUNT_KEY = "/threads";
+
+/// @brief The fewest samples a thread is given, shorter signals are processed serially
+constexpr size_t PARALLEL_MIN_SAMPLES = 1 << 16;
+
+/// @brief A contiguous run of symbols processed by one thread
+struct SymbolRange
+{
+    /// @brief The first symbol of the range
+    size_t first;
+
+    /// @brief The symbol after the last one of the range
+    size_t last;
+};
+
+/**
+ * @brief Get the amount of threads to run on
+ *
+ * @param p_threadCount - the configured thread count, 0 for every hardware thread
+ *
+ * @return at least 1
+ */
+unsigned int resolveThreadCount(const unsigned int p_threadCount);
+
+/**
+ * @brief Split symbols into contiguous ranges of about the same size, one per thread, every range gets at least
+ * PARALLEL_MIN_SAMPLES samples
+ *
+ * @param p_symbolCount - the amount of symbols
+ * @param p_samplesPerSymbol - the amount of samples of one symbol
+ * @param p_threadCount - the amount of threads, resolved
+ *
+ * @return the ranges in order, a single range when the signal is too short to be worth splitting
+ */
+std::vector<SymbolRange> splitSymbolRanges(const size_t p_symbolCount, const size_t p_samplesPerSymbol,
+                                           const unsigned int p_threadCount);
+
+/**
+ * @brief Run tasks concurrently, task 0 runs on the calling thread and every other one on its own thread
+ *
+ * The first exception thrown by a task is rethrown once every task has finished.
+ *
+ * @param p_taskCount - the amount of tasks
+ * @param p_task - called once with every task index
+ */
+void runParallel(const size_t p_taskCount, const std::function<void(size_t)> &p_task);
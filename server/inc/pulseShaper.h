@@ -0,0 +1,219 @@
+#pragma once
+#include <complex>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+/// @brief The pulse shape key: "rectangular", "rrc" (root raised cosine) or "gaussian"
+constexpr const char *PULSE_SHAPE_KEY = "/pulseShape";
+
+/// @brief The roll-off factor key of the root raised cosine pulse
+constexpr const char *PULSE_ROLLOFF_KEY = "/pulseShape/rolloff";
+
+/// @brief The bandwidth-time product key of the Gaussian pulse
+constexpr const char *PULSE_BANDWIDTH_TIME_KEY = "/pulseShape/bt";
+
+/// @brief The pulse length key, in symbols
+constexpr const char *PULSE_SPAN_KEY = "/pulseShape/span";
+
+/// @brief The roll-off factor of the root raised cosine pulse when the database has no setting
+constexpr double DEFAULT_PULSE_ROLLOFF = 0.35;
+
+/// @brief The bandwidth-time product of the Gaussian pulse when the database has no setting
+constexpr double DEFAULT_PULSE_BANDWIDTH_TIME = 0.5;
+
+/// @brief The pulse length in symbols when the database has no setting, always rounded up to an even number
+constexpr unsigned int DEFAULT_PULSE_SPAN = 8;
+
+/// @brief The maximum amount of filters kept in the cache before it is cleared
+constexpr size_t PULSE_FILTER_CACHE_MAX_ENTRIES = 16;
+
+/// @brief The pulses a symbol can be shaped with
+enum class PulseShape
+{
+    RECTANGULAR,
+    ROOT_RAISED_COSINE,
+    GAUSSIAN
+};
+
+/// @brief The pulse shaping settings read from the server database
+struct PulseShapingParameters
+{
+    /// @brief The pulse shape, RECTANGULAR keeps the symbols unfiltered
+    PulseShape shape;
+
+    /// @brief The roll-off factor (root raised cosine) or the bandwidth-time product (Gaussian)
+    double factor;
+
+    /// @brief The pulse length in symbols, an even number
+    unsigned int span;
+};
+
+/**
+ * @brief Get the two-sided bandwidth a pulse occupies
+ *
+ * @param p_parameters - the pulse shape, its roll-off or BT and its span
+ *
+ * @return the bandwidth in multiples of the symbol rate: 1 + rolloff for a root raised cosine pulse,
+ * 6 * BT (27 dB down) for a Gaussian pulse, 0 for a rectangular pulse
+ */
+inline double getPulseBandwidth(const PulseShapingParameters &p_parameters)
+{
+    switch (p_parameters.shape)
+    {
+    case PulseShape::ROOT_RAISED_COSINE:
+        return 1 + p_parameters.factor;
+    case PulseShape::GAUSSIAN:
+        return 6 * p_parameters.factor;
+    default:
+        return 0;
+    }
+}
+
+/// @brief The precomputed taps of a pulse at one oversampling
+struct PulseFilter
+{
+    /// @brief The amount of samples of one symbol
+    unsigned int samplesPerSymbol;
+
+    /// @brief The pulse length in symbols
+    unsigned int span;
+
+    /// @brief span * samplesPerSymbol taps, the pulse peak is at tap span / 2 * samplesPerSymbol.
+    /// The taps are scaled so the sum of their squares is samplesPerSymbol, a matched filter then returns the symbol
+    std::vector<double> taps;
+
+    /// @brief The polyphase branches of the interpolator: branch p holds taps p, p + samplesPerSymbol, ...
+    /// in reverse order, so it is applied to span consecutive symbols with one inner product
+    std::vector<std::vector<double>> branches;
+};
+
+/**
+ * @brief Process-wide cache of pulse filters keyed by (shape, roll-off or BT, span, oversampling)
+ *
+ * Filters are immutable once built, readers keep them alive through shared pointers even if the cache
+ * is cleared in the meantime.
+ */
+class PulseFilterCache
+{
+public:
+    /**
+     * @brief The function that allows retrieving the cache singleton object
+     */
+    static PulseFilterCache &getInstance();
+
+    /**
+     * @brief Get the filter of a pulse, building it on the first request
+     *
+     * @param p_parameters - the pulse shape, its roll-off or BT and its span
+     * @param p_samplesPerSymbol - the amount of samples of one symbol
+     *
+     * @return the filter, nullptr for RECTANGULAR pulses
+     */
+    std::shared_ptr<const PulseFilter> getFilter(const PulseShapingParameters &p_parameters, unsigned int p_samplesPerSymbol);
+
+private:
+    /// @brief Protects m_filters, the cache is shared by every request
+    std::mutex m_mutex;
+
+    /// @brief The cached filters
+    std::map<std::tuple<PulseShape, double, unsigned int, unsigned int>, std::shared_ptr<const PulseFilter>> m_filters;
+
+    PulseFilterCache() = default;
+    PulseFilterCache(const PulseFilterCache &) = delete;
+    PulseFilterCache &operator=(const PulseFilterCache &) = delete;
+
+    /**
+     * @brief Sample the pulse and split it into polyphase branches
+     *
+     * @return the new filter
+     */
+    static std::shared_ptr<const PulseFilter> buildFilter(const PulseShapingParameters &p_parameters, unsigned int p_samplesPerSymbol);
+
+    /**
+     * @brief Evaluate the root raised cosine pulse
+     *
+     * @param p_time - the time from the pulse peak, in symbols
+     * @param p_rolloff - the roll-off factor, in range [0, 1]
+     *
+     * @return the pulse value, 1 + rolloff * (4 / pi - 1) at the peak
+     */
+    static double getRootRaisedCosine(double p_time, double p_rolloff);
+};
+
+/**
+ * @brief Polyphase pulse shaping interpolator and matched filter of complex symbols
+ *
+ * The interpolator never inserts zeros between the symbols: output sample p of a symbol is the inner
+ * product of polyphase branch p with the span symbols around it, so a symbol costs samplesPerSymbol * span
+ * multiply-adds instead of samplesPerSymbol^2 * span. The matched filter only evaluates the symbol instants.
+ * Pulse tails wrap around the message (tail biting), so a message keeps exactly samplesPerSymbol samples per
+ * symbol and its first and last symbols are received without truncation ISI.
+ */
+class PulseShaper
+{
+public:
+    /// @brief Default constructor, a rectangular pulse that shapes nothing
+    PulseShaper();
+
+    /**
+     * @brief Customize Constructor to shape symbols with a cached filter
+     *
+     * @param p_filter - the filter, nullptr for a rectangular pulse
+     */
+    explicit PulseShaper(std::shared_ptr<const PulseFilter> p_filter);
+
+    /**
+     * @brief Check whether a filter is set
+     *
+     * @return true - symbols are shaped, false - the pulse is rectangular
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Get the amount of symbols one output symbol depends on
+     *
+     * @return the pulse span
+     */
+    unsigned int getSpan() const;
+
+    /**
+     * @brief Get the offset of the first symbol of the window of a symbol
+     *
+     * @return the index of the first window symbol minus the index of the shaped symbol, a negative number
+     */
+    int getWindowOffset() const;
+
+    /**
+     * @brief Generate the samples of one symbol from the symbols around it
+     *
+     * @param p_windowI - the I of getSpan() consecutive symbols, starting getWindowOffset() symbols away
+     * @param p_windowQ - the Q of the same symbols
+     * @param p_envelope - output buffer of samplesPerSymbol complex samples
+     */
+    void shapeSymbol(const double *p_windowI, const double *p_windowQ, std::complex<double> *p_envelope) const;
+
+    /**
+     * @brief Shape a whole message
+     *
+     * @param p_points - one complex point per symbol
+     *
+     * @return samplesPerSymbol complex samples per symbol
+     */
+    std::vector<std::complex<double>> shape(const std::vector<std::complex<double>> &p_points) const;
+
+    /**
+     * @brief Apply the matched filter to a whole message and sample it at the symbol instants
+     *
+     * @param p_signal - samplesPerSymbol complex samples per symbol, a trailing partial symbol is dropped
+     *
+     * @return one complex point per symbol, equal to the transmitted point on a clean channel
+     */
+    std::vector<std::complex<double>> match(const std::vector<std::complex<double>> &p_signal) const;
+
+private:
+    /// @brief The cached filter, nullptr for a rectangular pulse
+    std::shared_ptr<const PulseFilter> m_filter;
+};
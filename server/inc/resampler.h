@@ -0,0 +1,91 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+/// @brief The amount of input samples the cubic interpolator reads around every output sample
+constexpr size_t RESAMPLER_TAPS = 4;
+
+/**
+ * @brief Streaming sample rate converter with an arbitrary (fractional) rate ratio
+ *
+ * Every output sample is a cubic Lagrange interpolation of the 4 input samples around it, evaluated with
+ * the Farrow structure: the 4 polynomial coefficients only depend on the input samples and are mixed with
+ * the fractional position mu by Horner's rule, so a new ratio needs no new filter table. Input can be pushed
+ * in chunks of any size, the output is the same as resampling the whole signal at once.
+ */
+class FarrowResampler
+{
+public:
+    /**
+     * @brief Customize Constructor to set up the conversion ratio
+     *
+     * @param p_inputRate - the sample rate of the input signal
+     * @param p_outputRate - the sample rate of the output signal
+     */
+    FarrowResampler(const double p_inputRate, const double p_outputRate);
+
+    /**
+     * @brief Check whether the rates are equal, in which case samples are passed through unchanged
+     *
+     * @return true - input and output rates are equal, false - otherwise
+     */
+    bool isPassThrough() const;
+
+    /**
+     * @brief Resample the next input samples, resuming where the previous call stopped
+     *
+     * @param p_input - the next input samples
+     * @param p_count - the amount of input samples
+     * @param p_output - the output samples whose input neighbourhood is complete are appended to it
+     */
+    void process(const double *p_input, const size_t p_count, std::vector<double> &p_output);
+
+    /**
+     * @brief Emit the remaining output samples at the end of the signal, the last input sample is held
+     *
+     * @param p_output - the remaining output samples are appended to it
+     */
+    void flush(std::vector<double> &p_output);
+
+    /**
+     * @brief Resample a whole signal
+     *
+     * @param p_input - the input signal
+     *
+     * @return the output signal, round(input size * output rate / input rate) samples
+     */
+    std::vector<double> resample(const std::vector<double> &p_input);
+
+private:
+    /// @brief The distance between two output samples, in input samples
+    double m_step;
+
+    /// @brief The amount of input samples pushed so far
+    size_t m_inputCount;
+
+    /// @brief The amount of output samples emitted so far
+    size_t m_outputCount;
+
+    /// @brief The amount of output samples the whole signal is resampled into, known once the input ends
+    size_t m_outputTotal;
+
+    /// @brief The last RESAMPLER_TAPS input samples, the newest one last
+    double m_history[RESAMPLER_TAPS];
+
+    /**
+     * @brief Push one input sample into the history and emit every output sample it completes
+     *
+     * @param p_sample - the input sample
+     * @param p_output - the output samples are appended to it
+     */
+    void push(const double p_sample, std::vector<double> &p_output);
+
+    /**
+     * @brief Interpolate between the 2 middle samples of the history
+     *
+     * @param p_mu - the fractional position after the second history sample, in range [0, 1)
+     *
+     * @return the interpolated sample
+     */
+    double interpolate(const double p_mu) const;
+};
@@ -0,0 +1,114 @@
+#pragma once
+#include <vector>
+#include "bitBuffer.h"
+
+/// @brief The resource elements of the smallest allocation, one resource block (12 subcarriers) on one OFDM symbol
+constexpr unsigned int RESOURCE_ELEMENT_GROUP_SIZE = 12;
+
+/// @brief The amount of OFDM symbols of one slot
+constexpr unsigned int SLOT_SYMBOLS = 14;
+
+/// @brief The value of a resource element no client is allocated to, the subcarrier stays null
+constexpr int NULL_RESOURCE_ELEMENT = -1;
+
+/// @brief The resource elements given to one client in a slot
+struct GridAllocation
+{
+    /// @brief The client socket the payload came from
+    int owner;
+
+    /// @brief The index of the first resource element, counted subcarrier first then OFDM symbol
+    size_t firstElement;
+
+    /// @brief The amount of constellation points of the payload, one per resource element
+    size_t pointCount;
+};
+
+/**
+ * @brief Time/frequency resource grid of one downlink slot, shared by the payloads of many clients
+ *
+ * Resource elements are numbered subcarrier first, element e is subcarrier e % subcarriers of OFDM symbol
+ * e / subcarriers. Every client gets a contiguous run of elements starting on a resource element group
+ * boundary, so two clients never share a resource block on one OFDM symbol. The elements between the runs
+ * stay null.
+ */
+class ResourceGrid
+{
+public:
+    /**
+     * @brief Customize Constructor to start an empty slot
+     *
+     * @param p_subcarriers - the amount of OFDM subcarriers
+     * @param p_bitsPerPoint - the amount of bits carried by one constellation point
+     */
+    ResourceGrid(const unsigned int p_subcarriers, const unsigned int p_bitsPerPoint);
+
+    /**
+     * @brief Give a payload the next free resource elements of the slot
+     *
+     * @param p_owner - the client socket the payload came from
+     * @param p_binaryData - a binary data series, a multiple of the bits per point
+     *
+     * @return true - the payload is mapped, false - the rest of the slot is too small, the grid is left unchanged
+     */
+    bool allocate(const int p_owner, const BitBuffer &p_binaryData);
+
+    /**
+     * @brief Check whether no payload is mapped yet
+     *
+     * @return true - the slot is empty, false - otherwise
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Get the amount of OFDM subcarriers
+     *
+     * @return the amount of OFDM subcarriers
+     */
+    unsigned int getSubcarriers() const;
+
+    /**
+     * @brief Get the amount of bits carried by one constellation point
+     *
+     * @return the amount of bits carried by one constellation point
+     */
+    unsigned int getBitsPerPoint() const;
+
+    /**
+     * @brief Get the amount of resource elements of a whole slot
+     *
+     * @return SLOT_SYMBOLS * subcarriers
+     */
+    size_t getCapacity() const;
+
+    /**
+     * @brief Get the payloads mapped so far, in allocation order
+     *
+     * @return the allocations
+     */
+    const std::vector<GridAllocation> &getAllocations() const;
+
+    /**
+     * @brief Get the symbol value of every resource element up to the last OFDM symbol in use, the trailing
+     * empty OFDM symbols of the slot are not sent
+     *
+     * @return a whole number of OFDM symbols of values, NULL_RESOURCE_ELEMENT for unused elements
+     */
+    const std::vector<int> &getElements() const;
+
+private:
+    /// @brief The amount of OFDM subcarriers
+    unsigned int m_subcarriers;
+
+    /// @brief The amount of bits carried by one constellation point
+    unsigned int m_bitsPerPoint;
+
+    /// @brief The first resource element no payload can use anymore
+    size_t m_nextElement;
+
+    /// @brief The payloads mapped so far
+    std::vector<GridAllocation> m_allocations;
+
+    /// @brief The symbol value of every resource element of the OFDM symbols in use
+    std::vector<int> m_elements;
+};
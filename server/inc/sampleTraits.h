@@ -0,0 +1,131 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+/// @brief The int16 value of one unit of carrier amplitude, leaves headroom for 16-QAM peaks and noise
+constexpr double INT16_SAMPLE_SCALE = 8192.0;
+
+/// @brief The value of 1.0 in Q15, tables of values in [-1, 1] are stored as Q15 int16
+constexpr double Q15_SCALE = 32768.0;
+
+/// @brief Half a Q15 step, added before a Q30 product is shifted back to Q15 so it is rounded to nearest
+constexpr int32_t Q15_ROUNDING = 1 << 14;
+
+/// @brief The sample type key
+constexpr const char *SAMPLE_TYPE_KEY = "/sampleType";
+
+/// @brief The fixed-point carriers key: the networks whose modulator and demodulator run in integer arithmetic,
+/// separated by commas or spaces
+constexpr const char *FIXED_POINT_CARRIERS_KEY = "/fixedPointCarriers";
+
+/// @brief The sample types the modulation, noise and demodulation pipeline can run at
+enum class SampleType
+{
+    DOUBLE,
+    FLOAT32,
+    INT16
+};
+
+/// @brief The arithmetic the int16 sample path computes in
+enum class Arithmetic
+{
+    /// @brief Samples are generated and correlated in single precision and quantized to int16
+    FLOATING_POINT,
+
+    /// @brief Samples are mixed from Q15 tables and correlated with 64-bit integer accumulators, bit-exact
+    /// whatever the instruction set the kernels run on
+    FIXED_POINT
+};
+
+/**
+ * @brief Quantize a value in [-1, 1] to Q15, rounded to nearest
+ *
+ * @param p_value - the value
+ *
+ * @return the Q15 value, saturated to +-INT16_MAX so the sum of two of its products with any int16 fits in 32 bits
+ */
+inline int16_t toQ15(const double p_value)
+{
+    long scaled = std::lrint(p_value * Q15_SCALE);
+    return static_cast<int16_t>(std::clamp(scaled, -static_cast<long>(INT16_MAX), static_cast<long>(INT16_MAX)));
+}
+
+/**
+ * @brief Parse a sample type name as written in the server database
+ *
+ * @param p_name - "double", "float" or "int16"
+ *
+ * @return the sample type, double when the name is unknown
+ */
+inline SampleType parseSampleType(const std::string &p_name)
+{
+    if (p_name == "float")
+    {
+        return SampleType::FLOAT32;
+    }
+    if (p_name == "int16")
+    {
+        return SampleType::INT16;
+    }
+    return SampleType::DOUBLE;
+}
+
+/**
+ * @brief Conversion between the physical signal value (carrier amplitude 1.0) and a stored sample type
+ *
+ * ComputeType is the floating point type samples are generated in before they are stored.
+ */
+template <typename T>
+struct SampleTraits;
+
+template <>
+struct SampleTraits<double>
+{
+    using ComputeType = double;
+
+    static double fromDouble(const double p_value)
+    {
+        return p_value;
+    }
+
+    static double toDouble(const double p_sample)
+    {
+        return p_sample;
+    }
+};
+
+template <>
+struct SampleTraits<float>
+{
+    using ComputeType = float;
+
+    static float fromDouble(const double p_value)
+    {
+        return static_cast<float>(p_value);
+    }
+
+    static double toDouble(const float p_sample)
+    {
+        return p_sample;
+    }
+};
+
+template <>
+struct SampleTraits<int16_t>
+{
+    using ComputeType = float;
+
+    static int16_t fromDouble(const double p_value)
+    {
+        // Saturate instead of wrapping around when noise pushes a peak out of range
+        long scaled = std::lrint(p_value * INT16_SAMPLE_SCALE);
+        return static_cast<int16_t>(std::clamp(scaled, static_cast<long>(INT16_MIN), static_cast<long>(INT16_MAX)));
+    }
+
+    static double toDouble(const int16_t p_sample)
+    {
+        return p_sample / INT16_SAMPLE_SCALE;
+    }
+};
@@ -34,9 +34,49 @@ constexpr const char *LOG_FILE_PATH = "server.log";
 /// @brief The database file path of server
 constexpr const char *INITIAL_DATABASE_PATH = "./db";
 
+/// @brief The downlink mode key: "burst" (every DL command is a waveform of its own) or "continuous"
+/// (every DL command continues the waveform of the carrier)
+constexpr const char *DOWNLINK_MODE_KEY = "/downlinkMode";
+
 /// @brief Initialize logger of server side
 void initLogger();
 
+/// @brief How consecutive DL commands are transmitted
+enum class DownlinkMode
+{
+    BURST,
+    CONTINUOUS
+};
+
+/// @brief A downlink payload waiting for the next slot
+struct PendingDownlink
+{
+    /// @brief The client socket the payload came from
+    int clientSocket;
+
+    /// @brief A binary data series
+    BitBuffer binaryData;
+};
+
+/// @brief The downlink waveform every DL command of the carrier continues in continuous mode
+struct ContinuousDownlink
+{
+    /// @brief The modulation scheme the waveform was started with
+    ModulationScheme scheme;
+
+    /// @brief The carrier frequency the waveform was started with
+    size_t frequency;
+
+    /// @brief The modulation session, its oscillators stopped after the last payload
+    ModulationSession session;
+
+    /// @brief The output resampler, its history carries over from one payload to the next
+    FarrowResampler resampler;
+
+    /// @brief The size of the input file before the tail of the waveform, the next payload is written over the tail
+    uintmax_t tailOffset;
+};
+
 class Server
 {
 public:
@@ -74,6 +114,12 @@ private:
     std::unique_ptr<Modulator> m_modulator;
     std::unique_ptr<Antenna> m_antenna;
 
+    /// @brief The downlink payloads received since the last slot, only used when they share a resource grid
+    std::vector<PendingDownlink> m_pendingDownlinks;
+
+    /// @brief The waveform of the carrier in continuous downlink mode, nullptr until the first DL command
+    std::unique_ptr<ContinuousDownlink> m_continuousDownlink;
+
     /**
      * @brief Initialize database of server side
      */
@@ -117,9 +163,78 @@ private:
      * @brief Handle commands from client sent to server.
      *
      * @param p_buffer - message from client
+     * @param p_clientSocket - the client socket the message came from
      * @return message containing database results sent to client.
      */
-    std::string handleClientCommand(const char *p_buffer);
+    std::string handleClientCommand(const char *p_buffer, const int &p_clientSocket);
+
+    /**
+     * @brief Send the pending downlink payloads, as many clients as fit share the resource grid of one slot
+     */
+    void scheduleDownlinks();
+
+    /**
+     * @brief Modulate the resource grid of one slot in one pass, then demodulate it and check the payload of every client
+     *
+     * @tparam T - the sample type the signal is simulated at
+     * @param p_grid - the resource grid of the slot
+     * @param p_firstDownlink - the index of the pending downlink of the first allocation of the grid
+     */
+    template <typename T>
+    void transmitSlot(const ResourceGrid &p_grid, const size_t p_firstDownlink);
+
+    /**
+     * @brief Append downlink payloads to the continuous waveform of the carrier, the waveform is started over
+     * when the carrier changed since the last DL command, otherwise no modulation setup is run again
+     *
+     * @tparam T - the sample type the signal is simulated at
+     * @param p_payloads - the binary data series, each a whole number of symbols
+     */
+    template <typename T>
+    void continueDownlink(const std::vector<BitBuffer> &p_payloads);
+
+    /**
+     * @brief Modulate several downlink payloads in one batch, their waveforms are saved back to back
+     *
+     * @tparam T - the sample type the signal is simulated at
+     * @param p_payloads - the binary data series, each a whole number of symbols
+     */
+    template <typename T>
+    void transmitBatch(const std::vector<BitBuffer> &p_payloads);
+
+    /**
+     * @brief Modulate the binary input of the modulator, pass it through the noisy channel and demodulate it
+     *
+     * @tparam T - the sample type the signal is simulated at
+     * @return the demodulated binary data series
+     */
+    template <typename T>
+    BitBuffer receiveUplink();
+
+    /**
+     * @brief Receive the binary input of the modulator through the fused link: modulation, channel noise, export
+     * and demodulation run tile by tile, the whole signal is never held in memory
+     *
+     * @tparam T - the sample type the signal is simulated at
+     * @return the demodulated binary data series
+     */
+    template <typename T>
+    BitBuffer receiveTiledUplink();
+
+    /**
+     * @brief Modulate the binary input of the modulator as complex baseband samples, pass it through the noisy
+     * channel and demodulate it, the signal is only mixed up to the carrier for the plot
+     *
+     * @return the demodulated binary data series
+     */
+    BitBuffer receiveBasebandUplink();
+
+    /**
+     * @brief Get the sample type the signals of the carrier are simulated at
+     *
+     * @return int16 for a fixed-point carrier, the /sampleType setting otherwise
+     */
+    SampleType getCarrierSampleType();
 
     /**
      * @brief Set up carrier for server
@@ -0,0 +1,520 @@
+#pragma once
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+/// @brief The instruction sets the modulation kernels can be compiled for, ordered by vector width
+enum class SimdLevel
+{
+    SCALAR,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+/// @brief The amount of samples generated by the start-up self check of every vector kernel
+constexpr size_t SIMD_SELF_CHECK_SAMPLES = 1000;
+
+/// @brief The symbol length of the self check of the symbol kernels, not a multiple of any vector width
+constexpr size_t SIMD_SELF_CHECK_SYMBOL_LENGTH = 37;
+
+/// @brief The maximum difference allowed between a vector kernel and the scalar reference kernel
+constexpr double SIMD_KERNEL_TOLERANCE = 1e-9;
+
+/// @brief The maximum difference allowed between a single precision vector kernel and its scalar reference
+constexpr float SIMD_FLOAT_KERNEL_TOLERANCE = 1e-5f;
+
+/**
+ * @brief Kernel generating p_count samples of p_inPhaseGain * Re(z) + p_quadratureGain * Im(z),
+ * where z starts at p_carrier and is rotated by p_rotation for every sample
+ *
+ * ASK, PSK, FSK and 16-QAM symbols are all linear combinations of the in-phase and quadrature carrier,
+ * so this single kernel generates every scheme, only the gains and the carrier oscillator differ.
+ */
+using SynthesizeKernel = void (*)(double *p_signal, size_t p_count, const std::complex<double> &p_carrier,
+                                  const std::complex<double> &p_rotation, double p_inPhaseGain, double p_quadratureGain);
+
+/**
+ * @brief Kernel generating p_count samples of p_inPhaseGain * p_inPhase[n] + p_quadratureGain * p_quadrature[n]
+ *
+ * Used to stitch a symbol out of the precomputed cosine/sine basis of its tone.
+ */
+using CombineKernel = void (*)(double *p_signal, size_t p_count, const double *p_inPhase, const double *p_quadrature,
+                               double p_inPhaseGain, double p_quadratureGain);
+
+/// @brief Single precision CombineKernel, twice as many samples fit in a vector
+using CombineFloatKernel = void (*)(float *p_signal, size_t p_count, const float *p_inPhase, const float *p_quadrature,
+                                    float p_inPhaseGain, float p_quadratureGain);
+
+/**
+ * @brief Fixed-point CombineKernel: sample n is saturate((p_inPhaseGain * p_inPhase[n] + p_quadratureGain * p_quadrature[n]
+ * + Q15_ROUNDING) >> 15), the basis is Q15 and the samples come out in the scale of the gains
+ *
+ * Integer kernels are exact, every instruction set produces the same samples as the scalar kernel.
+ */
+using CombineQ15Kernel = void (*)(int16_t *p_signal, size_t p_count, const int16_t *p_inPhase, const int16_t *p_quadrature,
+                                  int16_t p_inPhaseGain, int16_t p_quadratureGain);
+
+/**
+ * @brief Kernel validating an ASCII binary series and packing it in the same pass, character n becomes bit 63 - n % 64
+ * of word n / 64 and the unused low bits of the last word are 0
+ *
+ * @return true - every character is '0' or '1', false - otherwise, the words are then undefined
+ */
+using PackBitsKernel = bool (*)(const char *p_ascii, size_t p_count, uint64_t *p_words);
+
+/**
+ * @brief Kernel returning the inner product of two vectors of p_count samples
+ *
+ * Used by the polyphase pulse shaping interpolator and the matched filter.
+ */
+using DotKernel = double (*)(const double *p_first, const double *p_second, size_t p_count);
+
+/**
+ * @brief Kernel correlating p_symbolCount consecutive symbols of p_symbolLength samples against the same cosine and
+ * sine basis, every sample is loaded once for both sums
+ *
+ * The templates of a scheme start every symbol at phase 0, so all the symbols of a tile are correlated in one call
+ * and only the rotation to the reference phase is left per symbol.
+ */
+using CorrelateKernel = void (*)(const double *p_signal, size_t p_symbolLength, size_t p_symbolCount, const double *p_inPhase,
+                                 const double *p_quadrature, double *p_inPhaseSums, double *p_quadratureSums);
+
+/// @brief Single precision CorrelateKernel, the sums of a symbol are accumulated in float
+using CorrelateFloatKernel = void (*)(const float *p_signal, size_t p_symbolLength, size_t p_symbolCount, const float *p_inPhase,
+                                      const float *p_quadrature, double *p_inPhaseSums, double *p_quadratureSums);
+
+/**
+ * @brief Fixed-point CorrelateKernel: the Q30 products are summed in 64-bit accumulators, a symbol-long correlation
+ * would overflow a 32-bit Q31 accumulator after a few thousand samples, the integer sums are exact in the doubles
+ */
+using CorrelateQ15Kernel = void (*)(const int16_t *p_signal, size_t p_symbolLength, size_t p_symbolCount, const int16_t *p_inPhase,
+                                    const int16_t *p_quadrature, double *p_inPhaseSums, double *p_quadratureSums);
+
+/// @brief Kernel summing the magnitude of the samples of p_symbolCount consecutive symbols, the ASK envelope detector
+using EnvelopeKernel = void (*)(const double *p_signal, size_t p_symbolLength, size_t p_symbolCount, double *p_sums);
+
+/// @brief Single precision EnvelopeKernel
+using EnvelopeFloatKernel = void (*)(const float *p_signal, size_t p_symbolLength, size_t p_symbolCount, double *p_sums);
+
+/// @brief Fixed-point EnvelopeKernel, exact, the sums are in sample steps
+using EnvelopeQ15Kernel = void (*)(const int16_t *p_signal, size_t p_symbolLength, size_t p_symbolCount, double *p_sums);
+
+/**
+ * @brief Kernel running a Goertzel filter per tone over p_symbolCount consecutive symbols of p_symbolLength samples:
+ * s[n] = x[n] + c * s[n - 1] - s[n - 2] with c = 2 * cos(w), the power of tone t in symbol i,
+ * |sum x[n] * e^{-jwn}|^2 = s[N - 1]^2 + s[N - 2]^2 - c * s[N - 1] * s[N - 2], is written to p_powers[i * p_toneCount + t]
+ *
+ * One multiply per sample and tone and no reference table, an M-ary tone bank costs M recurrences. The recurrence
+ * is serial, so the vector kernels split every symbol into one polyphase branch per lane, whatever the amount of
+ * symbols of a call.
+ */
+using GoertzelKernel = void (*)(const double *p_signal, size_t p_symbolLength, size_t p_symbolCount, const double *p_frequencies,
+                                size_t p_toneCount, double *p_powers);
+
+/**
+ * @brief Kernel sliding a complex reference r over a complex signal x given as split I/Q rows: output n is
+ * sum x[n + k] * conj(r[k]) over p_tapCount taps, its real part is written to p_sumsI[n] and its imaginary part to
+ * p_sumsQ[n], the signal rows hold p_outputCount + p_tapCount - 1 samples
+ *
+ * The vector kernels keep consecutive outputs in their lanes and broadcast one tap at a time.
+ */
+using SlideKernel = void (*)(const double *p_signalI, const double *p_signalQ, size_t p_outputCount, const double *p_referenceI,
+                             const double *p_referenceQ, size_t p_tapCount, double *p_sumsI, double *p_sumsQ);
+
+class SimdKernels
+{
+public:
+    /**
+     * @brief The function that allows retrieving the kernel table, the widest instruction set supported
+     * by the CPU is detected on the first call
+     */
+    static const SimdKernels &getInstance();
+
+    /**
+     * @brief Get the instruction set the kernels were selected for
+     *
+     * @return the selected instruction set
+     */
+    SimdLevel getLevel() const;
+
+    /**
+     * @brief Get the name of the instruction set the kernels were selected for
+     *
+     * @return a printable name of the selected instruction set
+     */
+    const char *getLevelName() const;
+
+    /**
+     * @brief Generate carrier samples with the selected kernel, see SynthesizeKernel
+     *
+     * @param p_signal - output buffer of at least p_count samples
+     * @param p_count - the amount of samples to generate
+     * @param p_carrier - the carrier phasor of the first sample
+     * @param p_rotation - the phasor rotation applied for every sample
+     * @param p_inPhaseGain - the gain of the in-phase (cosine) component
+     * @param p_quadratureGain - the gain of the quadrature (sine) component
+     */
+    void synthesize(double *p_signal, size_t p_count, const std::complex<double> &p_carrier,
+                    const std::complex<double> &p_rotation, double p_inPhaseGain, double p_quadratureGain) const
+    {
+        m_synthesize(p_signal, p_count, p_carrier, p_rotation, p_inPhaseGain, p_quadratureGain);
+    }
+
+    /**
+     * @brief Mix two basis waveforms with the selected kernel, see CombineKernel
+     *
+     * @param p_signal - output buffer of at least p_count samples
+     * @param p_count - the amount of samples to generate
+     * @param p_inPhase - the in-phase (cosine) basis waveform
+     * @param p_quadrature - the quadrature (sine) basis waveform
+     * @param p_inPhaseGain - the gain of the in-phase basis
+     * @param p_quadratureGain - the gain of the quadrature basis
+     */
+    void combine(double *p_signal, size_t p_count, const double *p_inPhase, const double *p_quadrature,
+                 double p_inPhaseGain, double p_quadratureGain) const
+    {
+        m_combine(p_signal, p_count, p_inPhase, p_quadrature, p_inPhaseGain, p_quadratureGain);
+    }
+
+    /**
+     * @brief Mix two single precision basis waveforms with the selected kernel, see CombineFloatKernel
+     */
+    void combine(float *p_signal, size_t p_count, const float *p_inPhase, const float *p_quadrature,
+                 float p_inPhaseGain, float p_quadratureGain) const
+    {
+        m_combineFloat(p_signal, p_count, p_inPhase, p_quadrature, p_inPhaseGain, p_quadratureGain);
+    }
+
+    /**
+     * @brief Mix two Q15 basis waveforms with the selected kernel, see CombineQ15Kernel
+     */
+    void combine(int16_t *p_signal, size_t p_count, const int16_t *p_inPhase, const int16_t *p_quadrature,
+                 int16_t p_inPhaseGain, int16_t p_quadratureGain) const
+    {
+        m_combineQ15(p_signal, p_count, p_inPhase, p_quadrature, p_inPhaseGain, p_quadratureGain);
+    }
+
+    /**
+     * @brief Compute an inner product with the selected kernel, see DotKernel
+     *
+     * @param p_first - the first vector, e.g. the filter taps
+     * @param p_second - the second vector, e.g. the filtered samples
+     * @param p_count - the amount of samples of both vectors
+     *
+     * @return the sum of p_first[n] * p_second[n]
+     */
+    double dot(const double *p_first, const double *p_second, size_t p_count) const
+    {
+        return m_dot(p_first, p_second, p_count);
+    }
+
+    /**
+     * @brief Correlate consecutive symbols against a tone basis with the selected kernel, see CorrelateKernel
+     *
+     * @param p_signal - the samples of the symbols
+     * @param p_symbolLength - the amount of samples of every symbol
+     * @param p_symbolCount - the amount of symbols
+     * @param p_inPhase - the cosine basis, p_symbolLength samples
+     * @param p_quadrature - the sine basis, p_symbolLength samples
+     * @param p_inPhaseSums - the sum of x * cos of every symbol
+     * @param p_quadratureSums - the sum of x * sin of every symbol
+     */
+    void correlate(const double *p_signal, size_t p_symbolLength, size_t p_symbolCount, const double *p_inPhase,
+                   const double *p_quadrature, double *p_inPhaseSums, double *p_quadratureSums) const
+    {
+        m_correlate(p_signal, p_symbolLength, p_symbolCount, p_inPhase, p_quadrature, p_inPhaseSums, p_quadratureSums);
+    }
+
+    /**
+     * @brief Correlate consecutive symbols in single precision with the selected kernel, see CorrelateFloatKernel
+     */
+    void correlate(const float *p_signal, size_t p_symbolLength, size_t p_symbolCount, const float *p_inPhase,
+                   const float *p_quadrature, double *p_inPhaseSums, double *p_quadratureSums) const
+    {
+        m_correlateFloat(p_signal, p_symbolLength, p_symbolCount, p_inPhase, p_quadrature, p_inPhaseSums, p_quadratureSums);
+    }
+
+    /**
+     * @brief Correlate consecutive symbols against a Q15 basis with the selected kernel, see CorrelateQ15Kernel
+     */
+    void correlate(const int16_t *p_signal, size_t p_symbolLength, size_t p_symbolCount, const int16_t *p_inPhase,
+                   const int16_t *p_quadrature, double *p_inPhaseSums, double *p_quadratureSums) const
+    {
+        m_correlateQ15(p_signal, p_symbolLength, p_symbolCount, p_inPhase, p_quadrature, p_inPhaseSums, p_quadratureSums);
+    }
+
+    /**
+     * @brief Sum the magnitude of consecutive symbols with the selected kernel, see EnvelopeKernel
+     *
+     * @param p_signal - the samples of the symbols
+     * @param p_symbolLength - the amount of samples of every symbol
+     * @param p_symbolCount - the amount of symbols
+     * @param p_sums - the envelope of every symbol
+     */
+    void sumEnvelopes(const double *p_signal, size_t p_symbolLength, size_t p_symbolCount, double *p_sums) const
+    {
+        m_sumEnvelopes(p_signal, p_symbolLength, p_symbolCount, p_sums);
+    }
+
+    /**
+     * @brief Sum the magnitude of consecutive symbols in single precision, see EnvelopeFloatKernel
+     */
+    void sumEnvelopes(const float *p_signal, size_t p_symbolLength, size_t p_symbolCount, double *p_sums) const
+    {
+        m_sumEnvelopesFloat(p_signal, p_symbolLength, p_symbolCount, p_sums);
+    }
+
+    /**
+     * @brief Sum the magnitude of consecutive int16 symbols, see EnvelopeQ15Kernel
+     */
+    void sumEnvelopes(const int16_t *p_signal, size_t p_symbolLength, size_t p_symbolCount, double *p_sums) const
+    {
+        m_sumEnvelopesQ15(p_signal, p_symbolLength, p_symbolCount, p_sums);
+    }
+
+    /**
+     * @brief Measure the power of every tone of a bank in consecutive symbols with the selected kernel, see GoertzelKernel
+     *
+     * @param p_signal - the samples of the symbols
+     * @param p_symbolLength - the amount of samples of every symbol
+     * @param p_symbolCount - the amount of symbols
+     * @param p_frequencies - the frequency w of every tone, in radian per sample
+     * @param p_toneCount - the amount of tones
+     * @param p_powers - the power of every tone of every symbol, symbol by symbol
+     */
+    void detectTones(const double *p_signal, size_t p_symbolLength, size_t p_symbolCount, const double *p_frequencies,
+                     size_t p_toneCount, double *p_powers) const
+    {
+        m_goertzel(p_signal, p_symbolLength, p_symbolCount, p_frequencies, p_toneCount, p_powers);
+    }
+
+    /**
+     * @brief Slide a complex reference over a complex signal with the selected kernel, see SlideKernel
+     *
+     * @param p_signalI - the real parts of the signal, p_outputCount + p_tapCount - 1 samples
+     * @param p_signalQ - the imaginary parts of the signal
+     * @param p_outputCount - the amount of outputs
+     * @param p_referenceI - the real parts of the reference, p_tapCount samples
+     * @param p_referenceQ - the imaginary parts of the reference
+     * @param p_tapCount - the reference length
+     * @param p_sumsI - the real part of every output
+     * @param p_sumsQ - the imaginary part of every output
+     */
+    void slide(const double *p_signalI, const double *p_signalQ, size_t p_outputCount, const double *p_referenceI,
+               const double *p_referenceQ, size_t p_tapCount, double *p_sumsI, double *p_sumsQ) const
+    {
+        m_slide(p_signalI, p_signalQ, p_outputCount, p_referenceI, p_referenceQ, p_tapCount, p_sumsI, p_sumsQ);
+    }
+
+    /**
+     * @brief Validate and pack an ASCII binary series with the selected kernel, see PackBitsKernel
+     *
+     * @param p_ascii - the characters
+     * @param p_count - the amount of characters
+     * @param p_words - output buffer of at least (p_count + 63) / 64 words
+     *
+     * @return true - the series is binary, false - otherwise
+     */
+    bool packBits(const char *p_ascii, size_t p_count, uint64_t *p_words) const
+    {
+        return m_packBits(p_ascii, p_count, p_words);
+    }
+
+private:
+    /// @brief The instruction set the kernels were selected for
+    SimdLevel m_level;
+
+    /// @brief The selected carrier synthesis kernel
+    SynthesizeKernel m_synthesize;
+
+    /// @brief The selected basis mixing kernel
+    CombineKernel m_combine;
+
+    /// @brief The selected single precision basis mixing kernel
+    CombineFloatKernel m_combineFloat;
+
+    /// @brief The selected inner product kernel
+    DotKernel m_dot;
+
+    /// @brief The selected fixed-point basis mixing kernel
+    CombineQ15Kernel m_combineQ15;
+
+    /// @brief The selected symbol correlation kernel
+    CorrelateKernel m_correlate;
+
+    /// @brief The selected single precision symbol correlation kernel
+    CorrelateFloatKernel m_correlateFloat;
+
+    /// @brief The selected fixed-point symbol correlation kernel
+    CorrelateQ15Kernel m_correlateQ15;
+
+    /// @brief The selected envelope kernel
+    EnvelopeKernel m_sumEnvelopes;
+
+    /// @brief The selected single precision envelope kernel
+    EnvelopeFloatKernel m_sumEnvelopesFloat;
+
+    /// @brief The selected fixed-point envelope kernel
+    EnvelopeQ15Kernel m_sumEnvelopesQ15;
+
+    /// @brief The selected tone bank kernel
+    GoertzelKernel m_goertzel;
+
+    /// @brief The selected sliding correlation kernel
+    SlideKernel m_slide;
+
+    /// @brief The selected binary series packing kernel
+    PackBitsKernel m_packBits;
+
+    /**
+     * @brief Constructor detecting CPU features, it is set private to apply the singleton pattern
+     */
+    SimdKernels();
+
+    SimdKernels(const SimdKernels &) = delete;
+    SimdKernels &operator=(const SimdKernels &) = delete;
+
+    /**
+     * @brief Detect the widest instruction set supported by the running CPU
+     *
+     * @return the widest supported instruction set
+     */
+    static SimdLevel detectLevel();
+
+    /**
+     * @brief Get the carrier synthesis kernel compiled for an instruction set
+     *
+     * @param p_level - the instruction set
+     *
+     * @return the kernel of that instruction set
+     */
+    static SynthesizeKernel getSynthesizeKernel(SimdLevel p_level);
+
+    /**
+     * @brief Get the basis mixing kernel compiled for an instruction set
+     *
+     * @param p_level - the instruction set
+     *
+     * @return the kernel of that instruction set
+     */
+    static CombineKernel getCombineKernel(SimdLevel p_level);
+
+    /**
+     * @brief Get the single precision basis mixing kernel compiled for an instruction set
+     *
+     * @param p_level - the instruction set
+     *
+     * @return the kernel of that instruction set
+     */
+    static CombineFloatKernel getCombineFloatKernel(SimdLevel p_level);
+
+    /**
+     * @brief Get the inner product kernel compiled for an instruction set
+     *
+     * @param p_level - the instruction set
+     *
+     * @return the kernel of that instruction set
+     */
+    static DotKernel getDotKernel(SimdLevel p_level);
+
+    /**
+     * @brief Get the fixed-point basis mixing kernel compiled for an instruction set
+     *
+     * @param p_level - the instruction set
+     *
+     * @return the kernel of that instruction set, AVX-512 uses the AVX2 kernel as 16-bit lanes need AVX-512BW
+     */
+    static CombineQ15Kernel getCombineQ15Kernel(SimdLevel p_level);
+
+    /**
+     * @brief Get the symbol correlation kernel compiled for an instruction set
+     *
+     * @param p_level - the instruction set
+     *
+     * @return the kernel of that instruction set
+     */
+    static CorrelateKernel getCorrelateKernel(SimdLevel p_level);
+
+    /**
+     * @brief Get the single precision symbol correlation kernel compiled for an instruction set
+     *
+     * @param p_level - the instruction set
+     *
+     * @return the kernel of that instruction set
+     */
+    static CorrelateFloatKernel getCorrelateFloatKernel(SimdLevel p_level);
+
+    /**
+     * @brief Get the fixed-point symbol correlation kernel compiled for an instruction set
+     *
+     * @param p_level - the instruction set
+     *
+     * @return the kernel of that instruction set, AVX-512 uses the AVX2 kernel as 16-bit lanes need AVX-512BW
+     */
+    static CorrelateQ15Kernel getCorrelateQ15Kernel(SimdLevel p_level);
+
+    /**
+     * @brief Get the envelope kernel compiled for an instruction set
+     *
+     * @param p_level - the instruction set
+     *
+     * @return the kernel of that instruction set
+     */
+    static EnvelopeKernel getEnvelopeKernel(SimdLevel p_level);
+
+    /**
+     * @brief Get the single precision envelope kernel compiled for an instruction set
+     *
+     * @param p_level - the instruction set
+     *
+     * @return the kernel of that instruction set
+     */
+    static EnvelopeFloatKernel getEnvelopeFloatKernel(SimdLevel p_level);
+
+    /**
+     * @brief Get the fixed-point envelope kernel compiled for an instruction set
+     *
+     * @param p_level - the instruction set
+     *
+     * @return the kernel of that instruction set, AVX-512 uses the AVX2 kernel as 16-bit lanes need AVX-512BW
+     */
+    static EnvelopeQ15Kernel getEnvelopeQ15Kernel(SimdLevel p_level);
+
+    /**
+     * @brief Get the tone bank kernel compiled for an instruction set
+     *
+     * @param p_level - the instruction set
+     *
+     * @return the kernel of that instruction set
+     */
+    static GoertzelKernel getGoertzelKernel(SimdLevel p_level);
+
+    /**
+     * @brief Get the sliding correlation kernel compiled for an instruction set
+     *
+     * @param p_level - the instruction set
+     *
+     * @return the kernel of that instruction set
+     */
+    static SlideKernel getSlideKernel(SimdLevel p_level);
+
+    /**
+     * @brief Get the binary series packing kernel compiled for an instruction set
+     *
+     * @param p_level - the instruction set
+     *
+     * @return the kernel of that instruction set, AVX-512 uses the AVX2 kernel as byte lanes need AVX-512BW
+     */
+    static PackBitsKernel getPackBitsKernel(SimdLevel p_level);
+
+    /**
+     * @brief Compare the kernels of an instruction set against the scalar reference kernels on a test waveform
+     *
+     * @param p_level - the instruction set to verify
+     *
+     * @return true - every kernel matches the reference within SIMD_KERNEL_TOLERANCE and the fixed-point and packing
+     * kernels match it exactly, false - otherwise
+     */
+    static bool verifyKernels(SimdLevel p_level);
+};
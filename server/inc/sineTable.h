@@ -0,0 +1,165 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// @brief The trig mode key: "libm" (std::polar) or "table" (quarter-wave sine table)
+constexpr const char *TRIG_MODE_KEY = "/trig";
+
+/// @brief The largest error allowed on a sine or cosine read from the table, the table size follows from it
+constexpr double SINE_TABLE_MAX_ERROR = 1e-7;
+
+/// @brief The largest table the size selection may pick, 2^20 intervals
+constexpr unsigned int SINE_TABLE_MAX_BITS = 20;
+
+/// @brief The amount of Taylor terms of the compile time sine, the last one is below 1e-30 on [0, pi/2]
+constexpr unsigned int SINE_TAYLOR_TERMS = 16;
+
+/// @brief How oscillators turn their phase into a phasor when they are re-anchored
+enum class TrigMode
+{
+    /// @brief std::polar, exact to the last bit of a double
+    LIBM,
+
+    /// @brief Linear interpolation in the quarter-wave sine table, within SINE_TABLE_MAX_ERROR
+    TABLE
+};
+
+/**
+ * @brief Parse a trig mode name as written in the server database
+ *
+ * @param p_name - "libm" or "table"
+ *
+ * @return the trig mode, libm when the name is unknown
+ */
+inline TrigMode parseTrigMode(const std::string &p_name)
+{
+    return (p_name == "table") ? TrigMode::TABLE : TrigMode::LIBM;
+}
+
+/**
+ * @brief Sine evaluated at compile time by its Taylor series, std::sin is not constexpr
+ *
+ * @param p_angle - angle in radian, in [0, pi/2]
+ *
+ * @return sin(p_angle) to double precision
+ */
+constexpr double computeSine(const double p_angle)
+{
+    double term = p_angle;
+    double sum = p_angle;
+    for (unsigned int termIdx = 1; termIdx < SINE_TAYLOR_TERMS; ++termIdx)
+    {
+        term *= -p_angle * p_angle / ((2.0 * termIdx) * (2.0 * termIdx + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * @brief Select the smallest table meeting an error bound, the linear interpolation of sin between points h apart
+ * is off by at most h^2/8 * max|sin''| = h^2/8
+ *
+ * @param p_maxError - the largest error allowed
+ *
+ * @return log2 of the amount of table intervals over a quarter wave
+ */
+constexpr unsigned int selectSineTableBits(const double p_maxError)
+{
+    unsigned int bits = 1;
+    while (bits < SINE_TABLE_MAX_BITS)
+    {
+        double step = (M_PI / 2) / static_cast<double>(static_cast<size_t>(1) << bits);
+        if (step * step / 8 <= p_maxError)
+        {
+            break;
+        }
+        ++bits;
+    }
+    return bits;
+}
+
+/// @brief log2 of the amount of table intervals over a quarter wave
+constexpr unsigned int SINE_TABLE_BITS = selectSineTableBits(SINE_TABLE_MAX_ERROR);
+
+/// @brief The amount of table intervals over a quarter wave, the table holds one more point for the end of the last one
+constexpr size_t SINE_TABLE_SIZE = static_cast<size_t>(1) << SINE_TABLE_BITS;
+
+/**
+ * @brief Tabulate sin over a quarter wave at compile time
+ *
+ * @return sin(pi/2 * i / SINE_TABLE_SIZE) for i in [0, SINE_TABLE_SIZE]
+ */
+constexpr std::array<double, SINE_TABLE_SIZE + 1> buildSineTable()
+{
+    std::array<double, SINE_TABLE_SIZE + 1> table = {};
+    for (size_t index = 0; index <= SINE_TABLE_SIZE; ++index)
+    {
+        table[index] = computeSine((M_PI / 2) * index / SINE_TABLE_SIZE);
+    }
+    return table;
+}
+
+/// @brief The quarter-wave sine table, generated by the compiler
+inline constexpr std::array<double, SINE_TABLE_SIZE + 1> SINE_TABLE = buildSineTable();
+
+/**
+ * @brief Measure the interpolation error of the table at compile time, in the middle of every interval where the
+ * error of a linear interpolation peaks
+ *
+ * @return the largest error
+ */
+constexpr double measureSineTableError()
+{
+    double worst = 0;
+    for (size_t index = 0; index < SINE_TABLE_SIZE; ++index)
+    {
+        double interpolated = (SINE_TABLE[index] + SINE_TABLE[index + 1]) / 2;
+        double error = interpolated - computeSine((M_PI / 2) * (index + 0.5) / SINE_TABLE_SIZE);
+        if (error < 0)
+        {
+            error = -error;
+        }
+        if (error > worst)
+        {
+            worst = error;
+        }
+    }
+    return worst;
+}
+
+static_assert(measureSineTableError() <= SINE_TABLE_MAX_ERROR, "the sine table does not meet its error bound");
+
+/**
+ * @brief Get e^{j*2*pi*p_phase/2^64} from the sine table, the phase scale of the oscillator phase accumulator
+ *
+ * The top 2 bits of the phase select the quadrant, the next SINE_TABLE_BITS the table interval and the rest the
+ * interpolation fraction. The cosine is the same table read backwards.
+ *
+ * @param p_phase - the phase, one full cycle equals 2^64
+ *
+ * @return the phasor, each component within SINE_TABLE_MAX_ERROR
+ */
+inline std::complex<double> lookupPhasor(const uint64_t p_phase)
+{
+    const uint64_t position = p_phase << 2;
+    const size_t index = static_cast<size_t>(position >> (64 - SINE_TABLE_BITS));
+    const double fraction = static_cast<double>(position << SINE_TABLE_BITS) * 0x1p-64;
+    const double sine = SINE_TABLE[index] + fraction * (SINE_TABLE[index + 1] - SINE_TABLE[index]);
+    const double cosine = SINE_TABLE[SINE_TABLE_SIZE - index] +
+                          fraction * (SINE_TABLE[SINE_TABLE_SIZE - index - 1] - SINE_TABLE[SINE_TABLE_SIZE - index]);
+    switch (p_phase >> 62)
+    {
+    case 0:
+        return {cosine, sine};
+    case 1:
+        return {-sine, cosine};
+    case 2:
+        return {-cosine, -sine};
+    default:
+        return {sine, -cosine};
+    }
+}
@@ -0,0 +1,168 @@
+#pragma once
+#include <complex>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+#include "modulationScheme.h"
+
+/// @brief The maximum amount of templates kept in the cache before it is cleared
+constexpr size_t WAVEFORM_CACHE_MAX_ENTRIES = 32;
+
+/// @brief The largest alphabet whose aligned symbols are pre-rendered, larger ones are stitched from the tone basis
+constexpr size_t WAVEFORM_MAX_RENDERED_SYMBOLS = 16;
+
+/// @brief The gains of one symbol of a scheme: the tone it is sent on and its I/Q amplitudes
+struct SymbolShape
+{
+    /// @brief Index of the tone (carrier) the symbol is transmitted on
+    unsigned int tone;
+
+    /// @brief The gain of the in-phase (cosine) component
+    double inPhaseGain;
+
+    /// @brief The gain of the quadrature (sine) component
+    double quadratureGain;
+
+    bool operator==(const SymbolShape &p_other) const
+    {
+        return tone == p_other.tone && inPhaseGain == p_other.inPhaseGain && quadratureGain == p_other.quadratureGain;
+    }
+};
+
+/// @brief The one-symbol basis waveforms of a tone, starting at phase 0
+struct SymbolTone
+{
+    /// @brief The tone frequency
+    double frequency;
+
+    /// @brief cos(2*pi*f*n/fs) for every sample n of a symbol
+    std::vector<double> inPhase;
+
+    /// @brief sin(2*pi*f*n/fs) for every sample n of a symbol
+    std::vector<double> quadrature;
+
+    /// @brief Single precision copy of inPhase, used by the float and int16 sample paths
+    std::vector<float> inPhaseFloat;
+
+    /// @brief Single precision copy of quadrature, used by the float and int16 sample paths
+    std::vector<float> quadratureFloat;
+
+    /// @brief Q15 copy of inPhase, used by the fixed-point sample path
+    std::vector<int16_t> inPhaseQ15;
+
+    /// @brief Q15 copy of quadrature, used by the fixed-point sample path
+    std::vector<int16_t> quadratureQ15;
+
+    /// @brief Sum of (cos + j*sin)^2 over a whole symbol, the I/Q cross terms of a symbol starting at phase 0
+    std::complex<double> squares;
+
+    /// @brief true - every symbol spans a whole number of tone cycles, so every symbol starts at the same phase
+    bool isAligned;
+};
+
+/// @brief The precomputed waveforms of a scheme at one carrier frequency and sample rate
+struct WaveformTemplate
+{
+    /// @brief The amount of samples transmitted in 1 second
+    double sampleRate;
+
+    /// @brief The amount of samples of one symbol
+    unsigned int samplesPerSymbol;
+
+    /// @brief The phase every tone starts at, at time 0
+    double initialPhase;
+
+    /// @brief The symbols of the scheme, indexed by symbol value
+    std::vector<SymbolShape> alphabet;
+
+    /// @brief The basis waveforms of every tone used by the scheme
+    std::vector<SymbolTone> tones;
+
+    /// @brief The complete waveform of every symbol sent on an aligned tone, empty for the other symbols
+    /// and for alphabets larger than WAVEFORM_MAX_RENDERED_SYMBOLS
+    std::vector<std::vector<double>> waveforms;
+
+    /// @brief Single precision copy of waveforms, used by the float and int16 sample paths
+    std::vector<std::vector<float>> waveformsFloat;
+
+    /// @brief The waveforms mixed from the Q15 basis by the fixed-point kernel, int16 scaled by INT16_SAMPLE_SCALE
+    std::vector<std::vector<int16_t>> waveformsFixed;
+};
+
+/**
+ * @brief Process-wide cache of symbol waveform templates keyed by (scheme, carrier frequency, sample rate)
+ *
+ * All modulators share the cache, so repeated DL commands at the same frequency only stitch precomputed
+ * symbols together. Templates are immutable once built, readers keep them alive through shared pointers
+ * even if the cache is invalidated in the meantime.
+ */
+class WaveformCache
+{
+public:
+    /**
+     * @brief The function that allows retrieving the cache singleton object
+     */
+    static WaveformCache &getInstance();
+
+    /**
+     * @brief Get the templates of a scheme, building them on the first request
+     *
+     * @param p_scheme - modulation scheme
+     * @param p_carrierFrequency - carrier wave frequency
+     * @param p_sampleRate - the amount of samples transmitted in 1 second
+     * @param p_samplesPerSymbol - the amount of samples of one symbol
+     * @param p_initialPhase - the phase every tone starts at, at time 0
+     * @param p_toneFrequencies - the frequency of every tone used by the scheme
+     * @param p_alphabet - the symbols of the scheme, indexed by symbol value
+     *
+     * @return the templates, rebuilt when the cached ones were made with different scheme parameters
+     */
+    std::shared_ptr<const WaveformTemplate> getTemplate(ModulationScheme p_scheme, double p_carrierFrequency, double p_sampleRate,
+                                                        unsigned int p_samplesPerSymbol, double p_initialPhase,
+                                                        const std::vector<double> &p_toneFrequencies,
+                                                        const std::vector<SymbolShape> &p_alphabet);
+
+    /**
+     * @brief Drop every cached template, called when the carrier frequency or the sample rate changes
+     */
+    void invalidate();
+
+    /**
+     * @brief Get the amount of cached templates
+     *
+     * @return the amount of cached templates
+     */
+    size_t size();
+
+private:
+    /// @brief Protects m_templates, the cache is shared by every request
+    std::mutex m_mutex;
+
+    /// @brief The cached templates
+    std::map<std::tuple<ModulationScheme, double, double>, std::shared_ptr<const WaveformTemplate>> m_templates;
+
+    WaveformCache() = default;
+    WaveformCache(const WaveformCache &) = delete;
+    WaveformCache &operator=(const WaveformCache &) = delete;
+
+    /**
+     * @brief Render the basis waveforms and the aligned symbol waveforms of a scheme
+     *
+     * @return the new templates
+     */
+    static std::shared_ptr<const WaveformTemplate> buildTemplate(double p_sampleRate, unsigned int p_samplesPerSymbol,
+                                                                 double p_initialPhase,
+                                                                 const std::vector<double> &p_toneFrequencies,
+                                                                 const std::vector<SymbolShape> &p_alphabet);
+
+    /**
+     * @brief Check whether cached templates were built with the given scheme parameters
+     *
+     * @return true - the templates can be reused, false - they must be rebuilt
+     */
+    static bool isMatching(const WaveformTemplate &p_template, unsigned int p_samplesPerSymbol, double p_initialPhase,
+                           const std::vector<double> &p_toneFrequencies, const std::vector<SymbolShape> &p_alphabet);
+};
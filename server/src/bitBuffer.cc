@@ -0,0 +1,114 @@
+#include "bitBuffer.h"
+#include "simdKernels.h"
+#include <algorithm>
+
+BitBuffer::BitBuffer() : m_size(0)
+{
+}
+
+bool BitBuffer::pack(const std::string &p_ascii, BitBuffer &p_bits)
+{
+    p_bits.m_words.resize((p_ascii.size() + BIT_BUFFER_WORD_BITS - 1) / BIT_BUFFER_WORD_BITS);
+    p_bits.m_size = p_ascii.size();
+    if (!SimdKernels::getInstance().packBits(p_ascii.data(), p_ascii.size(), p_bits.m_words.data()))
+    {
+        p_bits.clear();
+        return false;
+    }
+    return true;
+}
+
+std::string BitBuffer::toString() const
+{
+    std::string ascii(m_size, '0');
+    for (size_t bitIdx = 0; bitIdx < m_size; ++bitIdx)
+    {
+        ascii[bitIdx] += getBit(bitIdx);
+    }
+    return ascii;
+}
+
+void BitBuffer::setBit(const size_t p_bitIdx, const unsigned int p_value)
+{
+    const uint64_t mask = static_cast<uint64_t>(1) << (BIT_BUFFER_WORD_BITS - 1 - p_bitIdx % BIT_BUFFER_WORD_BITS);
+    uint64_t &word = m_words[p_bitIdx / BIT_BUFFER_WORD_BITS];
+    word = p_value ? (word | mask) : (word & ~mask);
+}
+
+void BitBuffer::append(const BitBuffer &p_bits)
+{
+    const unsigned int offset = m_size % BIT_BUFFER_WORD_BITS;
+    if (offset == 0)
+    {
+        m_words.insert(m_words.end(), p_bits.m_words.begin(), p_bits.m_words.end());
+    }
+    else
+    {
+        // Every word is split between the free low bits of the last word and the high bits of a new one
+        for (uint64_t word : p_bits.m_words)
+        {
+            m_words.back() |= word >> offset;
+            m_words.push_back(word << (BIT_BUFFER_WORD_BITS - offset));
+        }
+    }
+    m_size += p_bits.m_size;
+    m_words.resize((m_size + BIT_BUFFER_WORD_BITS - 1) / BIT_BUFFER_WORD_BITS);
+}
+
+void BitBuffer::resize(const size_t p_size)
+{
+    m_words.resize((p_size + BIT_BUFFER_WORD_BITS - 1) / BIT_BUFFER_WORD_BITS, 0);
+    m_size = p_size;
+    if (m_size % BIT_BUFFER_WORD_BITS != 0)
+    {
+        m_words.back() &= ~static_cast<uint64_t>(0) << (BIT_BUFFER_WORD_BITS - m_size % BIT_BUFFER_WORD_BITS);
+    }
+}
+
+void BitBuffer::reserve(const size_t p_size)
+{
+    m_words.reserve((p_size + BIT_BUFFER_WORD_BITS - 1) / BIT_BUFFER_WORD_BITS);
+}
+
+void BitBuffer::clear()
+{
+    m_words.clear();
+    m_size = 0;
+}
+
+size_t BitBuffer::countErrors(const BitBuffer &p_received, const size_t p_firstBit) const
+{
+    const size_t firstBit = std::min(p_firstBit, p_received.m_size);
+    const size_t commonEnd = std::max(std::min(m_size, p_received.m_size), firstBit);
+    size_t errors = p_received.m_size - commonEnd;
+    if (firstBit == commonEnd)
+    {
+        return errors;
+    }
+    const size_t firstWord = firstBit / BIT_BUFFER_WORD_BITS;
+    const size_t lastWord = (commonEnd - 1) / BIT_BUFFER_WORD_BITS;
+    for (size_t wordIdx = firstWord; wordIdx <= lastWord; ++wordIdx)
+    {
+        uint64_t differences = m_words[wordIdx] ^ p_received.m_words[wordIdx];
+        if (wordIdx == firstWord)
+        {
+            differences &= ~static_cast<uint64_t>(0) >> (firstBit % BIT_BUFFER_WORD_BITS);
+        }
+        if (wordIdx == lastWord && commonEnd % BIT_BUFFER_WORD_BITS != 0)
+        {
+            differences &= ~static_cast<uint64_t>(0) << (BIT_BUFFER_WORD_BITS - commonEnd % BIT_BUFFER_WORD_BITS);
+        }
+        errors += __builtin_popcountll(differences);
+    }
+    return errors;
+}
+
+bool BitBuffer::operator==(const BitBuffer &p_other) const
+{
+    return m_size == p_other.m_size && m_words == p_other.m_words;
+}
+
+bool BitBuffer::operator!=(const BitBuffer &p_other) const
+{
+    return !(*this == p_other);
+}
@@ -1,8 +1,13 @@
 #include "carrier.h"
+#include "waveformCache.h"
+#include <algorithm>
+#include <sstream>
 
 Carrier::Carrier()
 {
     m_network = "";
+    m_scheme = ModulationScheme::UNKNOWN;
+    m_arithmetic = Arithmetic::FLOATING_POINT;
     m_flagCarrier = false;
     m_frequency = 0;
 }
@@ -12,6 +17,8 @@ bool Carrier::setNetwork(const std::string &p_network)
     if (!m_flagCarrier)
     {
         m_network = p_network;
+        m_scheme = getNetworkScheme(p_network, readSchemeOrder(p_network), readSchemeModulation(p_network));
+        m_arithmetic = readArithmetic(p_network);
         m_flagCarrier = true;
         return true;
     }
@@ -26,8 +33,23 @@ std::string Carrier::getNetwork()
     return m_network;
 }
 
+ModulationScheme Carrier::getScheme()
+{
+    return m_scheme;
+}
+
+Arithmetic Carrier::getArithmetic()
+{
+    return m_arithmetic;
+}
+
 void Carrier::setFrequency(const size_t &p_freq)
 {
+    if (p_freq != m_frequency)
+    {
+        // Templates rendered for the old carrier are never hit again
+        WaveformCache::getInstance().invalidate();
+    }
     m_frequency = p_freq;
 }
 
@@ -39,6 +61,8 @@ size_t Carrier::getFrequency()
 void Carrier::releaseCarrier()
 {
     m_network = "";
+    m_scheme = ModulationScheme::UNKNOWN;
+    m_arithmetic = Arithmetic::FLOATING_POINT;
     m_flagCarrier = false;
     m_frequency = 0;
 }
@@ -75,4 +99,77 @@ bool Carrier::checkSupportedFrequency(const ssize_t &p_freq)
         return true;
     else
         return false;
-}
\ No newline at end of file
+}
+
+unsigned long Carrier::readSchemeOrder(const std::string &p_network)
+{
+    std::string key;
+    if (p_network == "3G")
+        key = PSK_ORDER_KEY;
+    else if (p_network == "4G")
+        key = FSK_ORDER_KEY;
+    else if (p_network == "5G")
+        key = QAM_ORDER_KEY;
+    else
+        return 0;
+
+    // Databases without the order setting keep the original BPSK, binary FSK and 16-QAM
+    try
+    {
+        unsigned long order = 0;
+        auto varOrder = InMemDatabase::getInstance().getValue(key);
+        extractValue<unsigned long>(varOrder, order);
+        return order;
+    }
+    catch (const DBException &e)
+    {
+        return 0;
+    }
+}
+
+std::string Carrier::readSchemeModulation(const std::string &p_network)
+{
+    if (p_network != "2G")
+        return "";
+
+    // Databases without the modulation setting keep the original ASK
+    try
+    {
+        const char *modulation = "";
+        auto varModulation = InMemDatabase::getInstance().getValue(GSM_MODULATION_KEY);
+        extractValue<char const *>(varModulation, modulation);
+        return std::string(modulation);
+    }
+    catch (const DBException &e)
+    {
+        return "";
+    }
+}
+
+Arithmetic Carrier::readArithmetic(const std::string &p_network)
+{
+    // Databases without the setting simulate every network in floating point
+    try
+    {
+        const char *fixedPointCarriers = "";
+        auto varCarriers = InMemDatabase::getInstance().getValue(FIXED_POINT_CARRIERS_KEY);
+        extractValue<char const *>(varCarriers, fixedPointCarriers);
+        // The networks are separated by commas or spaces and compared whole, so a network is not selected by a longer name containing it
+        std::string strFixedPointCarriers(fixedPointCarriers);
+        std::replace(strFixedPointCarriers.begin(), strFixedPointCarriers.end(), ',', ' ');
+        std::istringstream carriers(strFixedPointCarriers);
+        std::string carrier;
+        while (carriers >> carrier)
+        {
+            if (carrier == p_network)
+            {
+                return Arithmetic::FIXED_POINT;
+            }
+        }
+        return Arithmetic::FLOATING_POINT;
+    }
+    catch (const DBException &e)
+    {
+        return Arithmetic::FLOATING_POINT;
+    }
+}
@@ -0,0 +1,95 @@
+#include "constellation.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+Constellation::Constellation(const ConstellationShape p_shape, const unsigned int p_order)
+    : m_shape(p_shape), m_order(p_order), m_bitsPerSymbol(0), m_levelCount(0), m_phaseOffset(0.0)
+{
+    while ((1u << m_bitsPerSymbol) < p_order)
+    {
+        ++m_bitsPerSymbol;
+    }
+    if (p_order < 2 || (1u << m_bitsPerSymbol) != p_order || (p_shape == ConstellationShape::QAM && m_bitsPerSymbol % 2 != 0))
+    {
+        throw std::invalid_argument("Constellation order must be a power of 2, and of 4 for QAM.");
+    }
+
+    m_points.resize(m_order);
+    if (m_shape == ConstellationShape::QAM)
+    {
+        // The first half of the bits selects the I level, the second half the Q level. Levels are spaced
+        // 2 / L apart and centered on 0, so 16-QAM keeps its {-0.75, -0.25, 0.25, 0.75} amplitudes.
+        unsigned int halfBits = m_bitsPerSymbol / 2;
+        m_levelCount = 1u << halfBits;
+        for (unsigned int symbol = 0; symbol < m_order; ++symbol)
+        {
+            unsigned int iLevel = decodeGray(symbol >> halfBits);
+            unsigned int qLevel = decodeGray(symbol & (m_levelCount - 1));
+            m_points[symbol] = {(2.0 * iLevel + 1 - m_levelCount) / m_levelCount,
+                                (2.0 * qLevel + 1 - m_levelCount) / m_levelCount};
+        }
+        for (unsigned int level = 0; level < m_levelCount; ++level)
+        {
+            m_decisionTable.push_back(level ^ (level >> 1));
+        }
+    }
+    else
+    {
+        // Binary PSK keeps its points on the I axis, higher orders start half a sector off the axis
+        m_phaseOffset = (m_order > 2) ? M_PI / m_order : 0.0;
+        for (unsigned int sector = 0; sector < m_order; ++sector)
+        {
+            unsigned int symbol = sector ^ (sector >> 1);
+            m_points[symbol] = std::polar(1.0, m_phaseOffset + 2 * M_PI * sector / m_order);
+            m_decisionTable.push_back(symbol);
+        }
+    }
+}
+
+unsigned int Constellation::getOrder() const
+{
+    return m_order;
+}
+
+unsigned int Constellation::getBitsPerSymbol() const
+{
+    return m_bitsPerSymbol;
+}
+
+const std::vector<std::complex<double>> &Constellation::getPoints() const
+{
+    return m_points;
+}
+
+unsigned int Constellation::slice(const std::complex<double> &p_point) const
+{
+    if (m_shape == ConstellationShape::QAM)
+    {
+        // The decision boundaries lie half way between the levels, quantize each axis and clamp the outer levels
+        int maxLevel = static_cast<int>(m_levelCount) - 1;
+        int iLevel = std::clamp(static_cast<int>(std::floor((p_point.real() + 1) * m_levelCount / 2)), 0, maxLevel);
+        int qLevel = std::clamp(static_cast<int>(std::floor((p_point.imag() + 1) * m_levelCount / 2)), 0, maxLevel);
+        return (m_decisionTable[iLevel] << (m_bitsPerSymbol / 2)) | m_decisionTable[qLevel];
+    }
+
+    // The sector of a point is centered on its phase, shift by half a sector before quantizing
+    double sectorWidth = 2 * M_PI / m_order;
+    double angle = std::arg(p_point) - m_phaseOffset + sectorWidth / 2;
+    int sector = static_cast<int>(std::floor(angle / sectorWidth)) % static_cast<int>(m_order);
+    if (sector < 0)
+    {
+        sector += m_order;
+    }
+    return m_decisionTable[sector];
+}
+
+unsigned int Constellation::decodeGray(unsigned int p_gray)
+{
+    unsigned int index = 0;
+    for (; p_gray != 0; p_gray >>= 1)
+    {
+        index ^= p_gray;
+    }
+    return index;
+}
@@ -0,0 +1,143 @@
+#include "correlator.h"
+#include "simdKernels.h"
+#include "serverCommon.h"
+#include <algorithm>
+#include <stdexcept>
+
+Correlator::Correlator(const std::vector<std::complex<double>> &p_reference)
+    : Correlator(p_reference, (p_reference.size() >= CorrelationCrossover::getInstance().getMinFftTaps())
+                                  ? CorrelationMethod::OVERLAP_SAVE
+                                  : CorrelationMethod::DIRECT)
+{
+}
+
+Correlator::Correlator(const std::vector<std::complex<double>> &p_reference, const CorrelationMethod p_method)
+    : m_reference(p_reference), m_method(p_method)
+{
+    if (p_reference.empty())
+    {
+        throw std::invalid_argument("Correlation reference must not be empty.");
+    }
+    if (m_method == CorrelationMethod::OVERLAP_SAVE)
+    {
+        const size_t size = getNextPowerOfTwo(CORRELATION_FFT_BLOCK_FACTOR * m_reference.size());
+        m_plan = FftPlanCache::getInstance().getPlan(size);
+        m_spectrum.assign(size, std::complex<double>(0));
+        std::copy(m_reference.begin(), m_reference.end(), m_spectrum.begin());
+        m_plan->forward(m_spectrum.data());
+        // The inverse transform is not scaled, the 1 / N factor is folded into the reference once
+        for (std::complex<double> &bin : m_spectrum)
+        {
+            bin = std::conj(bin) / static_cast<double>(size);
+        }
+    }
+}
+
+std::vector<std::complex<double>> Correlator::correlate(const std::vector<std::complex<double>> &p_signal) const
+{
+    std::vector<std::complex<double>> output;
+    if (p_signal.size() < m_reference.size())
+    {
+        return output;
+    }
+    output.resize(p_signal.size() - m_reference.size() + 1);
+    if (m_method == CorrelationMethod::OVERLAP_SAVE)
+    {
+        correlateOverlapSave(p_signal, output);
+    }
+    else
+    {
+        correlateDirect(p_signal, output);
+    }
+    return output;
+}
+
+size_t Correlator::getTapCount() const
+{
+    return m_reference.size();
+}
+
+CorrelationMethod Correlator::getMethod() const
+{
+    return m_method;
+}
+
+void Correlator::correlateDirect(const std::vector<std::complex<double>> &p_signal,
+                                 std::vector<std::complex<double>> &p_output) const
+{
+    std::vector<double> signalI(p_signal.size());
+    std::vector<double> signalQ(p_signal.size());
+    for (size_t sampleIdx = 0; sampleIdx < p_signal.size(); ++sampleIdx)
+    {
+        signalI[sampleIdx] = p_signal[sampleIdx].real();
+        signalQ[sampleIdx] = p_signal[sampleIdx].imag();
+    }
+    std::vector<double> referenceI(m_reference.size());
+    std::vector<double> referenceQ(m_reference.size());
+    for (size_t tapIdx = 0; tapIdx < m_reference.size(); ++tapIdx)
+    {
+        referenceI[tapIdx] = m_reference[tapIdx].real();
+        referenceQ[tapIdx] = m_reference[tapIdx].imag();
+    }
+    std::vector<double> sumsI(p_output.size());
+    std::vector<double> sumsQ(p_output.size());
+    SimdKernels::getInstance().slide(signalI.data(), signalQ.data(), p_output.size(), referenceI.data(), referenceQ.data(),
+                                     m_reference.size(), sumsI.data(), sumsQ.data());
+    for (size_t outputIdx = 0; outputIdx < p_output.size(); ++outputIdx)
+    {
+        p_output[outputIdx] = {sumsI[outputIdx], sumsQ[outputIdx]};
+    }
+}
+
+void Correlator::correlateOverlapSave(const std::vector<std::complex<double>> &p_signal,
+                                      std::vector<std::complex<double>> &p_output) const
+{
+    // The circular correlation of a block is exact for its first size - taps + 1 lags, the next block starts there
+    const size_t size = m_plan->getSize();
+    const size_t step = size - m_reference.size() + 1;
+    std::vector<std::complex<double>> block(size);
+    for (size_t first = 0; first < p_output.size(); first += step)
+    {
+        const size_t available = std::min(size, p_signal.size() - first);
+        std::copy_n(p_signal.begin() + first, available, block.begin());
+        std::fill(block.begin() + available, block.end(), std::complex<double>(0));
+        m_plan->forward(block.data());
+        for (size_t binIdx = 0; binIdx < size; ++binIdx)
+        {
+            block[binIdx] *= m_spectrum[binIdx];
+        }
+        m_plan->inverse(block.data());
+        std::copy_n(block.begin(), std::min(step, p_output.size() - first), p_output.begin() + first);
+    }
+}
+
+CorrelationCrossover::CorrelationCrossover() : m_isResolved(false), m_minFftTaps(0)
+{
+}
+
+CorrelationCrossover &CorrelationCrossover::getInstance()
+{
+    static CorrelationCrossover m_instance;
+    return m_instance;
+}
+
+size_t CorrelationCrossover::getMinFftTaps()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_isResolved)
+    {
+        unsigned long minFftTaps = 0;
+        try
+        {
+            auto var = InMemDatabase::getInstance().getValue(CORRELATION_FFT_MIN_TAPS_KEY);
+            extractValue<unsigned long>(var, minFftTaps);
+        }
+        catch (const DBException &e)
+        {
+            minFftTaps = 0;
+        }
+        m_minFftTaps = (minFftTaps == 0) ? DEFAULT_CORRELATION_FFT_MIN_TAPS : minFftTaps;
+        m_isResolved = true;
+    }
+    return m_minFftTaps;
+}
@@ -0,0 +1,134 @@
+#include "fft.h"
+#include <cmath>
+#include <stdexcept>
+
+FftPlan::FftPlan(const size_t p_size) : m_size(p_size)
+{
+    if (p_size == 0 || (p_size & (p_size - 1)) != 0)
+    {
+        throw std::invalid_argument("FFT size must be a power of 2.");
+    }
+    size_t bits = 0;
+    while ((static_cast<size_t>(1) << bits) < p_size)
+    {
+        ++bits;
+    }
+    for (size_t index = 0; index < p_size; ++index)
+    {
+        size_t reversed = 0;
+        for (size_t bitIdx = 0; bitIdx < bits; ++bitIdx)
+        {
+            reversed |= ((index >> bitIdx) & 1) << (bits - 1 - bitIdx);
+        }
+        if (index < reversed)
+        {
+            m_swaps.emplace_back(index, reversed);
+        }
+    }
+    for (size_t index = 0; index < p_size / 2; ++index)
+    {
+        m_twiddles.push_back(std::polar(1.0, -2 * M_PI * index / p_size));
+    }
+}
+
+size_t FftPlan::getSize() const
+{
+    return m_size;
+}
+
+void FftPlan::forward(std::complex<double> *p_data) const
+{
+    transform(p_data, false);
+}
+
+void FftPlan::inverse(std::complex<double> *p_data) const
+{
+    transform(p_data, true);
+}
+
+void FftPlan::transform(std::complex<double> *p_data, const bool p_isInverse) const
+{
+    for (const std::pair<size_t, size_t> &swap : m_swaps)
+    {
+        std::swap(p_data[swap.first], p_data[swap.second]);
+    }
+
+    size_t half = 1;
+    size_t stages = 0;
+    while ((static_cast<size_t>(1) << stages) < m_size)
+    {
+        ++stages;
+    }
+    if (stages % 2 != 0)
+    {
+        for (size_t index = 0; index < m_size; index += 2)
+        {
+            std::complex<double> odd = p_data[index + 1];
+            p_data[index + 1] = p_data[index] - odd;
+            p_data[index] += odd;
+        }
+        half = 2;
+    }
+
+    // Two radix-2 stages of half sizes h and 2h fused: w^h of the second stage is -j (+j for the inverse)
+    const std::complex<double> quarterTurn(0.0, p_isInverse ? 1.0 : -1.0);
+    for (; half < m_size; half *= 4)
+    {
+        const size_t firstStride = m_size / (2 * half);
+        const size_t secondStride = m_size / (4 * half);
+        for (size_t start = 0; start < m_size; start += 4 * half)
+        {
+            for (size_t index = 0; index < half; ++index)
+            {
+                std::complex<double> firstTwiddle = m_twiddles[index * firstStride];
+                std::complex<double> secondTwiddle = m_twiddles[index * secondStride];
+                if (p_isInverse)
+                {
+                    firstTwiddle = std::conj(firstTwiddle);
+                    secondTwiddle = std::conj(secondTwiddle);
+                }
+                std::complex<double> *data = p_data + start + index;
+                std::complex<double> odd0 = firstTwiddle * data[half];
+                std::complex<double> odd1 = firstTwiddle * data[3 * half];
+                std::complex<double> even0 = data[0] + odd0;
+                std::complex<double> even1 = data[0] - odd0;
+                std::complex<double> even2 = data[2 * half] + odd1;
+                std::complex<double> even3 = data[2 * half] - odd1;
+                std::complex<double> twisted2 = secondTwiddle * even2;
+                std::complex<double> twisted3 = quarterTurn * secondTwiddle * even3;
+                data[0] = even0 + twisted2;
+                data[2 * half] = even0 - twisted2;
+                data[half] = even1 + twisted3;
+                data[3 * half] = even1 - twisted3;
+            }
+        }
+    }
+}
+
+FftPlanCache &FftPlanCache::getInstance()
+{
+    static FftPlanCache m_instance;
+    return m_instance;
+}
+
+std::shared_ptr<const FftPlan> FftPlanCache::getPlan(const size_t p_size)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto entry = m_plans.find(p_size);
+        if (entry != m_plans.end())
+        {
+            return entry->second;
+        }
+    }
+
+    // Build outside the lock, concurrent misses on the same size only cost a duplicated build
+    std::shared_ptr<const FftPlan> plan = std::make_shared<FftPlan>(p_size);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_plans.size() >= FFT_PLAN_CACHE_MAX_ENTRIES)
+    {
+        m_plans.clear();
+    }
+    m_plans[p_size] = plan;
+    return plan;
+}
@@ -0,0 +1,328 @@
+#include "gmsk.h"
+#include "fft.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace
+{
+    std::complex<double> rotateQuarterTurns(const std::complex<double> &p_value, const unsigned int p_quarterTurns)
+    {
+        switch (p_quarterTurns & 3)
+        {
+        case 1:
+            return {-p_value.imag(), p_value.real()};
+        case 2:
+            return -p_value;
+        case 3:
+            return {p_value.imag(), -p_value.real()};
+        default:
+            return p_value;
+        }
+    }
+
+    // The bits around the message are 0
+    unsigned int readBit(const BitBuffer &p_binaryData, const long p_bitIdx)
+    {
+        return (p_bitIdx >= 0 && static_cast<size_t>(p_bitIdx) < p_binaryData.size()) ? p_binaryData.getBit(p_bitIdx) : 0;
+    }
+}
+
+GmskTableCache &GmskTableCache::getInstance()
+{
+    static GmskTableCache m_instance;
+    return m_instance;
+}
+
+std::shared_ptr<const GmskTable> GmskTableCache::getTable(const double p_bandwidthTime, const unsigned int p_samplesPerSymbol)
+{
+    auto key = std::make_pair(p_bandwidthTime, p_samplesPerSymbol);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto entry = m_tables.find(key);
+        if (entry != m_tables.end())
+        {
+            return entry->second;
+        }
+    }
+
+    // Build outside the lock, concurrent misses on the same key only cost a duplicated build
+    std::shared_ptr<const GmskTable> table = buildTable(p_bandwidthTime, p_samplesPerSymbol);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_tables.size() >= GMSK_TABLE_CACHE_MAX_ENTRIES)
+    {
+        m_tables.clear();
+    }
+    m_tables[key] = table;
+    return table;
+}
+
+std::shared_ptr<const GmskTable> GmskTableCache::buildTable(const double p_bandwidthTime, const unsigned int p_samplesPerSymbol)
+{
+    auto table = std::make_shared<GmskTable>();
+    table->samplesPerSymbol = p_samplesPerSymbol;
+
+    // The frequency pulse is a rectangle of one symbol through a Gaussian filter of sigma sqrt(ln 2) / (2 pi BT) symbols,
+    // it is cut 3 sigma away from the rectangle on both sides
+    const double sigma = std::sqrt(std::log(2.0)) / (2 * M_PI * p_bandwidthTime);
+    const unsigned int span = std::min(GMSK_MAX_SPAN, std::max(2u, static_cast<unsigned int>(std::ceil(1 + 6 * sigma))));
+    table->span = span;
+    const double center = span / 2.0;
+    auto frequencyPulse = [sigma, center](double p_time)
+    {
+        double scale = 1 / (std::sqrt(2.0) * sigma);
+        return (std::erf((p_time - center + 0.5) * scale) - std::erf((p_time - center - 0.5) * scale)) / 2;
+    };
+
+    // q is integrated with the midpoint rule and scaled so a whole pulse turns the phase by exactly pi / 2
+    const size_t steps = static_cast<size_t>(span) * p_samplesPerSymbol;
+    const double step = 1.0 / (static_cast<double>(p_samplesPerSymbol) * GMSK_INTEGRATION_STEPS);
+    std::vector<double> phasePulse(steps + 1, 0.0);
+    double area = 0;
+    for (size_t sampleIdx = 0; sampleIdx < steps; ++sampleIdx)
+    {
+        for (unsigned int stepIdx = 0; stepIdx < GMSK_INTEGRATION_STEPS; ++stepIdx)
+        {
+            area += frequencyPulse((sampleIdx * GMSK_INTEGRATION_STEPS + stepIdx + 0.5) * step) * step;
+        }
+        phasePulse[sampleIdx + 1] = area;
+    }
+    for (double &phase : phasePulse)
+    {
+        phase *= 0.5 / area;
+    }
+
+    const size_t patternCount = static_cast<size_t>(1) << span;
+    table->trajectories.resize(patternCount * p_samplesPerSymbol);
+    for (size_t pattern = 0; pattern < patternCount; ++pattern)
+    {
+        for (unsigned int sampleIdx = 0; sampleIdx < p_samplesPerSymbol; ++sampleIdx)
+        {
+            double phase = 0;
+            for (unsigned int age = 0; age < span; ++age)
+            {
+                double sign = ((pattern >> age) & 1) ? 1.0 : -1.0;
+                phase += sign * phasePulse[age * p_samplesPerSymbol + sampleIdx];
+            }
+            table->trajectories[pattern * p_samplesPerSymbol + sampleIdx] = std::polar(1.0, M_PI * phase);
+        }
+    }
+    return table;
+}
+
+GmskModulator::GmskModulator() : m_quarterTurns(0)
+{
+}
+
+GmskModulator::GmskModulator(std::shared_ptr<const GmskTable> p_table) : m_table(std::move(p_table)), m_quarterTurns(0)
+{
+}
+
+bool GmskModulator::isEnabled() const
+{
+    return m_table != nullptr;
+}
+
+unsigned int GmskModulator::getSamplesPerSymbol() const
+{
+    return m_table->samplesPerSymbol;
+}
+
+size_t GmskModulator::getSymbolCount(const size_t p_bitCount) const
+{
+    return p_bitCount + m_table->span - 1;
+}
+
+void GmskModulator::modulateSymbol(const BitBuffer &p_binaryData, const size_t p_symbolIdx, std::complex<double> *p_envelope)
+{
+    const unsigned int span = m_table->span;
+    const unsigned int samplesPerSymbol = m_table->samplesPerSymbol;
+    size_t pattern = 0;
+    if (p_symbolIdx + 1 >= span && p_symbolIdx < p_binaryData.size())
+    {
+        // Inside the message the last span bits are read at once, the newest one lands in bit 0
+        pattern = p_binaryData.getBits(p_symbolIdx + 1 - span, span);
+    }
+    else
+    {
+        for (unsigned int age = 0; age < span; ++age)
+        {
+            pattern |= static_cast<size_t>(readBit(p_binaryData, static_cast<long>(p_symbolIdx) - age)) << age;
+        }
+    }
+    const std::complex<double> *trajectory = m_table->trajectories.data() + pattern * samplesPerSymbol;
+    for (unsigned int sampleIdx = 0; sampleIdx < samplesPerSymbol; ++sampleIdx)
+    {
+        p_envelope[sampleIdx] = rotateQuarterTurns(trajectory[sampleIdx], m_quarterTurns);
+    }
+
+    // The oldest bit of the pattern is finished after this symbol, its quarter turn joins the accumulated phase
+    m_quarterTurns = (m_quarterTurns + (((pattern >> (span - 1)) & 1) ? 1 : 3)) & 3;
+}
+
+void GmskModulator::seek(const BitBuffer &p_binaryData, const size_t p_symbolIdx)
+{
+    // Symbol j finishes bit j - (span - 1), +1 quarter turn for bit 1 and -1 for bit 0
+    const long span = static_cast<long>(m_table->span);
+    unsigned int quarterTurns = 0;
+    for (size_t symbolIdx = 0; symbolIdx < p_symbolIdx; ++symbolIdx)
+    {
+        quarterTurns += readBit(p_binaryData, static_cast<long>(symbolIdx) - span + 1) ? 1 : 3;
+    }
+    m_quarterTurns = quarterTurns & 3;
+}
+
+std::vector<std::complex<double>> GmskModulator::modulate(const BitBuffer &p_binaryData)
+{
+    const size_t symbolCount = getSymbolCount(p_binaryData.size());
+    std::vector<std::complex<double>> envelope(symbolCount * m_table->samplesPerSymbol);
+    m_quarterTurns = 0;
+    for (size_t symbolIdx = 0; symbolIdx < symbolCount; ++symbolIdx)
+    {
+        modulateSymbol(p_binaryData, symbolIdx, envelope.data() + symbolIdx * m_table->samplesPerSymbol);
+    }
+    return envelope;
+}
+
+GmskDemodulator::GmskDemodulator(std::shared_ptr<const GmskTable> p_table) : m_table(std::move(p_table))
+{
+}
+
+BitBuffer GmskDemodulator::detect(const std::vector<std::complex<double>> &p_envelope, const GmskDetection p_detection) const
+{
+    const size_t symbolCount = p_envelope.size() / m_table->samplesPerSymbol;
+    if (symbolCount < m_table->span)
+    {
+        return BitBuffer();
+    }
+    const size_t bitCount = symbolCount - (m_table->span - 1);
+    if (p_detection == GmskDetection::DIFFERENTIAL)
+    {
+        return detectDifferential(p_envelope, bitCount);
+    }
+    return detectViterbi(p_envelope, symbolCount, bitCount);
+}
+
+void GmskDemodulator::removeImage(std::vector<std::complex<double>> &p_envelope) const
+{
+    if (p_envelope.empty())
+    {
+        return;
+    }
+    const size_t size = getNextPowerOfTwo(p_envelope.size());
+    std::shared_ptr<const FftPlan> plan = FftPlanCache::getInstance().getPlan(size);
+    std::vector<std::complex<double>> spectrum(size);
+    std::copy(p_envelope.begin(), p_envelope.end(), spectrum.begin());
+    plan->forward(spectrum.data());
+
+    // Bin k is k / size cycles per sample, the symbol rate is 1 / samplesPerSymbol
+    const size_t cutoff = static_cast<size_t>(std::ceil(size * GMSK_OCCUPIED_BANDWIDTH / (2 * m_table->samplesPerSymbol)));
+    if (2 * cutoff + 1 >= size)
+    {
+        return;
+    }
+    std::fill(spectrum.begin() + cutoff + 1, spectrum.end() - cutoff, std::complex<double>(0));
+    plan->inverse(spectrum.data());
+    for (size_t sampleIdx = 0; sampleIdx < p_envelope.size(); ++sampleIdx)
+    {
+        p_envelope[sampleIdx] = spectrum[sampleIdx] / static_cast<double>(size);
+    }
+}
+
+BitBuffer GmskDemodulator::detectViterbi(const std::vector<std::complex<double>> &p_envelope, const size_t p_symbolCount,
+                                         const size_t p_bitCount) const
+{
+    const unsigned int span = m_table->span;
+    const unsigned int samplesPerSymbol = m_table->samplesPerSymbol;
+    const size_t patternCount = static_cast<size_t>(1) << span;
+    const size_t historyCount = patternCount / 2;
+    const size_t stateCount = 4 * historyCount;
+
+    // State quarterTurns * historyCount + history, history holds the last span - 1 bits, the newest in bit 0
+    std::vector<double> metrics(stateCount, -HUGE_VAL);
+    std::vector<double> nextMetrics(stateCount);
+    metrics[0] = 0;
+    // The bit dropped from the history on the way to every state, enough to walk back to the previous state
+    std::vector<uint8_t> droppedBits(p_symbolCount * stateCount);
+    std::vector<std::complex<double>> correlations(patternCount);
+
+    for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+    {
+        const std::complex<double> *received = p_envelope.data() + symbolIdx * samplesPerSymbol;
+        for (size_t pattern = 0; pattern < patternCount; ++pattern)
+        {
+            const std::complex<double> *trajectory = m_table->trajectories.data() + pattern * samplesPerSymbol;
+            std::complex<double> sum = 0;
+            for (unsigned int sampleIdx = 0; sampleIdx < samplesPerSymbol; ++sampleIdx)
+            {
+                sum += received[sampleIdx] * std::conj(trajectory[sampleIdx]);
+            }
+            correlations[pattern] = sum;
+        }
+
+        std::fill(nextMetrics.begin(), nextMetrics.end(), -HUGE_VAL);
+        uint8_t *dropped = droppedBits.data() + symbolIdx * stateCount;
+        // The flush symbols only carry 0 bits
+        const unsigned int lastBit = (symbolIdx < p_bitCount) ? 1 : 0;
+        for (size_t state = 0; state < stateCount; ++state)
+        {
+            if (metrics[state] == -HUGE_VAL)
+            {
+                continue;
+            }
+            const unsigned int quarterTurns = static_cast<unsigned int>(state / historyCount);
+            const size_t history = state % historyCount;
+            for (unsigned int bit = 0; bit <= lastBit; ++bit)
+            {
+                size_t pattern = ((history << 1) | bit) & (patternCount - 1);
+                // Re(c * conj(j^q)) with conj(j^q) = j^(4 - q)
+                double metric = metrics[state] + rotateQuarterTurns(correlations[pattern], 4 - quarterTurns).real();
+                unsigned int oldestBit = static_cast<unsigned int>(pattern >> (span - 1)) & 1;
+                size_t nextState = ((quarterTurns + (oldestBit ? 1 : 3)) & 3) * historyCount + (pattern & (historyCount - 1));
+                if (metric > nextMetrics[nextState])
+                {
+                    nextMetrics[nextState] = metric;
+                    dropped[nextState] = static_cast<uint8_t>(oldestBit);
+                }
+            }
+        }
+        metrics.swap(nextMetrics);
+    }
+
+    size_t state = static_cast<size_t>(std::max_element(metrics.begin(), metrics.end()) - metrics.begin());
+    BitBuffer outputBinary;
+    outputBinary.resize(p_symbolCount);
+    for (size_t symbolIdx = p_symbolCount; symbolIdx-- > 0;)
+    {
+        const unsigned int quarterTurns = static_cast<unsigned int>(state / historyCount);
+        const size_t history = state % historyCount;
+        outputBinary.setBit(symbolIdx, history & 1);
+        unsigned int oldestBit = droppedBits[symbolIdx * stateCount + state];
+        size_t previousHistory = (history >> 1) | (static_cast<size_t>(oldestBit) << (span - 2));
+        state = ((quarterTurns + (oldestBit ? 3 : 1)) & 3) * historyCount + previousHistory;
+    }
+    outputBinary.resize(p_bitCount);
+    return outputBinary;
+}
+
+BitBuffer GmskDemodulator::detectDifferential(const std::vector<std::complex<double>> &p_envelope, const size_t p_bitCount) const
+{
+    const unsigned int samplesPerSymbol = m_table->samplesPerSymbol;
+    BitBuffer outputBinary;
+    outputBinary.reserve(p_bitCount);
+    for (size_t bitIdx = 0; bitIdx < p_bitCount; ++bitIdx)
+    {
+        // The pulse of a bit is centered span / 2 symbols after it starts, its phase step is the phase change
+        // between the symbols on both sides of the center
+        size_t center = bitIdx * samplesPerSymbol + m_table->span * samplesPerSymbol / 2;
+        std::complex<double> before = 0;
+        std::complex<double> after = 0;
+        for (unsigned int sampleIdx = 0; sampleIdx < samplesPerSymbol; ++sampleIdx)
+        {
+            before += p_envelope[center - samplesPerSymbol + sampleIdx];
+            after += p_envelope[std::min(center + sampleIdx, p_envelope.size() - 1)];
+        }
+        outputBinary.pushBits(((after * std::conj(before)).imag() > 0) ? 1 : 0, 1);
+    }
+    return outputBinary;
+}
@@ -0,0 +1,466 @@
+#include "modulationSession.h"
+#include "modulator.h"
+#include "simdKernels.h"
+#include <algorithm>
+#include <type_traits>
+
+namespace
+{
+    const std::vector<double> &getInPhase(const SymbolTone &p_tone, double)
+    {
+        return p_tone.inPhase;
+    }
+
+    const std::vector<float> &getInPhase(const SymbolTone &p_tone, float)
+    {
+        return p_tone.inPhaseFloat;
+    }
+
+    const std::vector<double> &getQuadrature(const SymbolTone &p_tone, double)
+    {
+        return p_tone.quadrature;
+    }
+
+    const std::vector<float> &getQuadrature(const SymbolTone &p_tone, float)
+    {
+        return p_tone.quadratureFloat;
+    }
+
+    const std::vector<double> &getWaveform(const WaveformTemplate &p_template, unsigned int p_symbol, double)
+    {
+        return p_template.waveforms[p_symbol];
+    }
+
+    const std::vector<float> &getWaveform(const WaveformTemplate &p_template, unsigned int p_symbol, float)
+    {
+        return p_template.waveformsFloat[p_symbol];
+    }
+
+    const std::vector<int16_t> &getInPhase(const SymbolTone &p_tone, int16_t)
+    {
+        return p_tone.inPhaseQ15;
+    }
+
+    const std::vector<int16_t> &getQuadrature(const SymbolTone &p_tone, int16_t)
+    {
+        return p_tone.quadratureQ15;
+    }
+
+    const std::vector<int16_t> &getWaveform(const WaveformTemplate &p_template, unsigned int p_symbol, int16_t)
+    {
+        return p_template.waveformsFixed[p_symbol];
+    }
+}
+
+ModulationSession::ModulationSession()
+    : m_isContinuous(false), m_isStreamEnded(false), m_bitsPerSymbol(1), m_samplesPerSymbol(0), m_symbolCount(0),
+      m_firstSymbol(0), m_symbolIdx(0), m_sampleOffset(0), m_isNoisy(false), m_arithmetic(Arithmetic::FLOATING_POINT), m_seed(0)
+{
+}
+
+ModulationSession::ModulationSession(std::shared_ptr<const WaveformTemplate> p_template, const BitBuffer &p_binaryData,
+                                     const unsigned int p_bitsPerSymbol, const bool p_isNoisy)
+    : m_template(std::move(p_template)), m_isContinuous(false), m_isStreamEnded(false), m_binaryInput(p_binaryData),
+      m_bitsPerSymbol(p_bitsPerSymbol), m_samplesPerSymbol(m_template->samplesPerSymbol), m_symbolCount(p_binaryData.size() / p_bitsPerSymbol), m_firstSymbol(0),
+      m_symbolIdx(0), m_sampleOffset(0), m_isNoisy(p_isNoisy), m_arithmetic(Arithmetic::FLOATING_POINT), m_seed(std::random_device()()), m_noise(0.0, NOISE_LEVEL)
+{
+    seedNoise(0);
+    for (const SymbolTone &tone : m_template->tones)
+    {
+        m_symbolClocks.emplace_back(tone.frequency * m_template->samplesPerSymbol, m_template->sampleRate, m_template->initialPhase);
+    }
+}
+
+ModulationSession::ModulationSession(PulseShaper p_shaper, std::vector<std::complex<double>> p_points,
+                                     const BitBuffer &p_binaryData, const unsigned int p_bitsPerSymbol,
+                                     const unsigned int p_samplesPerSymbol, const Oscillator &p_carrier, const bool p_isNoisy)
+    : m_shaper(std::move(p_shaper)), m_points(std::move(p_points)), m_carrier(p_carrier), m_envelope(p_samplesPerSymbol),
+      m_windowI(m_shaper.getSpan()), m_windowQ(m_shaper.getSpan()), m_isContinuous(false), m_isStreamEnded(false),
+      m_binaryInput(p_binaryData), m_bitsPerSymbol(p_bitsPerSymbol), m_samplesPerSymbol(p_samplesPerSymbol),
+      m_symbolCount(p_binaryData.size() / p_bitsPerSymbol), m_firstSymbol(0), m_symbolIdx(0), m_sampleOffset(0),
+      m_isNoisy(p_isNoisy), m_arithmetic(Arithmetic::FLOATING_POINT), m_seed(std::random_device()()), m_noise(0.0, NOISE_LEVEL)
+{
+    seedNoise(0);
+}
+
+ModulationSession::ModulationSession(std::shared_ptr<const OfdmEngine> p_engine, std::vector<std::complex<double>> p_points,
+                                     const BitBuffer &p_binaryData, const unsigned int p_bitsPerSymbol, const bool p_isNoisy)
+    : m_points(std::move(p_points)), m_ofdm(std::move(p_engine)), m_envelope(m_ofdm->getSymbolLength()),
+      m_ofdmPoints(m_ofdm->getSubcarriers()), m_isContinuous(false), m_isStreamEnded(false), m_binaryInput(p_binaryData),
+      m_bitsPerSymbol(p_bitsPerSymbol), m_samplesPerSymbol(m_ofdm->getSymbolLength()),
+      m_symbolCount(m_ofdm->getSymbolCount(p_binaryData.size() / p_bitsPerSymbol)), m_firstSymbol(0), m_symbolIdx(0),
+      m_sampleOffset(0), m_isNoisy(p_isNoisy), m_arithmetic(Arithmetic::FLOATING_POINT), m_seed(std::random_device()()), m_noise(0.0, NOISE_LEVEL)
+{
+    seedNoise(0);
+}
+
+ModulationSession::ModulationSession(std::shared_ptr<const OfdmEngine> p_engine, std::vector<std::complex<double>> p_elements,
+                                     const bool p_isNoisy)
+    : m_points(std::move(p_elements)), m_ofdm(std::move(p_engine)), m_envelope(m_ofdm->getSymbolLength()),
+      m_isContinuous(false), m_isStreamEnded(false), m_bitsPerSymbol(0), m_samplesPerSymbol(m_ofdm->getSymbolLength()),
+      m_symbolCount(m_ofdm->getSymbolCount(m_points.size())),
+      m_firstSymbol(0), m_symbolIdx(0), m_sampleOffset(0), m_isNoisy(p_isNoisy), m_arithmetic(Arithmetic::FLOATING_POINT), m_seed(std::random_device()()), m_noise(0.0, NOISE_LEVEL)
+{
+    seedNoise(0);
+}
+
+ModulationSession::ModulationSession(GmskModulator p_gmsk, const BitBuffer &p_binaryData, const Oscillator &p_carrier,
+                                     const bool p_isNoisy)
+    : m_carrier(p_carrier), m_gmsk(std::move(p_gmsk)), m_envelope(m_gmsk.getSamplesPerSymbol()), m_isContinuous(false),
+      m_isStreamEnded(false), m_binaryInput(p_binaryData),
+      m_bitsPerSymbol(1), m_samplesPerSymbol(m_gmsk.getSamplesPerSymbol()), m_symbolCount(m_gmsk.getSymbolCount(p_binaryData.size())),
+      m_firstSymbol(0), m_symbolIdx(0), m_sampleOffset(0), m_isNoisy(p_isNoisy), m_arithmetic(Arithmetic::FLOATING_POINT), m_seed(std::random_device()()), m_noise(0.0, NOISE_LEVEL)
+{
+    seedNoise(0);
+}
+
+template <typename T>
+size_t ModulationSession::produce(T *p_signal, const size_t p_count)
+{
+    using ComputeType = typename SampleTraits<T>::ComputeType;
+    if constexpr (std::is_same_v<T, ComputeType>)
+    {
+        size_t produced = render(p_signal, p_count);
+        addNoise(p_signal, produced);
+        return produced;
+    }
+    else
+    {
+        static_assert(std::is_same_v<ComputeType, float>, "integer samples are staged in single precision");
+        if (m_arithmetic == Arithmetic::FIXED_POINT && m_template)
+        {
+            // Template symbols are mixed straight into int16 by the fixed-point kernel, nothing is staged
+            size_t produced = render(p_signal, p_count);
+            addNoise(p_signal, produced);
+            return produced;
+        }
+        // Samples are generated in floating point and quantized one staging buffer at a time
+        m_scratch.resize(MODULATION_CHUNK_SIZE);
+        size_t produced = 0;
+        while (produced < p_count)
+        {
+            size_t count = render(m_scratch.data(), std::min(p_count - produced, m_scratch.size()));
+            if (count == 0)
+            {
+                break;
+            }
+            addNoise(m_scratch.data(), count);
+            for (size_t sampleIdx = 0; sampleIdx < count; ++sampleIdx)
+            {
+                p_signal[produced + sampleIdx] = SampleTraits<T>::fromDouble(m_scratch[sampleIdx]);
+            }
+            produced += count;
+        }
+        return produced;
+    }
+}
+
+void ModulationSession::restart(const BitBuffer &p_binaryData)
+{
+    m_isStreamEnded = false;
+    std::fill(m_history.begin(), m_history.end(), 0);
+    m_binaryInput = p_binaryData;
+    m_symbolCount = countSymbols();
+    m_firstSymbol = 0;
+    m_symbolIdx = 0;
+    m_sampleOffset = 0;
+    m_carrier.reset();
+    for (Oscillator &clock : m_symbolClocks)
+    {
+        clock.reset();
+    }
+    if (m_gmsk.isEnabled())
+    {
+        m_gmsk.seek(m_binaryInput, 0);
+    }
+}
+
+void ModulationSession::seek(const size_t p_symbolIdx)
+{
+    m_symbolIdx = p_symbolIdx;
+    m_sampleOffset = 0;
+    m_carrier.reset();
+    m_carrier.skip(static_cast<uint64_t>(p_symbolIdx) * m_samplesPerSymbol);
+    for (Oscillator &clock : m_symbolClocks)
+    {
+        clock.reset();
+        clock.skip(p_symbolIdx);
+    }
+    if (m_gmsk.isEnabled())
+    {
+        m_gmsk.seek(m_binaryInput, p_symbolIdx);
+    }
+    seedNoise(p_symbolIdx);
+}
+
+void ModulationSession::seedNoise(const size_t p_symbolIdx)
+{
+    // Mixing the symbol into the seed sequence keeps the generators of neighbouring ranges uncorrelated
+    std::seed_seq seeds{static_cast<size_t>(m_seed), p_symbolIdx};
+    m_generator.seed(seeds);
+    m_noise.reset();
+}
+
+void ModulationSession::setArithmetic(const Arithmetic p_arithmetic)
+{
+    m_arithmetic = p_arithmetic;
+}
+
+size_t ModulationSession::getSymbolCount() const
+{
+    return m_symbolCount;
+}
+
+unsigned int ModulationSession::getSamplesPerSymbol() const
+{
+    return m_samplesPerSymbol;
+}
+
+void ModulationSession::append(const BitBuffer &p_binaryData)
+{
+    if (m_isContinuous)
+    {
+        // Keep the last points of the stream for the windows of the first symbols of the new message
+        const long historySize = static_cast<long>(m_history.size());
+        std::vector<std::complex<double>> history(m_history.size());
+        for (long historyIdx = 0; historyIdx < historySize; ++historyIdx)
+        {
+            history[historyIdx] = getWindowPoint(static_cast<long>(m_symbolCount) - historySize + historyIdx);
+        }
+        m_history = std::move(history);
+    }
+    m_firstSymbol += m_symbolCount;
+    m_binaryInput = p_binaryData;
+    m_symbolCount = countSymbols();
+    m_symbolIdx = 0;
+    m_sampleOffset = 0;
+}
+
+void ModulationSession::setContinuous()
+{
+    if (m_shaper.isEnabled())
+    {
+        m_isContinuous = true;
+        m_history.assign(m_shaper.getSpan() - 1, 0);
+    }
+}
+
+void ModulationSession::endStream()
+{
+    if (!m_isContinuous || m_isStreamEnded)
+    {
+        return;
+    }
+    append(BitBuffer());
+    // The last pulse ends span / 2 symbols after the last symbol, the delay of the stream
+    m_symbolCount = m_shaper.getWindowOffset() + m_shaper.getSpan() - 1;
+    m_isStreamEnded = true;
+}
+
+size_t ModulationSession::getTotalSamples() const
+{
+    return m_symbolCount * m_samplesPerSymbol;
+}
+
+size_t ModulationSession::getProducedSamples() const
+{
+    return m_symbolIdx * m_samplesPerSymbol + m_sampleOffset;
+}
+
+bool ModulationSession::isFinished() const
+{
+    return m_symbolIdx >= m_symbolCount;
+}
+
+unsigned int ModulationSession::readSymbol(const size_t p_symbolIdx) const
+{
+    return m_binaryInput.getBits(p_symbolIdx * m_bitsPerSymbol, m_bitsPerSymbol);
+}
+
+const std::complex<double> &ModulationSession::getWindowPoint(long p_symbolIdx) const
+{
+    static const std::complex<double> silence = 0;
+    if (!m_isContinuous)
+    {
+        // Tail biting, the pulses wrap around the message
+        const long symbolCount = static_cast<long>(m_symbolCount);
+        p_symbolIdx %= symbolCount;
+        return m_points[readSymbol((p_symbolIdx < 0) ? p_symbolIdx + symbolCount : p_symbolIdx)];
+    }
+    if (p_symbolIdx < 0)
+    {
+        return m_history[m_history.size() + p_symbolIdx];
+    }
+    return m_isStreamEnded ? silence : m_points[readSymbol(p_symbolIdx)];
+}
+
+size_t ModulationSession::countSymbols() const
+{
+    if (m_ofdm)
+    {
+        return m_ofdm->getSymbolCount(m_binaryInput.size() / m_bitsPerSymbol);
+    }
+    if (m_gmsk.isEnabled())
+    {
+        return m_gmsk.getSymbolCount(m_binaryInput.size());
+    }
+    return m_binaryInput.size() / m_bitsPerSymbol;
+}
+
+template <typename C>
+size_t ModulationSession::render(C *p_signal, const size_t p_count)
+{
+    size_t produced = 0;
+    while (produced < p_count && m_symbolIdx < m_symbolCount)
+    {
+        unsigned int count = static_cast<unsigned int>(
+            std::min<size_t>(p_count - produced, m_samplesPerSymbol - m_sampleOffset));
+        if (m_ofdm)
+        {
+            renderOfdmSymbol(p_signal + produced, count);
+        }
+        else if (m_gmsk.isEnabled())
+        {
+            renderGmskSymbol(p_signal + produced, count);
+        }
+        else if (m_shaper.isEnabled())
+        {
+            renderShapedSymbol(p_signal + produced, count);
+        }
+        else
+        {
+            renderSymbol(p_signal + produced, count);
+        }
+        produced += count;
+        m_sampleOffset += count;
+        if (m_sampleOffset == m_samplesPerSymbol)
+        {
+            m_sampleOffset = 0;
+            ++m_symbolIdx;
+            for (Oscillator &clock : m_symbolClocks)
+            {
+                clock.next();
+            }
+        }
+    }
+    return produced;
+}
+
+template <typename C>
+void ModulationSession::renderSymbol(C *p_signal, const unsigned int p_count)
+{
+    unsigned int symbol = readSymbol(m_symbolIdx);
+    const SymbolShape &shape = m_template->alphabet[symbol];
+    const SymbolTone &tone = m_template->tones[shape.tone];
+    if (!m_template->waveforms[symbol].empty())
+    {
+        const C *samples = getWaveform(*m_template, symbol, C()).data() + m_sampleOffset;
+        std::copy(samples, samples + p_count, p_signal);
+    }
+    else
+    {
+        // Rotate the tone basis to the phase the tone has reached at this symbol
+        const std::complex<double> &start = m_symbolClocks[shape.tone].value();
+        SimdKernels::getInstance().combine(p_signal, p_count, getInPhase(tone, C()).data() + m_sampleOffset,
+                                           getQuadrature(tone, C()).data() + m_sampleOffset,
+                                           SampleTraits<C>::fromDouble(shape.inPhaseGain * start.real() + shape.quadratureGain * start.imag()),
+                                           SampleTraits<C>::fromDouble(shape.quadratureGain * start.real() - shape.inPhaseGain * start.imag()));
+    }
+}
+
+template <typename C>
+void ModulationSession::renderShapedSymbol(C *p_signal, const unsigned int p_count)
+{
+    if (m_sampleOffset == 0)
+    {
+        // Gather the symbols the pulses overlapping this symbol belong to, a continuous stream is delayed until
+        // the last of them is known
+        const unsigned int span = m_shaper.getSpan();
+        long firstSymbol = static_cast<long>(m_symbolIdx) + m_shaper.getWindowOffset();
+        if (m_isContinuous)
+        {
+            firstSymbol = static_cast<long>(m_symbolIdx) - static_cast<long>(span) + 1;
+        }
+        for (unsigned int windowIdx = 0; windowIdx < span; ++windowIdx)
+        {
+            const std::complex<double> &point = getWindowPoint(firstSymbol + windowIdx);
+            m_windowI[windowIdx] = point.real();
+            m_windowQ[windowIdx] = point.imag();
+        }
+        m_shaper.shapeSymbol(m_windowI.data(), m_windowQ.data(), m_envelope.data());
+    }
+    for (unsigned int sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+    {
+        // Re(envelope * carrier) = I * cos - Q * sin
+        const std::complex<double> &envelope = m_envelope[m_sampleOffset + sampleIdx];
+        std::complex<double> carrier = m_carrier.next();
+        p_signal[sampleIdx] = static_cast<C>(envelope.real() * carrier.real() - envelope.imag() * carrier.imag());
+    }
+}
+
+template <typename C>
+void ModulationSession::renderOfdmSymbol(C *p_signal, const unsigned int p_count)
+{
+    if (m_sampleOffset == 0 && m_bitsPerSymbol == 0)
+    {
+        // The resource grid is mapped already, null elements keep their subcarrier silent
+        const size_t firstElement = m_symbolIdx * m_ofdm->getSubcarriers();
+        m_ofdm->modulateSymbol(m_points.data() + firstElement, m_ofdm->getSubcarriers(), m_firstSymbol + m_symbolIdx,
+                               m_envelope.data());
+    }
+    else if (m_sampleOffset == 0)
+    {
+        const size_t pointCount = m_binaryInput.size() / m_bitsPerSymbol;
+        const size_t firstPoint = m_symbolIdx * m_ofdm->getSubcarriers();
+        const size_t count = std::min<size_t>(m_ofdmPoints.size(), pointCount - firstPoint);
+        for (size_t pointIdx = 0; pointIdx < count; ++pointIdx)
+        {
+            m_ofdmPoints[pointIdx] = m_points[readSymbol(firstPoint + pointIdx)];
+        }
+        m_ofdm->modulateSymbol(m_ofdmPoints.data(), count, m_firstSymbol + m_symbolIdx, m_envelope.data());
+    }
+    for (unsigned int sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+    {
+        p_signal[sampleIdx] = static_cast<C>(m_envelope[m_sampleOffset + sampleIdx].real());
+    }
+}
+
+template <typename C>
+void ModulationSession::renderGmskSymbol(C *p_signal, const unsigned int p_count)
+{
+    if (m_sampleOffset == 0)
+    {
+        m_gmsk.modulateSymbol(m_binaryInput, m_symbolIdx, m_envelope.data());
+    }
+    for (unsigned int sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+    {
+        const std::complex<double> &envelope = m_envelope[m_sampleOffset + sampleIdx];
+        std::complex<double> carrier = m_carrier.next();
+        p_signal[sampleIdx] = static_cast<C>(envelope.real() * carrier.real() - envelope.imag() * carrier.imag());
+    }
+}
+
+template <typename C>
+void ModulationSession::addNoise(C *p_signal, const size_t p_count)
+{
+    if (!m_isNoisy)
+    {
+        return;
+    }
+    for (size_t sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+    {
+        if constexpr (std::is_integral_v<C>)
+        {
+            // Fixed-point samples saturate instead of wrapping around
+            p_signal[sampleIdx] = SampleTraits<C>::fromDouble(SampleTraits<C>::toDouble(p_signal[sampleIdx]) + m_noise(m_generator));
+        }
+        else
+        {
+            p_signal[sampleIdx] += static_cast<C>(m_noise(m_generator));
+        }
+    }
+}
+
+template size_t ModulationSession::produce<double>(double *p_signal, const size_t p_count);
+template size_t ModulationSession::produce<float>(float *p_signal, const size_t p_count);
+template size_t ModulationSession::produce<int16_t>(int16_t *p_signal, const size_t p_count);
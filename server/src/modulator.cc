@@ -1,394 +1,1588 @@
 #include "modulator.h"
+#include "oscillator.h"
+#include "simdKernels.h"
+#include "waveformCache.h"
+#include "modulationSession.h"
 #include "serverCommon.h"
 #include <random>
 #include <stdexcept>
 
-Modulator::Modulator()
+namespace
+{
+    template <typename T>
+    void measureSamples(const T *p_signal, const size_t p_count, LinkStatistics &p_statistics)
+    {
+        for (size_t sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+        {
+            double value = SampleTraits<T>::toDouble(p_signal[sampleIdx]);
+            p_statistics.energy += value * value;
+            p_statistics.peakAmplitude = std::max(p_statistics.peakAmplitude, std::abs(value));
+        }
+        p_statistics.sampleCount += p_count;
+        ++p_statistics.tileCount;
+    }
+
+    /**
+     * @brief Correlate consecutive symbols against the cosine and sine basis of a tone
+     *
+     * @param p_kernels - the selected SIMD kernels
+     * @param p_signal - the samples of the symbols
+     * @param p_symbolLength - the amount of samples of every symbol, at most the length of the basis
+     * @param p_symbolCount - the amount of symbols
+     * @param p_tone - the basis of the tone, starting at phase 0
+     * @param p_inPhaseSums - the sum of x * cos of every symbol
+     * @param p_quadratureSums - the sum of x * sin of every symbol
+     */
+    void correlateTone(const SimdKernels &p_kernels, const double *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                       const SymbolTone &p_tone, double *p_inPhaseSums, double *p_quadratureSums)
+    {
+        p_kernels.correlate(p_signal, p_symbolLength, p_symbolCount, p_tone.inPhase.data(), p_tone.quadrature.data(), p_inPhaseSums,
+                            p_quadratureSums);
+    }
+
+    void correlateTone(const SimdKernels &p_kernels, const float *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                       const SymbolTone &p_tone, double *p_inPhaseSums, double *p_quadratureSums)
+    {
+        p_kernels.correlate(p_signal, p_symbolLength, p_symbolCount, p_tone.inPhaseFloat.data(), p_tone.quadratureFloat.data(),
+                            p_inPhaseSums, p_quadratureSums);
+    }
+
+    void correlateTone(const SimdKernels &p_kernels, const int16_t *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                       const SymbolTone &p_tone, double *p_inPhaseSums, double *p_quadratureSums)
+    {
+        p_kernels.correlate(p_signal, p_symbolLength, p_symbolCount, p_tone.inPhaseQ15.data(), p_tone.quadratureQ15.data(),
+                            p_inPhaseSums, p_quadratureSums);
+        // The integer sums are in units of one sample step (1 / INT16_SAMPLE_SCALE) times one Q15 step
+        const double sumScale = 1.0 / (INT16_SAMPLE_SCALE * Q15_SCALE);
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            p_inPhaseSums[symbolIdx] *= sumScale;
+            p_quadratureSums[symbolIdx] *= sumScale;
+        }
+    }
+
+    /**
+     * @brief Sum the magnitude of the samples of consecutive symbols, int16 samples are summed as integers
+     *
+     * @param p_kernels - the selected SIMD kernels
+     * @param p_signal - the samples of the symbols
+     * @param p_symbolLength - the amount of samples of every symbol
+     * @param p_symbolCount - the amount of symbols
+     * @param p_envelopes - the envelope of every symbol
+     */
+    template <typename T>
+    void sumEnvelopes(const SimdKernels &p_kernels, const T *p_signal, size_t p_symbolLength, size_t p_symbolCount, double *p_envelopes)
+    {
+        p_kernels.sumEnvelopes(p_signal, p_symbolLength, p_symbolCount, p_envelopes);
+        if constexpr (std::is_same_v<T, int16_t>)
+        {
+            for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+            {
+                p_envelopes[symbolIdx] /= INT16_SAMPLE_SCALE;
+            }
+        }
+    }
+}
+
+Modulator::Modulator() : m_arithmetic(Arithmetic::FLOATING_POINT), m_fskDetection(FskDetection::CORRELATOR), m_isNoisy(true),
+      m_trigMode(TrigMode::LIBM)
 {
     readDatabase();
 }
 
-Modulator::Modulator(const double p_carrierFrequency, const std::string &p_binaryData) : Modulator()
+Modulator::Modulator(const double p_carrierFrequency, const BitBuffer &p_binaryData) : Modulator()
 {
-    m_carrierFrequency = p_carrierFrequency;
+    setFrequency(p_carrierFrequency);
     m_binaryInput = p_binaryData;
-    m_bitRate = p_carrierFrequency;
-    m_samplesPerBit = m_sampleRate / m_bitRate;
 }
 
 void Modulator::readDatabase()
 {
+    float askZeroSign, askOneSign, pskZeroSign, pskOneSign, fskZeroSign, fskOneSign;
     auto floatValue = InMemDatabase::getInstance().getValue(ASK_ZERO_SIGN_KEY);
-    extractValue(floatValue, m_askZeroSign);
+    extractValue(floatValue, askZeroSign);
     floatValue = InMemDatabase::getInstance().getValue(ASK_ONE_SIGN_KEY);
-    extractValue(floatValue, m_askOneSign);
+    extractValue(floatValue, askOneSign);
     floatValue = InMemDatabase::getInstance().getValue(PSK_ZERO_SIGN_KEY);
-    extractValue(floatValue, m_pskZeroSign);
-    m_pskZeroSign = m_pskZeroSign * M_PI / 180;
+    extractValue(floatValue, pskZeroSign);
     floatValue = InMemDatabase::getInstance().getValue(PSK_ONE_SIGN_KEY);
-    extractValue(floatValue, m_pskOneSign);
-    m_pskOneSign = m_pskOneSign * M_PI / 180;
+    extractValue(floatValue, pskOneSign);
     floatValue = InMemDatabase::getInstance().getValue(FSK_ZERO_SIGN_KEY);
-    extractValue(floatValue, m_fskZeroSign);
+    extractValue(floatValue, fskZeroSign);
     floatValue = InMemDatabase::getInstance().getValue(FSK_ONE_SIGN_KEY);
-    extractValue(floatValue, m_fskOneSign);
+    extractValue(floatValue, fskOneSign);
+    m_basebandSamplesPerSymbol = readBasebandSamplesPerSymbol();
+    m_basebandSymbolLength = m_basebandSamplesPerSymbol;
+
+    // The PSK phases are stored in degree, the policies only need their phasors
+    m_parameters.askZeroSign = askZeroSign;
+    m_parameters.askOneSign = askOneSign;
+    m_parameters.pskZeroShift = std::polar(1.0, static_cast<double>(pskZeroSign) * M_PI / 180);
+    m_parameters.pskOneShift = std::polar(1.0, static_cast<double>(pskOneSign) * M_PI / 180);
+    m_parameters.fskZeroSign = fskZeroSign;
+    m_parameters.fskOneSign = fskOneSign;
+    m_outputRate = readSampleRate();
+    readSymbolTiming();
+    readPulseShaping();
+    readOfdm();
+    readGmsk();
+    readFskDetection();
+    readThreadCount();
+    readTrigMode();
+    m_carrierFrequency = DEFAULT_FREQUENCY_INDEX;
+    m_samplesPerBit = 0;
+    m_sampleRate = m_outputRate;
+}
+
+int Modulator::readSampleRate()
+{
     const char *sampleChar = "";
     auto intValue = InMemDatabase::getInstance().getValue(SAMPLE_RATE_KEY);
     extractValue<char const *>(intValue, sampleChar);
-    m_sampleRate = std::stoi(std::string(sampleChar));
+    return std::stoi(std::string(sampleChar));
 }
 
 void Modulator::setFrequency(const double &p_frequency)
 {
+    // /fs and the symbol timing may have been rewritten from the server CLI since the last request
+    int outputRate = readSampleRate();
+    double symbolRate = m_symbolRate;
+    unsigned int oversampling = m_oversampling;
+    readSymbolTiming();
+    if (outputRate != m_outputRate || symbolRate != m_symbolRate || oversampling != m_oversampling)
+    {
+        m_outputRate = outputRate;
+        WaveformCache::getInstance().invalidate();
+    }
+    m_basebandSamplesPerSymbol = readBasebandSamplesPerSymbol();
+    m_basebandSymbolLength = m_basebandSamplesPerSymbol;
+    readPulseShaping();
+    readOfdm();
+    readGmsk();
+    readFskDetection();
+    readThreadCount();
+    readTrigMode();
     m_carrierFrequency = p_frequency;
-    m_bitRate = p_frequency;
-    m_samplesPerBit = m_sampleRate / m_bitRate;
 }
 
-void Modulator::setBinaryInput(const std::string &p_binaryData)
+void Modulator::readSymbolTiming()
 {
-    m_binaryInput = p_binaryData;
+    float symbolRate = 0;
+    unsigned long oversampling = 0;
+    try
+    {
+        auto var = InMemDatabase::getInstance().getValue(SYMBOL_RATE_KEY);
+        extractValue<float>(var, symbolRate);
+    }
+    catch (const DBException &e)
+    {
+        symbolRate = 0;
+    }
+    try
+    {
+        auto var = InMemDatabase::getInstance().getValue(OVERSAMPLING_KEY);
+        extractValue<unsigned long>(var, oversampling);
+    }
+    catch (const DBException &e)
+    {
+        oversampling = 0;
+    }
+    m_symbolRate = symbolRate;
+    m_oversampling = oversampling;
 }
 
-double Modulator::getSignalValue(const double &p_amplitudeIndex, const double &p_frequencyIndex, const double &p_time, const double &p_phase)
+void Modulator::readPulseShaping()
 {
-    double amplitude = p_amplitudeIndex * CARRIER_AMPLITUDE;
-    double frequency = p_frequencyIndex * m_carrierFrequency;
-    return amplitude * cos(2 * M_PI * frequency * p_time + p_phase);
+    m_pulseShaping = {PulseShape::RECTANGULAR, 0.0, DEFAULT_PULSE_SPAN};
+    try
+    {
+        const char *shape = "";
+        auto var = InMemDatabase::getInstance().getValue(PULSE_SHAPE_KEY);
+        extractValue<char const *>(var, shape);
+        if (std::string(shape) == "rrc")
+        {
+            m_pulseShaping.shape = PulseShape::ROOT_RAISED_COSINE;
+        }
+        else if (std::string(shape) == "gaussian")
+        {
+            m_pulseShaping.shape = PulseShape::GAUSSIAN;
+        }
+    }
+    catch (const DBException &e)
+    {
+        return;
+    }
+
+    float factor = 0;
+    bool isGaussian = (m_pulseShaping.shape == PulseShape::GAUSSIAN);
+    try
+    {
+        auto var = InMemDatabase::getInstance().getValue(isGaussian ? PULSE_BANDWIDTH_TIME_KEY : PULSE_ROLLOFF_KEY);
+        extractValue<float>(var, factor);
+    }
+    catch (const DBException &e)
+    {
+        factor = -1;
+    }
+    // A roll-off is in [0, 1], a BT must be positive, fall back to the defaults otherwise
+    bool isValid = isGaussian ? factor > 0 : (factor >= 0 && factor <= 1);
+    m_pulseShaping.factor = isValid ? factor : (isGaussian ? DEFAULT_PULSE_BANDWIDTH_TIME : DEFAULT_PULSE_ROLLOFF);
+
+    try
+    {
+        unsigned long span = 0;
+        auto var = InMemDatabase::getInstance().getValue(PULSE_SPAN_KEY);
+        extractValue<unsigned long>(var, span);
+        // The pulse peak sits between two halves of whole symbols
+        m_pulseShaping.span = (span > 0) ? static_cast<unsigned int>(span + span % 2) : DEFAULT_PULSE_SPAN;
+    }
+    catch (const DBException &e)
+    {
+        m_pulseShaping.span = DEFAULT_PULSE_SPAN;
+    }
 }
 
-void Modulator::addNoise(std::vector<double> &p_signal)
+void Modulator::readOfdm()
 {
-    std::default_random_engine generator(time(0));
-    std::normal_distribution<double> distribution(0.0, NOISE_LEVEL);
-    for (size_t i = 0; i < p_signal.size(); i++)
+    m_ofdm = {0, DEFAULT_OFDM_CYCLIC_PREFIX};
+    try
+    {
+        unsigned long subcarriers = 0;
+        auto var = InMemDatabase::getInstance().getValue(OFDM_SUBCARRIERS_KEY);
+        extractValue<unsigned long>(var, subcarriers);
+        m_ofdm.subcarriers = static_cast<unsigned int>(subcarriers);
+    }
+    catch (const DBException &e)
     {
-        p_signal[i] += distribution(generator);
+        return;
+    }
+    try
+    {
+        float cyclicPrefix = 0;
+        auto var = InMemDatabase::getInstance().getValue(OFDM_CYCLIC_PREFIX_KEY);
+        extractValue<float>(var, cyclicPrefix);
+        if (cyclicPrefix >= 0 && cyclicPrefix < 1)
+        {
+            m_ofdm.cyclicPrefix = cyclicPrefix;
+        }
+    }
+    catch (const DBException &e)
+    {
+        m_ofdm.cyclicPrefix = DEFAULT_OFDM_CYCLIC_PREFIX;
     }
 }
 
-std::vector<double> Modulator::askModulation()
+void Modulator::readGmsk()
 {
-    std::vector<double> signal;
-    double symbolDuration = 1.0 / m_sampleRate;
-
-    double time = 0.0; // Time variable
-    for (size_t bitIdx = 0; bitIdx < m_binaryInput.size(); ++bitIdx)
+    m_gmsk = {DEFAULT_GMSK_BANDWIDTH_TIME, GmskDetection::VITERBI};
+    try
     {
-        double amplitudeIndex = (m_binaryInput[bitIdx] == '1') ? m_askOneSign : m_askZeroSign;
-        for (size_t sampleIdx = 0; sampleIdx < m_samplesPerBit; ++sampleIdx)
+        float bandwidthTime = 0;
+        auto var = InMemDatabase::getInstance().getValue(GMSK_BANDWIDTH_TIME_KEY);
+        extractValue<float>(var, bandwidthTime);
+        if (bandwidthTime > 0)
         {
-            signal.emplace_back(getSignalValue(amplitudeIndex, DEFAULT_AMPLITUDE_INDEX, time, DEFAULT_PHASE));
-            time += symbolDuration;
+            m_gmsk.bandwidthTime = bandwidthTime;
         }
     }
-    addNoise(signal);
-    return signal;
+    catch (const DBException &e)
+    {
+        m_gmsk.bandwidthTime = DEFAULT_GMSK_BANDWIDTH_TIME;
+    }
+    try
+    {
+        const char *detector = "";
+        auto var = InMemDatabase::getInstance().getValue(GMSK_DETECTOR_KEY);
+        extractValue<char const *>(var, detector);
+        if (std::string(detector) == "differential")
+        {
+            m_gmsk.detection = GmskDetection::DIFFERENTIAL;
+        }
+    }
+    catch (const DBException &e)
+    {
+        m_gmsk.detection = GmskDetection::VITERBI;
+    }
 }
 
-std::string Modulator::askDemodulation(const std::vector<double> &p_signal)
+void Modulator::readFskDetection()
 {
-    std::string outputBinary;
-    double threshold = m_askZeroSign;
+    try
+    {
+        const char *detector = "";
+        auto var = InMemDatabase::getInstance().getValue(FSK_DETECTOR_KEY);
+        extractValue<char const *>(var, detector);
+        m_fskDetection = (std::string(detector) == "goertzel") ? FskDetection::GOERTZEL : FskDetection::CORRELATOR;
+    }
+    catch (const DBException &e)
+    {
+        m_fskDetection = FskDetection::CORRELATOR;
+    }
+}
 
-    for (size_t bitIdx = 0; bitIdx < p_signal.size(); bitIdx += m_samplesPerBit)
+void Modulator::readThreadCount()
+{
+    unsigned long threadCount = 0;
+    try
     {
-        double accumulator = 0.0;
-        for (size_t sampleIdx = 0; sampleIdx < m_samplesPerBit && (bitIdx + sampleIdx) < p_signal.size(); ++sampleIdx)
-        {
-            accumulator += std::abs(p_signal[bitIdx + sampleIdx]);
-        }
-        accumulator /= m_samplesPerBit;
-        outputBinary += (accumulator > threshold) ? '1' : '0';
+        auto var = InMemDatabase::getInstance().getValue(THREAD_COUNT_KEY);
+        extractValue<unsigned long>(var, threadCount);
     }
-    return outputBinary;
+    catch (const DBException &e)
+    {
+        threadCount = 0;
+    }
+    m_threadCount = resolveThreadCount(static_cast<unsigned int>(threadCount));
 }
 
-std::vector<double> Modulator::pskModulation()
+void Modulator::readTrigMode()
 {
-    std::vector<double> signal;
-    double symbolDuration = 1.0 / m_sampleRate;
+    try
+    {
+        const char *trigMode = "";
+        auto var = InMemDatabase::getInstance().getValue(TRIG_MODE_KEY);
+        extractValue<char const *>(var, trigMode);
+        m_trigMode = parseTrigMode(trigMode);
+    }
+    catch (const DBException &e)
+    {
+        m_trigMode = TrigMode::LIBM;
+    }
+}
 
-    double time = 0.0; // Time variable
-    for (size_t bitIdx = 0; bitIdx < m_binaryInput.size(); ++bitIdx)
+std::shared_ptr<const OfdmEngine> Modulator::createOfdmEngine(const bool p_isBaseband)
+{
+    // The symbol rate is the rate of constellation points, shared by all subcarriers
+    const unsigned int subcarriers = m_ofdm.subcarriers;
+    const size_t lowerSubcarriers = subcarriers / 2;
+    double symbolRate = (m_symbolRate > 0) ? m_symbolRate : m_carrierFrequency;
+    size_t carrierBin = static_cast<size_t>(std::lround(subcarriers * m_carrierFrequency / symbolRate));
+    if (carrierBin <= lowerSubcarriers)
     {
-        double phase = (m_binaryInput[bitIdx] == '1') ? m_pskOneSign : m_pskZeroSign;
-        for (size_t sampleIdx = 0; sampleIdx < m_samplesPerBit; ++sampleIdx)
-        {
-            signal.emplace_back(getSignalValue(DEFAULT_AMPLITUDE_INDEX, DEFAULT_FREQUENCY_INDEX, time, DEFAULT_PHASE + phase));
-            time += symbolDuration;
-        }
+        g_serverLogger.warning("The OFDM band is wider than twice the carrier, the subcarrier spacing is reduced");
+        carrierBin = lowerSubcarriers + 1;
     }
-    addNoise(signal);
-    return signal;
+    const double spacing = m_carrierFrequency / carrierBin;
+    const size_t highestBin = carrierBin + (subcarriers - 1 - lowerSubcarriers);
+    const size_t fftSize = getNextPowerOfTwo(std::max<size_t>(2 * highestBin + 1, static_cast<size_t>(m_oversampling) * subcarriers));
+    const size_t prefixLength = static_cast<size_t>(std::lround(m_ofdm.cyclicPrefix * fftSize));
+    m_samplesPerBit = fftSize + prefixLength;
+    m_sampleRate = spacing * fftSize;
+    if (!p_isBaseband)
+    {
+        return std::make_shared<OfdmEngine>(subcarriers, fftSize, prefixLength, carrierBin, DEFAULT_PHASE);
+    }
+
+    // The baseband grid keeps m_basebandSamplesPerSymbol samples per constellation point
+    const size_t basebandSize = getNextPowerOfTwo(static_cast<size_t>(subcarriers) * m_basebandSamplesPerSymbol);
+    const size_t basebandPrefixLength = static_cast<size_t>(std::lround(m_ofdm.cyclicPrefix * basebandSize));
+    m_basebandSymbolLength = basebandSize + basebandPrefixLength;
+    return std::make_shared<OfdmEngine>(subcarriers, basebandSize, basebandPrefixLength, 0, DEFAULT_PHASE);
 }
 
-std::string Modulator::pskDemodulation(const std::vector<double> &p_signal)
+template <typename Policy>
+void Modulator::selectSamplesPerSymbol()
 {
-    std::string outputBinary;
+    // Without a symbol rate setting one symbol lasts one carrier cycle, as it always did
+    double symbolRate = (m_symbolRate > 0) ? m_symbolRate : m_carrierFrequency;
 
-    for (size_t bitIdx = 0; bitIdx < p_signal.size(); bitIdx += m_samplesPerBit)
+    double highestToneIndex = DEFAULT_FREQUENCY_INDEX;
+    for (double toneIndex : Policy::getToneIndices(m_parameters))
     {
-        // These variables accumulate the correlation between the received signal
-        // and the reference signal for binary '0' and '1', respectively.
-        double correlation0 = 0.0;
-        double correlation1 = 0.0;
-        for (size_t sampleIdx = 0; sampleIdx < m_samplesPerBit && (bitIdx + sampleIdx) < p_signal.size(); ++sampleIdx)
+        highestToneIndex = std::max(highestToneIndex, toneIndex);
+    }
+    double cyclesPerSymbol = highestToneIndex * m_carrierFrequency / symbolRate;
+    double density = Policy::MIN_SAMPLES_PER_CYCLE * cyclesPerSymbol;
+    if constexpr (Policy::PULSE_SHAPING)
+    {
+        // The image of a shaped envelope at twice the carrier must alias outside of the matched filter band
+        density = std::max(density, 2 * cyclesPerSymbol + getPulseBandwidth(m_pulseShaping));
+        if (2 * cyclesPerSymbol < getPulseBandwidth(m_pulseShaping))
         {
-            double time = static_cast<double>(bitIdx + sampleIdx) / m_sampleRate;
-            double signalValue = p_signal[bitIdx + sampleIdx];
-            correlation0 += getSignalValue(signalValue, DEFAULT_FREQUENCY_INDEX, time, m_pskZeroSign);
-            correlation1 += getSignalValue(signalValue, DEFAULT_FREQUENCY_INDEX, time, m_pskOneSign);
+            g_serverLogger.warning("The carrier is below half of the pulse bandwidth, the envelope overlaps its own image");
         }
-        // std::cout << correlation0 << "--" << correlation1 << "\n";
-        // After calculating the correlations for a chunk, compares correlation0 and correlation1.
-        // If correlation0 is greater, it means the signal is more similar to the reference signal
-        // for '0', so the output bit is '0'. Otherwise, it's '1'.
-        outputBinary += (correlation0 > correlation1) ? '0' : '1';
     }
-    return outputBinary;
+    if constexpr (Policy::CONTINUOUS_PHASE)
+    {
+        density = std::max(density, 2 * cyclesPerSymbol + GMSK_OCCUPIED_BANDWIDTH);
+        if (2 * cyclesPerSymbol < GMSK_OCCUPIED_BANDWIDTH)
+        {
+            g_serverLogger.warning("The carrier is below half of the GMSK bandwidth, the envelope overlaps its own image");
+        }
+    }
+    unsigned int minimum = static_cast<unsigned int>(std::floor(density)) + 1;
+
+    // The symbol rate is exact, only the samples per symbol are rounded, the output resampler restores /fs
+    unsigned int samplesPerSymbol = (m_oversampling > 0) ? m_oversampling
+                                                         : static_cast<unsigned int>(std::lround(m_outputRate / symbolRate));
+    if (samplesPerSymbol < minimum)
+    {
+        g_serverLogger.warning(stringify("Oversampling raised from ", samplesPerSymbol, " to ", minimum,
+                                         " samples per symbol, the detector needs more samples per carrier cycle"));
+        samplesPerSymbol = minimum;
+    }
+    m_samplesPerBit = samplesPerSymbol;
+    m_sampleRate = symbolRate * samplesPerSymbol;
 }
 
-std::vector<double> Modulator::fskModulation()
+FarrowResampler Modulator::createOutputResampler()
 {
-    std::vector<double> signal;
-    double symbolDuration = 1.0 / m_sampleRate;
+    return FarrowResampler(m_sampleRate, m_outputRate);
+}
+
+void Modulator::setArithmetic(const Arithmetic p_arithmetic)
+{
+    m_arithmetic = p_arithmetic;
+}
+
+void Modulator::setFskDetection(const FskDetection p_detection)
+{
+    m_fskDetection = p_detection;
+}
+
+void Modulator::setNoisy(const bool p_isNoisy)
+{
+    m_isNoisy = p_isNoisy;
+}
 
-    double time = 0.0; // Time variable
-    for (size_t bitIdx = 0; bitIdx < m_binaryInput.size(); ++bitIdx)
+void Modulator::setBinaryInput(const BitBuffer &p_binaryData)
+{
+    m_binaryInput = p_binaryData;
+}
+
+unsigned int Modulator::readBasebandSamplesPerSymbol()
+{
+    try
     {
-        double frequencyIndex = (m_binaryInput[bitIdx] == '1') ? m_fskOneSign : m_fskZeroSign;
-        for (size_t sampleIdx = 0; sampleIdx < m_samplesPerBit; ++sampleIdx)
-        {
-            signal.emplace_back(getSignalValue(DEFAULT_AMPLITUDE_INDEX, frequencyIndex, time, DEFAULT_PHASE));
-            time += symbolDuration;
-        }
+        unsigned long samplesPerSymbol = 0;
+        auto var = InMemDatabase::getInstance().getValue(BASEBAND_SAMPLES_PER_SYMBOL_KEY);
+        extractValue<unsigned long>(var, samplesPerSymbol);
+        return (samplesPerSymbol > 0) ? samplesPerSymbol : DEFAULT_BASEBAND_SAMPLES_PER_SYMBOL;
     }
-    addNoise(signal);
-    return signal;
+    catch (const DBException &e)
+    {
+        return DEFAULT_BASEBAND_SAMPLES_PER_SYMBOL;
+    }
+}
+
+unsigned int Modulator::getBasebandSamplesPerSymbol()
+{
+    return m_basebandSamplesPerSymbol;
 }
 
-std::string Modulator::fskDemodulation(const std::vector<double> &p_signal)
+Oscillator Modulator::getCarrierOscillator(const double &p_frequencyIndex, const double &p_phase)
 {
-    std::string outputBinary;
+    Oscillator oscillator(p_frequencyIndex * m_carrierFrequency, m_sampleRate, p_phase);
+    oscillator.setTrigMode(m_trigMode);
+    return oscillator;
+}
+
+Oscillator Modulator::getBasebandOscillator(const double &p_frequencyIndex, const double &p_phase)
+{
+    // A baseband symbol lasts exactly as long as a passband symbol of m_samplesPerBit samples
+    Oscillator oscillator((p_frequencyIndex - DEFAULT_FREQUENCY_INDEX) * m_carrierFrequency,
+                          static_cast<double>(m_sampleRate) * m_basebandSamplesPerSymbol / m_samplesPerBit, p_phase);
+    oscillator.setTrigMode(m_trigMode);
+    return oscillator;
+}
 
-    for (size_t bitIdx = 0; bitIdx < p_signal.size(); bitIdx += m_samplesPerBit)
+void Modulator::checkBinaryInput(const unsigned int p_bitsPerSymbol)
+{
+    if (m_binaryInput.size() % p_bitsPerSymbol != 0)
     {
-        // These variables accumulate the correlation between the received signal
-        // and the reference signal for binary '0' and '1', respectively.
-        double correlation0 = 0.0; 
-        double correlation1 = 0.0;
-        for (size_t sampleIdx = 0; sampleIdx < m_samplesPerBit && (bitIdx + sampleIdx) < p_signal.size(); ++sampleIdx)
-        {
-            double time = static_cast<double>(bitIdx + sampleIdx) / m_sampleRate;
-            double signalValue = p_signal[bitIdx + sampleIdx];
-            correlation0 += getSignalValue(signalValue, m_fskZeroSign, time, DEFAULT_PHASE);
-            correlation1 += getSignalValue(signalValue, m_fskOneSign, time, DEFAULT_PHASE);
-        }
-        // After calculating the correlations for a chunk, compares correlation0 and correlation1.
-        // If correlation1 is greater, it means the signal is more similar to the reference signal
-        // for '1', so the output bit is '1'. Otherwise, it's '0'.
-        outputBinary += (correlation1 > correlation0) ? '1' : '0';
+        throw std::invalid_argument(stringify("Binary data length must be a multiple of ", p_bitsPerSymbol,
+                                              " for this modulation scheme."));
     }
+}
 
-    return outputBinary;
+unsigned int Modulator::readSymbol(const size_t p_symbolIdx, const unsigned int p_bitsPerSymbol) const
+{
+    return m_binaryInput.getBits(p_symbolIdx * p_bitsPerSymbol, p_bitsPerSymbol);
+}
+
+template <typename Policy>
+std::vector<std::complex<double>> Modulator::getEnvelopePoints()
+{
+    // gI * cos(wt) + gQ * sin(wt) = Re((gI - j*gQ) * e^{jwt})
+    std::vector<std::complex<double>> points;
+    for (const SymbolShape &shape : Policy::getAlphabet(m_parameters))
+    {
+        points.emplace_back(shape.inPhaseGain, -shape.quadratureGain);
+    }
+    return points;
 }
 
-std::complex<double> mapToQAM16Constellation(const int (&bits)[BIT_SIZE_16QAM])
+template <typename Policy>
+BitBuffer Modulator::decideEnvelopePoints(const std::vector<std::complex<double>> &p_points, const unsigned int p_samplesPerSymbol)
 {
+    BitBuffer outputBinary;
+    for (const std::complex<double> &point : p_points)
+    {
+        // Report the envelope as the correlations a rectangular symbol of the same length would give
+        SymbolCorrelation<Policy::TONE_COUNT> correlation = {};
+        correlation.inPhase[0] = point.real() * p_samplesPerSymbol / 2;
+        correlation.quadrature[0] = -point.imag() * p_samplesPerSymbol / 2;
+        Policy::decide(correlation, p_samplesPerSymbol, m_parameters, outputBinary);
+    }
+    return outputBinary;
+}
 
-    int sizeIQ = sizeof(IQ_VALUES) / sizeof(IQ_VALUES[0]);
+template <typename Policy>
+std::vector<std::complex<double>> Modulator::modulateOfdmSymbols(const OfdmEngine &p_engine)
+{
+    const std::vector<std::complex<double>> alphabet = getEnvelopePoints<Policy>();
+    const size_t pointCount = m_binaryInput.size() / Policy::BITS_PER_SYMBOL;
+    const size_t symbolLength = p_engine.getSymbolLength();
+    std::vector<std::complex<double>> signal(p_engine.getSymbolCount(pointCount) * symbolLength);
+    std::vector<std::complex<double>> points(p_engine.getSubcarriers());
+    for (size_t firstPoint = 0, symbolIdx = 0; firstPoint < pointCount; firstPoint += points.size(), ++symbolIdx)
+    {
+        size_t count = std::min(points.size(), pointCount - firstPoint);
+        for (size_t pointIdx = 0; pointIdx < count; ++pointIdx)
+        {
+            points[pointIdx] = alphabet[readSymbol(firstPoint + pointIdx, Policy::BITS_PER_SYMBOL)];
+        }
+        p_engine.modulateSymbol(points.data(), count, symbolIdx, signal.data() + symbolIdx * symbolLength);
+    }
+    return signal;
+}
 
-    // Mapping for I and Q components
+template <typename Policy>
+BitBuffer Modulator::demodulateOfdmSymbols(const OfdmEngine &p_engine, std::vector<std::complex<double>> &p_samples)
+{
+    std::vector<std::complex<double>> points = receiveOfdmElements(p_engine, p_samples);
 
-    double iValues[sizeIQ];
+    // No constellation point sits at the origin, so the empty subcarriers of the last OFDM symbol stand out
+    double threshold = HUGE_VAL;
+    for (const std::complex<double> &point : getEnvelopePoints<Policy>())
+    {
+        threshold = std::min(threshold, std::abs(point) / 2);
+    }
+    const size_t lastSymbolStart = (points.size() >= p_engine.getSubcarriers()) ? points.size() - p_engine.getSubcarriers() : 0;
+    while (points.size() > lastSymbolStart && std::abs(points.back()) < threshold)
+    {
+        points.pop_back();
+    }
+    return decideEnvelopePoints<Policy>(points, p_engine.getSymbolLength());
+}
 
-    double qValues[sizeIQ];
+std::vector<std::complex<double>> Modulator::receiveOfdmElements(const OfdmEngine &p_engine, std::vector<std::complex<double>> &p_samples)
+{
+    const size_t symbolLength = p_engine.getSymbolLength();
+    std::vector<std::complex<double>> points;
+    for (size_t symbolIdx = 0; (symbolIdx + 1) * symbolLength <= p_samples.size(); ++symbolIdx)
+    {
+        size_t firstPoint = points.size();
+        points.resize(firstPoint + p_engine.getSubcarriers());
+        p_engine.demodulateSymbol(p_samples.data() + symbolIdx * symbolLength, symbolIdx, points.data() + firstPoint);
+    }
+    return points;
+}
 
-    std::copy(IQ_VALUES, IQ_VALUES + sizeIQ, iValues);
+template <typename Policy>
+ModulationSession Modulator::createGridSession(const ResourceGrid &p_grid)
+{
+    const std::vector<std::complex<double>> alphabet = getEnvelopePoints<Policy>();
+    std::vector<std::complex<double>> elements(p_grid.getElements().size());
+    for (size_t elementIdx = 0; elementIdx < elements.size(); ++elementIdx)
+    {
+        int value = p_grid.getElements()[elementIdx];
+        if (value != NULL_RESOURCE_ELEMENT)
+        {
+            elements[elementIdx] = alphabet[value];
+        }
+    }
+    return ModulationSession(createOfdmEngine(false), std::move(elements), m_isNoisy);
+}
 
-    std::copy(IQ_VALUES, IQ_VALUES + sizeIQ, qValues);
+template <typename Policy, typename T>
+std::vector<BitBuffer> Modulator::demodulateGridSymbols(const std::vector<T> &p_signal, const ResourceGrid &p_grid)
+{
+    std::shared_ptr<const OfdmEngine> engine = createOfdmEngine(false);
+    std::vector<std::complex<double>> samples(p_signal.size());
+    for (size_t sampleIdx = 0; sampleIdx < p_signal.size(); ++sampleIdx)
+    {
+        samples[sampleIdx] = SampleTraits<T>::toDouble(p_signal[sampleIdx]);
+    }
+    std::vector<std::complex<double>> elements = receiveOfdmElements(*engine, samples);
 
-    // Map 2-bit pair to I and Q values
-    double I = iValues[bits[0] * 2 + bits[1]]; // First two bits map to I
-    double Q = qValues[bits[2] * 2 + bits[3]]; // Last two bits map to Q
+    // Every client only decides its own resource elements, the null ones in between are never looked at
+    std::vector<BitBuffer> payloads;
+    for (const GridAllocation &allocation : p_grid.getAllocations())
+    {
+        size_t firstElement = std::min(allocation.firstElement, elements.size());
+        size_t lastElement = std::min(allocation.firstElement + allocation.pointCount, elements.size());
+        std::vector<std::complex<double>> points(elements.begin() + firstElement, elements.begin() + lastElement);
+        payloads.push_back(decideEnvelopePoints<Policy>(points, engine->getSymbolLength()));
+    }
+    return payloads;
+}
 
-    // Return the complex floatValue (I + jQ)
-    return std::complex<double>(I, Q);
+ModulationSession Modulator::createGmskSession()
+{
+    checkBinaryInput(GmskPolicy::BITS_PER_SYMBOL);
+    selectSamplesPerSymbol<GmskPolicy>();
+    GmskModulator gmsk(GmskTableCache::getInstance().getTable(m_gmsk.bandwidthTime, m_samplesPerBit));
+    return ModulationSession(gmsk, m_binaryInput, getCarrierOscillator(DEFAULT_FREQUENCY_INDEX, DEFAULT_PHASE), m_isNoisy);
 }
 
-std::vector<std::complex<double>> mapBitsToSymbols16QAM(const std::string &p_binaryData)
+template <typename T>
+BitBuffer Modulator::demodulateGmsk(const std::vector<T> &p_signal)
 {
-    std::vector<std::complex<double>> symbols;
+    selectSamplesPerSymbol<GmskPolicy>();
+    GmskDemodulator gmsk(GmskTableCache::getInstance().getTable(m_gmsk.bandwidthTime, m_samplesPerBit));
 
-    if (p_binaryData.size() % BIT_SIZE_16QAM != 0)
+    // 2 * x * e^{-j(wt + phase)} is the envelope plus its image at twice the carrier
+    Oscillator carrier = getCarrierOscillator(DEFAULT_FREQUENCY_INDEX, DEFAULT_PHASE);
+    std::vector<std::complex<double>> envelope(p_signal.size());
+    for (size_t sampleIdx = 0; sampleIdx < p_signal.size(); ++sampleIdx)
     {
-        throw std::invalid_argument("Binary data length must be a multiple of 4 for 16-QAM.");
+        envelope[sampleIdx] = 2 * SampleTraits<T>::toDouble(p_signal[sampleIdx]) * std::conj(carrier.next());
     }
+    // The Viterbi metrics correlate over whole table rows and tolerate the image, the differential detector
+    // only compares two symbol sums and needs it removed
+    if (m_gmsk.detection == GmskDetection::DIFFERENTIAL)
+    {
+        gmsk.removeImage(envelope);
+    }
+    return gmsk.detect(envelope, m_gmsk.detection);
+}
 
-    // Process each group of 4 bits
+std::vector<std::complex<double>> Modulator::modulateBasebandGmsk()
+{
+    checkBinaryInput(GmskPolicy::BITS_PER_SYMBOL);
+    selectSamplesPerSymbol<GmskPolicy>();
+    m_basebandSymbolLength = m_basebandSamplesPerSymbol;
+    GmskModulator gmsk(GmskTableCache::getInstance().getTable(m_gmsk.bandwidthTime, m_basebandSamplesPerSymbol));
 
-    for (size_t bitIdx = 0; bitIdx < p_binaryData.size(); bitIdx += BIT_SIZE_16QAM)
+    // The envelope is relative to a carrier at phase 0, the initial phase is part of it
+    std::vector<std::complex<double>> signal = gmsk.modulate(m_binaryInput);
+    const std::complex<double> phase = std::polar(1.0, DEFAULT_PHASE);
+    for (std::complex<double> &sample : signal)
     {
-        // Convert from string to int by minus '0'
-        int bits[BIT_SIZE_16QAM] = {p_binaryData[bitIdx] - '0', p_binaryData[bitIdx + 1] - '0',
-                                    p_binaryData[bitIdx + 2] - '0', p_binaryData[bitIdx + 3] - '0'};
+        sample *= phase;
+    }
+    return signal;
+}
 
-        symbols.emplace_back(mapToQAM16Constellation(bits));
+BitBuffer Modulator::demodulateBasebandGmsk(const std::vector<std::complex<double>> &p_signal)
+{
+    selectSamplesPerSymbol<GmskPolicy>();
+    m_basebandSymbolLength = m_basebandSamplesPerSymbol;
+    GmskDemodulator gmsk(GmskTableCache::getInstance().getTable(m_gmsk.bandwidthTime, m_basebandSamplesPerSymbol));
+    std::vector<std::complex<double>> envelope(p_signal);
+    const std::complex<double> phase = std::polar(1.0, -DEFAULT_PHASE);
+    for (std::complex<double> &sample : envelope)
+    {
+        sample *= phase;
     }
+    return gmsk.detect(envelope, m_gmsk.detection);
+}
 
-    return symbols;
+void Modulator::addNoise(std::vector<std::complex<double>> &p_signal)
+{
+    std::default_random_engine generator(time(0));
+    std::normal_distribution<double> distribution(0.0, NOISE_LEVEL);
+    for (std::complex<double> &sample : p_signal)
+    {
+        sample += std::complex<double>(distribution(generator), distribution(generator));
+    }
 }
 
-std::vector<double> Modulator::qam16Modulation()
+template <typename T>
+void Modulator::addNoise(std::vector<T> &p_signal)
 {
-    std::vector<std::complex<double>> symbols = mapBitsToSymbols16QAM(m_binaryInput);
+    std::default_random_engine generator(time(0));
+    std::normal_distribution<double> distribution(0.0, NOISE_LEVEL);
+    for (size_t i = 0; i < p_signal.size(); i++)
+    {
+        p_signal[i] = SampleTraits<T>::fromDouble(SampleTraits<T>::toDouble(p_signal[i]) + distribution(generator));
+    }
+}
 
-    std::vector<double> signal;
+template <typename Policy>
+ModulationSession Modulator::createSession()
+{
+    checkBinaryInput(Policy::BITS_PER_SYMBOL);
+    if constexpr (Policy::SUPPORTS_OFDM)
+    {
+        if (m_ofdm.subcarriers > 0)
+        {
+            return ModulationSession(createOfdmEngine(false), getEnvelopePoints<Policy>(), m_binaryInput, Policy::BITS_PER_SYMBOL, m_isNoisy);
+        }
+    }
+    selectSamplesPerSymbol<Policy>();
 
-    double time = 0.0; // Time variable
-    for (const auto &symbol : symbols)
+    if constexpr (Policy::PULSE_SHAPING)
     {
-        // Generate the signal for the symbol
-        for (int sampleIdx = 0; sampleIdx < m_samplesPerBit; ++sampleIdx)
+        // Shaped pulses overlap their neighbours, so symbols are interpolated instead of stitched from templates
+        PulseShaper shaper(PulseFilterCache::getInstance().getFilter(m_pulseShaping, m_samplesPerBit));
+        if (shaper.isEnabled())
         {
-            // In-phase (I) and Quadrature (Q) components of the symbol
-            // Cosine wave for the I component
-            double inPhase = getSignalValue(symbol.real(), DEFAULT_FREQUENCY_INDEX, time, DEFAULT_PHASE);
-            // Sine wave for the Q component
-            double quadrature = getSignalValue(symbol.imag(), DEFAULT_FREQUENCY_INDEX, time, DEFAULT_PHASE - M_PI / 2);
+            std::array<double, Policy::TONE_COUNT> toneIndices = Policy::getToneIndices(m_parameters);
+            return ModulationSession(shaper, getEnvelopePoints<Policy>(), m_binaryInput, Policy::BITS_PER_SYMBOL,
+                                     m_samplesPerBit, getCarrierOscillator(toneIndices[0], DEFAULT_PHASE), m_isNoisy);
+        }
+    }
+    ModulationSession session(getWaveformTemplate<Policy>(), m_binaryInput, Policy::BITS_PER_SYMBOL, m_isNoisy);
+    session.setArithmetic(m_arithmetic);
+    return session;
+}
+
+template <typename Policy>
+std::shared_ptr<const WaveformTemplate> Modulator::getWaveformTemplate()
+{
+    std::vector<double> toneFrequencies;
+    for (double toneIndex : Policy::getToneIndices(m_parameters))
+    {
+        toneFrequencies.push_back(toneIndex * m_carrierFrequency);
+    }
+    return WaveformCache::getInstance().getTemplate(Policy::SCHEME, m_carrierFrequency, m_sampleRate, m_samplesPerBit,
+                                                    DEFAULT_PHASE, toneFrequencies, Policy::getAlphabet(m_parameters));
+}
 
-            signal.emplace_back(inPhase + quadrature);
+template <typename Policy, typename T>
+BitBuffer Modulator::demodulateSymbols(const std::vector<T> &p_signal)
+{
+    if constexpr (Policy::SUPPORTS_OFDM)
+    {
+        if (m_ofdm.subcarriers > 0)
+        {
+            std::shared_ptr<const OfdmEngine> engine = createOfdmEngine(false);
+            std::vector<std::complex<double>> samples(p_signal.size());
+            for (size_t sampleIdx = 0; sampleIdx < p_signal.size(); ++sampleIdx)
+            {
+                samples[sampleIdx] = SampleTraits<T>::toDouble(p_signal[sampleIdx]);
+            }
+            return demodulateOfdmSymbols<Policy>(*engine, samples);
+        }
+    }
+    BitBuffer outputBinary;
+    selectSamplesPerSymbol<Policy>();
+    std::array<Oscillator, Policy::TONE_COUNT> references = createReferences<Policy>();
 
-            time += 1.0 / m_sampleRate;
+    if constexpr (Policy::PULSE_SHAPING)
+    {
+        PulseShaper shaper(PulseFilterCache::getInstance().getFilter(m_pulseShaping, m_samplesPerBit));
+        if (shaper.isEnabled())
+        {
+            // Mix down to the complex envelope, the matched filter also rejects the image at twice the carrier
+            std::vector<std::complex<double>> envelope(p_signal.size());
+            for (size_t sampleIdx = 0; sampleIdx < p_signal.size(); ++sampleIdx)
+            {
+                envelope[sampleIdx] = 2 * SampleTraits<T>::toDouble(p_signal[sampleIdx]) * std::conj(references[0].next());
+            }
+            return decideEnvelopePoints<Policy>(shaper.match(envelope), m_samplesPerBit);
         }
     }
-    addNoise(signal);
-    return signal;
+
+    correlateSymbolRanges<Policy>(p_signal.data(), p_signal.size(), references, outputBinary);
+    return outputBinary;
 }
 
-// Normalize p_symbol from range (-4, 4) into mapping values (-3, -1, 1, 3)
-void normalizeIQ(double& p_symbol) 
+template <typename Policy, typename T>
+void Modulator::correlateSymbolRanges(const T *p_signal, const size_t p_count,
+                                      std::array<Oscillator, Policy::TONE_COUNT> &p_references, BitBuffer &p_outputBinary)
 {
-    p_symbol = static_cast<int>(floor(p_symbol * 2)) * 2 + 1;
-    // Scale IQ_VALUES into {-0.75, -0.25, 0.25, 0.75}
-    p_symbol /= 4.0;
+    // Every symbol only depends on its own samples, long signals are split into symbol ranges whose references
+    // are moved to the first sample of the range
+    std::vector<SymbolRange> ranges = splitSymbolRanges((p_count + m_samplesPerBit - 1) / m_samplesPerBit,
+                                                        m_samplesPerBit, m_threadCount);
+    std::vector<BitBuffer> rangeBinary(ranges.size());
+    runParallel(ranges.size(),
+                [this, p_signal, p_count, &ranges, &p_references, &rangeBinary](size_t p_rangeIdx)
+                {
+                    size_t firstSample = ranges[p_rangeIdx].first * m_samplesPerBit;
+                    size_t lastSample = std::min(ranges[p_rangeIdx].last * m_samplesPerBit, p_count);
+                    std::array<Oscillator, Policy::TONE_COUNT> rangeReferences = p_references;
+                    for (Oscillator &reference : rangeReferences)
+                    {
+                        reference.skip(firstSample);
+                    }
+                    correlateSymbols<Policy>(p_signal + firstSample, lastSample - firstSample, rangeReferences,
+                                             rangeBinary[p_rangeIdx]);
+                });
+    for (const BitBuffer &binary : rangeBinary)
+    {
+        p_outputBinary.append(binary);
+    }
+    for (Oscillator &reference : p_references)
+    {
+        reference.skip(p_count);
+    }
 }
 
-std::string mapSymbolToBits16QAM(double& p_symbol)
+template <typename Policy, typename T>
+void Modulator::demodulateStreamSymbols(DemodulationStream<T> &p_stream, const T *p_signal, const size_t p_count,
+                                        BitBuffer &p_outputBinary)
 {
-    std::string bits;
-    // For comparing double to double
-    double epsilon = 1e-6;
-    std::string bitArray[] = {"00", "01", "10", "11"};
-    int sizeIQ = sizeof(IQ_VALUES) / sizeof(IQ_VALUES[0]);
-    
-    normalizeIQ(p_symbol);
-
-    for (int bitIdx = 0; bitIdx < sizeIQ; ++bitIdx)
+    // The references and the templates are looked up at the symbol length the stream was started with
+    m_samplesPerBit = p_stream.samplesPerSymbol;
+    std::array<Oscillator, Policy::TONE_COUNT> references;
+    std::copy_n(p_stream.references.begin(), Policy::TONE_COUNT, references.begin());
+    size_t firstSample = 0;
+    if (!p_stream.pending.empty())
     {
-        if (std::fabs(IQ_VALUES[bitIdx] - p_symbol) < epsilon)
+        // Complete the symbol started by the previous chunks, it is decided once it holds all its samples
+        firstSample = std::min<size_t>(p_count, m_samplesPerBit - p_stream.pending.size());
+        p_stream.pending.insert(p_stream.pending.end(), p_signal, p_signal + firstSample);
+        if (p_stream.pending.size() < m_samplesPerBit)
         {
-            bits = bitArray[bitIdx];
+            return;
         }
+        correlateSymbols<Policy>(p_stream.pending.data(), m_samplesPerBit, references, p_outputBinary);
+        p_stream.pending.clear();
     }
-    if (bits.empty())
+    // The whole symbols are correlated in place, only the samples of the next partial symbol are copied
+    size_t wholeSamples = (p_count - firstSample) / m_samplesPerBit * m_samplesPerBit;
+    if (wholeSamples > 0)
     {
-        g_serverLogger.error("Invalid symbol of 16 QAM!");
+        correlateSymbolRanges<Policy>(p_signal + firstSample, wholeSamples, references, p_outputBinary);
     }
-    return bits;
+    p_stream.pending.assign(p_signal + firstSample + wholeSamples, p_signal + p_count);
+    std::copy(references.begin(), references.end(), p_stream.references.begin());
 }
 
-std::string Modulator::qam16Demodulation(const std::vector<double> &p_signal)
+template <typename Policy>
+std::array<Oscillator, Policy::TONE_COUNT> Modulator::createReferences()
 {
-    std::string demodulatedBits;
+    // The references must carry the same phase offset as the transmitted carrier,
+    // otherwise they end up in quadrature with the signal and the correlations vanish.
+    std::array<double, Policy::TONE_COUNT> toneIndices = Policy::getToneIndices(m_parameters);
+    std::array<Oscillator, Policy::TONE_COUNT> references;
+    for (size_t tone = 0; tone < Policy::TONE_COUNT; ++tone)
+    {
+        references[tone] = getCarrierOscillator(toneIndices[tone], DEFAULT_PHASE);
+    }
+    return references;
+}
 
-    for (size_t bitIdx = 0; bitIdx < p_signal.size(); bitIdx += m_samplesPerBit)
+template <typename Policy, typename T>
+void Modulator::correlateSymbols(const T *p_signal, const size_t p_count, std::array<Oscillator, Policy::TONE_COUNT> &p_references,
+                                 BitBuffer &p_outputBinary)
+{
+    if constexpr (Policy::TONE_BANK)
+    {
+        if (m_fskDetection == FskDetection::GOERTZEL)
+        {
+            detectTones<Policy>(p_signal, p_count, p_references, p_outputBinary);
+            return;
+        }
+    }
+    if constexpr (std::is_same_v<T, int16_t> && !Policy::USES_ENVELOPE)
+    {
+        if (m_arithmetic == Arithmetic::FLOATING_POINT)
+        {
+            // Only fixed-point arithmetic correlates int16 samples against the Q15 basis, otherwise they are
+            // converted to double one tile of whole symbols at a time
+            std::vector<double> tile(std::max<size_t>(1, MODULATION_CHUNK_SIZE / m_samplesPerBit) * m_samplesPerBit);
+            for (size_t firstSample = 0; firstSample < p_count; firstSample += tile.size())
+            {
+                size_t count = std::min(tile.size(), p_count - firstSample);
+                for (size_t sampleIdx = 0; sampleIdx < count; ++sampleIdx)
+                {
+                    tile[sampleIdx] = SampleTraits<int16_t>::toDouble(p_signal[firstSample + sampleIdx]);
+                }
+                correlateSymbols<Policy>(tile.data(), count, p_references, p_outputBinary);
+            }
+            return;
+        }
+    }
+    // The whole symbols are correlated in one kernel call, a trailing partial symbol in one more
+    const SimdKernels &kernels = SimdKernels::getInstance();
+    const size_t wholeSymbols = p_count / m_samplesPerBit;
+    const size_t tailCount = p_count % m_samplesPerBit;
+    const size_t symbolCount = wholeSymbols + ((tailCount > 0) ? 1 : 0);
+    const T *tail = p_signal + wholeSymbols * m_samplesPerBit;
+    if constexpr (Policy::USES_ENVELOPE)
     {
-        double iAvg = 0.0, qAvg = 0.0;
+        std::vector<double> envelopes(symbolCount);
+        sumEnvelopes(kernels, p_signal, m_samplesPerBit, wholeSymbols, envelopes.data());
+        sumEnvelopes(kernels, tail, tailCount, symbolCount - wholeSymbols, envelopes.data() + wholeSymbols);
+        for (double envelope : envelopes)
+        {
+            SymbolCorrelation<Policy::TONE_COUNT> correlation = {};
+            correlation.envelope = envelope;
+            Policy::decide(correlation, m_samplesPerBit, m_parameters, p_outputBinary);
+        }
+    }
+    else
+    {
+        std::shared_ptr<const WaveformTemplate> waveform = getWaveformTemplate<Policy>();
+        std::array<std::vector<double>, Policy::TONE_COUNT> inPhaseSums;
+        std::array<std::vector<double>, Policy::TONE_COUNT> quadratureSums;
+        std::array<std::complex<double>, Policy::TONE_COUNT> tailSquares = {};
+        for (size_t tone = 0; tone < Policy::TONE_COUNT; ++tone)
+        {
+            const SymbolTone &basis = waveform->tones[tone];
+            inPhaseSums[tone].resize(symbolCount);
+            quadratureSums[tone].resize(symbolCount);
+            correlateTone(kernels, p_signal, m_samplesPerBit, wholeSymbols, basis, inPhaseSums[tone].data(), quadratureSums[tone].data());
+            correlateTone(kernels, tail, tailCount, symbolCount - wholeSymbols, basis, inPhaseSums[tone].data() + wholeSymbols,
+                          quadratureSums[tone].data() + wholeSymbols);
+            for (size_t sampleIdx = 0; sampleIdx < tailCount; ++sampleIdx)
+            {
+                std::complex<double> phasor(basis.inPhase[sampleIdx], basis.quadrature[sampleIdx]);
+                tailSquares[tone] += phasor * phasor;
+            }
+        }
+        for (size_t symbolIdx = 0; symbolIdx < symbolCount; ++symbolIdx)
+        {
+            SymbolCorrelation<Policy::TONE_COUNT> correlation = {};
+            const size_t count = (symbolIdx < wholeSymbols) ? m_samplesPerBit : tailCount;
+            for (size_t tone = 0; tone < Policy::TONE_COUNT; ++tone)
+            {
+                const double sumCos = inPhaseSums[tone][symbolIdx];
+                const double sumSin = quadratureSums[tone][symbolIdx];
+                // The reference at sample n of the symbol is start * e^{jwn}, its real and imaginary parts are
+                // cos/sin of the phase 0 basis rotated by start
+                const std::complex<double> start = p_references[tone].value();
+                correlation.inPhase[tone] = start.real() * sumCos - start.imag() * sumSin;
+                if constexpr (Policy::USES_QUADRATURE)
+                {
+                    correlation.quadrature[tone] = start.imag() * sumCos + start.real() * sumSin;
+                    std::complex<double> squares = (count == m_samplesPerBit) ? waveform->tones[tone].squares : tailSquares[tone];
+                    equalizeCorrelation(correlation.inPhase[tone], correlation.quadrature[tone], start * start * squares, count);
+                }
+                p_references[tone].skip(count);
+            }
+            Policy::decide(correlation, m_samplesPerBit, m_parameters, p_outputBinary);
+        }
+    }
+}
 
-        // Accumulate the in-phase and quadrature components
-        for (size_t sampleIdx = 0; sampleIdx < m_samplesPerBit; ++sampleIdx)
+template <typename Policy, typename T>
+void Modulator::detectTones(const T *p_signal, const size_t p_count, std::array<Oscillator, Policy::TONE_COUNT> &p_references,
+                            BitBuffer &p_outputBinary)
+{
+    if constexpr (!std::is_same_v<T, double>)
+    {
+        // The recurrence feeds every sample back twice, it runs in double for every sample type
+        std::vector<double> tile(std::max<size_t>(1, MODULATION_CHUNK_SIZE / m_samplesPerBit) * m_samplesPerBit);
+        for (size_t firstSample = 0; firstSample < p_count; firstSample += tile.size())
         {
-            double time = (bitIdx + sampleIdx) * 1.0 / m_sampleRate;
-            double signalValue = p_signal[bitIdx + sampleIdx];
-            iAvg += getSignalValue(signalValue, DEFAULT_FREQUENCY_INDEX, time, DEFAULT_PHASE);
-            qAvg += getSignalValue(signalValue, DEFAULT_FREQUENCY_INDEX, time, DEFAULT_PHASE - M_PI / 2);
+            size_t count = std::min(tile.size(), p_count - firstSample);
+            for (size_t sampleIdx = 0; sampleIdx < count; ++sampleIdx)
+            {
+                tile[sampleIdx] = SampleTraits<T>::toDouble(p_signal[firstSample + sampleIdx]);
+            }
+            detectTones<Policy>(tile.data(), count, p_references, p_outputBinary);
         }
+    }
+    else
+    {
+        std::array<double, Policy::TONE_COUNT> toneIndices = Policy::getToneIndices(m_parameters);
+        std::array<double, Policy::TONE_COUNT> frequencies;
+        for (size_t tone = 0; tone < Policy::TONE_COUNT; ++tone)
+        {
+            frequencies[tone] = 2 * M_PI * toneIndices[tone] * m_carrierFrequency / m_sampleRate;
+        }
+        const SimdKernels &kernels = SimdKernels::getInstance();
+        const size_t wholeSymbols = p_count / m_samplesPerBit;
+        const size_t tailCount = p_count % m_samplesPerBit;
+        const size_t symbolCount = wholeSymbols + ((tailCount > 0) ? 1 : 0);
+        std::vector<double> powers(symbolCount * Policy::TONE_COUNT);
+        kernels.detectTones(p_signal, m_samplesPerBit, wholeSymbols, frequencies.data(), Policy::TONE_COUNT, powers.data());
+        kernels.detectTones(p_signal + wholeSymbols * m_samplesPerBit, tailCount, symbolCount - wholeSymbols, frequencies.data(),
+                            Policy::TONE_COUNT, powers.data() + wholeSymbols * Policy::TONE_COUNT);
+        for (size_t symbolIdx = 0; symbolIdx < symbolCount; ++symbolIdx)
+        {
+            // The symbol is decided on the strongest tone, the powers rank the tones like the correlations do
+            SymbolCorrelation<Policy::TONE_COUNT> correlation = {};
+            std::copy_n(powers.begin() + symbolIdx * Policy::TONE_COUNT, Policy::TONE_COUNT, correlation.inPhase.begin());
+            Policy::decide(correlation, m_samplesPerBit, m_parameters, p_outputBinary);
+        }
+        for (Oscillator &reference : p_references)
+        {
+            reference.skip(p_count);
+        }
+    }
+}
 
-        // Normalize I and Q by the number of samples per symbol
-        iAvg /= m_samplesPerBit;
-        qAvg /= m_samplesPerBit;
+template <typename Policy>
+bool Modulator::decidesSymbolBySymbol()
+{
+    if constexpr (Policy::SUPPORTS_OFDM)
+    {
+        if (m_ofdm.subcarriers > 0)
+        {
+            return false;
+        }
+    }
+    if constexpr (Policy::PULSE_SHAPING)
+    {
+        PulseShaper shaper(PulseFilterCache::getInstance().getFilter(m_pulseShaping, m_samplesPerBit));
+        if (shaper.isEnabled())
+        {
+            return false;
+        }
+    }
+    return true;
+}
 
-        // Map I and Q to the closest constellation points
-        // During signal generation
-        // The in-phase component I is scaled by cos(2*pi*f_c*t),
-        // and the quadrature component Q is scaled by sin(2*pi*f_c*t).
-        // These scaling factors lead to a factor of 1/2
-        // when you're averaging the received signal to recover I and Q.
-        // When compute the average over the symbol duration
-        // (which is essentially performing an integration over time)
-        // we get a floatValue that is half the magnitude of the original transmitted values for both I and Q.
-        // hence, multiply by 2.
-        double iIndex = iAvg * 2;
-        double qIndex = qAvg * 2;
+template <typename Policy, typename T>
+BitBuffer Modulator::receiveSymbolTiles(ModulationSession &p_session, LinkStatistics &p_statistics,
+                                        const std::function<void(const T *, size_t)> &p_export)
+{
+    // A tile holds whole symbols and fits in the L1 data cache, each one is produced, measured, exported
+    // and correlated before the next one overwrites it
+    BitBuffer outputBinary;
+    std::array<Oscillator, Policy::TONE_COUNT> references = createReferences<Policy>();
+    std::vector<T> tile(std::max<size_t>(1, MODULATION_CHUNK_SIZE / m_samplesPerBit) * m_samplesPerBit);
+    size_t count;
+    while ((count = p_session.produce(tile.data(), tile.size())) > 0)
+    {
+        measureSamples(tile.data(), count, p_statistics);
+        if (p_export)
+        {
+            p_export(tile.data(), count);
+        }
+        size_t firstBit = outputBinary.size();
+        correlateSymbols<Policy>(tile.data(), count, references, outputBinary);
+        p_statistics.bitErrors += m_binaryInput.countErrors(outputBinary, firstBit);
+    }
+    return outputBinary;
+}
 
-        // Map indices to bits
-        demodulatedBits += mapSymbolToBits16QAM(iIndex);
-        demodulatedBits += mapSymbolToBits16QAM(qIndex);
+void Modulator::equalizeCorrelation(double &p_inPhase, double &p_quadrature, const std::complex<double> &p_squares,
+                                    const size_t p_count)
+{
+    // Sum cos^2 = (n + Re(sum c^2)) / 2, sum sin^2 = (n - Re(sum c^2)) / 2, sum cos*sin = Im(sum c^2) / 2
+    double cosCos = (p_count + p_squares.real()) / 2;
+    double sinSin = (p_count - p_squares.real()) / 2;
+    double cosSin = p_squares.imag() / 2;
+    double determinant = cosCos * sinSin - cosSin * cosSin;
+    if (determinant <= 0)
+    {
+        return;
     }
-    return demodulatedBits;
+    // Least squares I and Q gains, reported as the correlations a whole number of carrier cycles would give
+    double inPhaseGain = (sinSin * p_inPhase - cosSin * p_quadrature) / determinant;
+    double quadratureGain = (cosCos * p_quadrature - cosSin * p_inPhase) / determinant;
+    p_inPhase = inPhaseGain * m_samplesPerBit / 2;
+    p_quadrature = quadratureGain * m_samplesPerBit / 2;
 }
 
-std::string Modulator::randomBinaryMessageGenerator(const int p_length)
+BitBuffer Modulator::randomBinaryMessageGenerator(const int p_length)
 {
-    std::string binaryMessage;
+    BitBuffer binaryMessage;
     srand(time(0));
     for (int index = 0; index < p_length; index++)
     {
-        binaryMessage += (rand() % 2 + '0');
+        binaryMessage.pushBits(rand() % 2, 1);
     }
     return binaryMessage;
 }
 
-std::vector<double> Modulator::modulate(const std::string &p_networkTypes)
+template <typename T>
+std::vector<T> Modulator::modulate(const ModulationScheme &p_scheme)
+{
+    ModulationSession session = startModulation(p_scheme);
+    std::vector<T> signal(session.getTotalSamples());
+    produceSymbolRanges(session, signal.data());
+    return signal;
+}
+
+template <typename T>
+void Modulator::produceSymbolRanges(ModulationSession &p_session, T *p_signal)
 {
-    if (p_networkTypes == "2G")
+    const size_t samplesPerSymbol = p_session.getSamplesPerSymbol();
+    std::vector<SymbolRange> ranges = splitSymbolRanges(p_session.getSymbolCount(), samplesPerSymbol, m_threadCount);
+    if (ranges.size() == 1)
     {
-        return askModulation();
+        p_session.produce(p_signal, p_session.getTotalSamples());
+        return;
     }
-    if (p_networkTypes == "3G")
+    runParallel(ranges.size(),
+                [&p_session, p_signal, &ranges, samplesPerSymbol](size_t p_rangeIdx)
+                {
+                    ModulationSession range = p_session;
+                    range.seek(ranges[p_rangeIdx].first);
+                    range.produce(p_signal + ranges[p_rangeIdx].first * samplesPerSymbol,
+                                  (ranges[p_rangeIdx].last - ranges[p_rangeIdx].first) * samplesPerSymbol);
+                });
+}
+
+template <typename T>
+ModulationBatch<T> Modulator::modulateBatch(const std::vector<BitBuffer> &p_messages, const ModulationScheme &p_scheme)
+{
+    ModulationBatch<T> batch;
+    batch.offsets.push_back(0);
+    if (p_messages.empty())
     {
-        return pskModulation();
+        return batch;
     }
-    if (p_networkTypes == "4G")
+    m_binaryInput = p_messages.front();
+    ModulationSession session = startModulation(p_scheme);
+    const unsigned int bitsPerSymbol = getSchemeBitsPerSymbol(p_scheme);
+    for (const BitBuffer &message : p_messages)
     {
-        return fskModulation();
+        m_binaryInput = message;
+        checkBinaryInput(bitsPerSymbol);
+        session.restart(message);
+        batch.offsets.push_back(batch.offsets.back() + session.getTotalSamples());
     }
-    if (p_networkTypes == "5G")
+
+    // The buffer is allocated once, every message is then produced straight into its slice
+    batch.samples.resize(batch.offsets.back());
+    for (size_t messageIdx = 0; messageIdx < p_messages.size(); ++messageIdx)
     {
-        return qam16Modulation();
+        session.restart(p_messages[messageIdx]);
+        session.produce(batch.samples.data() + batch.offsets[messageIdx],
+                        batch.offsets[messageIdx + 1] - batch.offsets[messageIdx]);
     }
-    return {};
+    return batch;
 }
 
-std::string Modulator::demodulate(const std::vector<double> &p_signal, const std::string &p_networkTypes)
+ModulationSession Modulator::startModulation(const ModulationScheme &p_scheme)
 {
-    if (p_networkTypes == "2G")
+    // The only branch on the scheme, everything below runs in the instantiation of its policy
+    return visitSchemePolicy(
+        p_scheme,
+        [this](auto p_policy)
+        {
+            using Policy = decltype(p_policy);
+            if constexpr (Policy::CONTINUOUS_PHASE)
+            {
+                return createGmskSession();
+            }
+            else
+            {
+                return createSession<Policy>();
+            }
+        },
+        ModulationSession());
+}
+
+template <typename T>
+BitBuffer Modulator::demodulate(const std::vector<T> &p_signal, const ModulationScheme &p_scheme)
+{
+    return visitSchemePolicy(
+        p_scheme,
+        [this, &p_signal](auto p_policy)
+        {
+            using Policy = decltype(p_policy);
+            if constexpr (Policy::CONTINUOUS_PHASE)
+            {
+                return demodulateGmsk(p_signal);
+            }
+            else
+            {
+                return demodulateSymbols<Policy>(p_signal);
+            }
+        },
+        BitBuffer());
+}
+
+template <typename T>
+BitBuffer Modulator::receiveTiled(ModulationSession &p_session, const ModulationScheme &p_scheme, LinkStatistics &p_statistics,
+                                  const std::function<void(const T *, size_t)> &p_export)
+{
+    p_statistics = {};
+    return visitSchemePolicy(
+        p_scheme,
+        [this, &p_session, &p_scheme, &p_statistics, &p_export](auto p_policy)
+        {
+            using Policy = decltype(p_policy);
+            if constexpr (!Policy::CONTINUOUS_PHASE)
+            {
+                if (decidesSymbolBySymbol<Policy>())
+                {
+                    return receiveSymbolTiles<Policy, T>(p_session, p_statistics, p_export);
+                }
+            }
+            // The session already carries the channel noise, the signal is still produced and walked only once per stage
+            std::vector<T> signal(p_session.getTotalSamples());
+            signal.resize(p_session.produce(signal.data(), signal.size()));
+            measureSamples(signal.data(), signal.size(), p_statistics);
+            if (p_export)
+            {
+                p_export(signal.data(), signal.size());
+            }
+            BitBuffer outputBinary = demodulate(signal, p_scheme);
+            p_statistics.bitErrors = m_binaryInput.countErrors(outputBinary, 0);
+            return outputBinary;
+        },
+        BitBuffer());
+}
+
+template <typename T>
+DemodulationStream<T> Modulator::startDemodulation(const ModulationScheme &p_scheme)
+{
+    return visitSchemePolicy(
+        p_scheme,
+        [this, &p_scheme](auto p_policy)
+        {
+            using Policy = decltype(p_policy);
+            DemodulationStream<T> stream = {p_scheme, 0, false, {}, {}};
+            if constexpr (!Policy::CONTINUOUS_PHASE)
+            {
+                selectSamplesPerSymbol<Policy>();
+                if (decidesSymbolBySymbol<Policy>())
+                {
+                    std::array<Oscillator, Policy::TONE_COUNT> references = createReferences<Policy>();
+                    stream.samplesPerSymbol = m_samplesPerBit;
+                    stream.isSymbolBySymbol = true;
+                    stream.references.assign(references.begin(), references.end());
+                }
+            }
+            return stream;
+        },
+        DemodulationStream<T>{ModulationScheme::UNKNOWN, 0, true, {}, {}});
+}
+
+template <typename T>
+BitBuffer Modulator::demodulateChunk(DemodulationStream<T> &p_stream, const T *p_signal, const size_t p_count)
+{
+    return visitSchemePolicy(
+        p_stream.scheme,
+        [this, &p_stream, p_signal, p_count](auto p_policy)
+        {
+            using Policy = decltype(p_policy);
+            BitBuffer outputBinary;
+            if constexpr (!Policy::CONTINUOUS_PHASE)
+            {
+                if (p_stream.isSymbolBySymbol)
+                {
+                    demodulateStreamSymbols<Policy>(p_stream, p_signal, p_count, outputBinary);
+                    return outputBinary;
+                }
+            }
+            // The receiver needs the whole signal, it is kept until the stream is finished
+            p_stream.pending.insert(p_stream.pending.end(), p_signal, p_signal + p_count);
+            return outputBinary;
+        },
+        BitBuffer());
+}
+
+template <typename T>
+BitBuffer Modulator::finishDemodulation(DemodulationStream<T> &p_stream)
+{
+    BitBuffer outputBinary = visitSchemePolicy(
+        p_stream.scheme,
+        [this, &p_stream](auto p_policy)
+        {
+            using Policy = decltype(p_policy);
+            BitBuffer outputBinary;
+            if constexpr (!Policy::CONTINUOUS_PHASE)
+            {
+                if (p_stream.isSymbolBySymbol)
+                {
+                    if (!p_stream.pending.empty())
+                    {
+                        m_samplesPerBit = p_stream.samplesPerSymbol;
+                        std::array<Oscillator, Policy::TONE_COUNT> references;
+                        std::copy_n(p_stream.references.begin(), Policy::TONE_COUNT, references.begin());
+                        correlateSymbols<Policy>(p_stream.pending.data(), p_stream.pending.size(), references,
+                                                 outputBinary);
+                    }
+                    return outputBinary;
+                }
+            }
+            return demodulate(p_stream.pending, p_stream.scheme);
+        },
+        BitBuffer());
+    p_stream.pending.clear();
+    p_stream.pending.shrink_to_fit();
+    return outputBinary;
+}
+
+bool Modulator::usesResourceGrid(const ModulationScheme &p_scheme)
+{
+    return visitSchemePolicy(
+        p_scheme, [this](auto p_policy) { return decltype(p_policy)::SUPPORTS_OFDM && m_ofdm.subcarriers > 0; }, false);
+}
+
+unsigned int Modulator::getOfdmSubcarriers() const
+{
+    return m_ofdm.subcarriers;
+}
+
+ModulationSession Modulator::startGridModulation(const ResourceGrid &p_grid, const ModulationScheme &p_scheme)
+{
+    return visitSchemePolicy(
+        p_scheme,
+        [this, &p_grid](auto p_policy)
+        {
+            using Policy = decltype(p_policy);
+            if constexpr (Policy::SUPPORTS_OFDM)
+            {
+                return createGridSession<Policy>(p_grid);
+            }
+            else
+            {
+                return ModulationSession();
+            }
+        },
+        ModulationSession());
+}
+
+template <typename T>
+std::vector<BitBuffer> Modulator::demodulateGrid(const std::vector<T> &p_signal, const ResourceGrid &p_grid,
+                                                 const ModulationScheme &p_scheme)
+{
+    return visitSchemePolicy(
+        p_scheme,
+        [this, &p_signal, &p_grid](auto p_policy)
+        {
+            using Policy = decltype(p_policy);
+            if constexpr (Policy::SUPPORTS_OFDM)
+            {
+                return demodulateGridSymbols<Policy>(p_signal, p_grid);
+            }
+            else
+            {
+                return std::vector<BitBuffer>();
+            }
+        },
+        std::vector<BitBuffer>());
+}
+
+std::vector<std::complex<double>> Modulator::modulateBaseband(const ModulationScheme &p_scheme)
+{
+    return visitSchemePolicy(
+        p_scheme,
+        [this](auto p_policy)
+        {
+            using Policy = decltype(p_policy);
+            if constexpr (Policy::CONTINUOUS_PHASE)
+            {
+                return modulateBasebandGmsk();
+            }
+            else
+            {
+                return modulateBasebandSymbols<Policy>();
+            }
+        },
+        std::vector<std::complex<double>>());
+}
+
+BitBuffer Modulator::demodulateBaseband(const std::vector<std::complex<double>> &p_signal, const ModulationScheme &p_scheme)
+{
+    return visitSchemePolicy(
+        p_scheme,
+        [this, &p_signal](auto p_policy)
+        {
+            using Policy = decltype(p_policy);
+            if constexpr (Policy::CONTINUOUS_PHASE)
+            {
+                return demodulateBasebandGmsk(p_signal);
+            }
+            else
+            {
+                return demodulateBasebandSymbols<Policy>(p_signal);
+            }
+        },
+        BitBuffer());
+}
+
+template <typename Policy>
+std::vector<std::complex<double>> Modulator::modulateBasebandSymbols()
+{
+    checkBinaryInput(Policy::BITS_PER_SYMBOL);
+    if constexpr (Policy::SUPPORTS_OFDM)
+    {
+        if (m_ofdm.subcarriers > 0)
+        {
+            return modulateOfdmSymbols<Policy>(*createOfdmEngine(true));
+        }
+    }
+    selectSamplesPerSymbol<Policy>();
+    m_basebandSymbolLength = m_basebandSamplesPerSymbol;
+
+    // Every tone keeps running on the baseband sample clock whether its symbols are sent or not,
+    // exactly like the tones of the passband modulator
+    std::array<double, Policy::TONE_COUNT> toneIndices = Policy::getToneIndices(m_parameters);
+    std::array<Oscillator, Policy::TONE_COUNT> tones;
+    for (size_t tone = 0; tone < Policy::TONE_COUNT; ++tone)
     {
-        return askDemodulation(p_signal);
+        tones[tone] = getBasebandOscillator(toneIndices[tone], DEFAULT_PHASE);
     }
-    if (p_networkTypes == "3G")
+
+    const size_t symbolCount = m_binaryInput.size() / Policy::BITS_PER_SYMBOL;
+    const std::vector<std::complex<double>> points = getEnvelopePoints<Policy>();
+    if constexpr (Policy::PULSE_SHAPING)
     {
-        return pskDemodulation(p_signal);
+        PulseShaper shaper(PulseFilterCache::getInstance().getFilter(m_pulseShaping, m_basebandSamplesPerSymbol));
+        if (shaper.isEnabled())
+        {
+            // The tone of a linear scheme is the carrier itself, its baseband phasor never rotates
+            std::vector<std::complex<double>> symbols(symbolCount);
+            for (size_t symbolIdx = 0; symbolIdx < symbolCount; ++symbolIdx)
+            {
+                symbols[symbolIdx] = points[readSymbol(symbolIdx, Policy::BITS_PER_SYMBOL)] * tones[0].value();
+            }
+            return shaper.shape(symbols);
+        }
     }
-    if (p_networkTypes == "4G")
+
+    const std::vector<SymbolShape> alphabet = Policy::getAlphabet(m_parameters);
+    std::vector<std::complex<double>> signal(symbolCount * m_basebandSamplesPerSymbol);
+    for (size_t symbolIdx = 0; symbolIdx < symbolCount; ++symbolIdx)
     {
-        return fskDemodulation(p_signal);
+        unsigned int symbol = readSymbol(symbolIdx, Policy::BITS_PER_SYMBOL);
+        const SymbolShape &shape = alphabet[symbol];
+        const std::complex<double> &envelope = points[symbol];
+        std::complex<double> *samples = signal.data() + symbolIdx * m_basebandSamplesPerSymbol;
+        for (size_t tone = 0; tone < Policy::TONE_COUNT; ++tone)
+        {
+            if (tone != shape.tone)
+            {
+                tones[tone].skip(m_basebandSamplesPerSymbol);
+                continue;
+            }
+            for (unsigned int sampleIdx = 0; sampleIdx < m_basebandSamplesPerSymbol; ++sampleIdx)
+            {
+                samples[sampleIdx] = envelope * tones[tone].next();
+            }
+        }
     }
-    if (p_networkTypes == "5G")
+    return signal;
+}
+
+template <typename Policy>
+BitBuffer Modulator::demodulateBasebandSymbols(const std::vector<std::complex<double>> &p_signal)
+{
+    if constexpr (Policy::SUPPORTS_OFDM)
     {
-        return qam16Demodulation(p_signal);
+        if (m_ofdm.subcarriers > 0)
+        {
+            std::shared_ptr<const OfdmEngine> engine = createOfdmEngine(true);
+            std::vector<std::complex<double>> samples(p_signal);
+            return demodulateOfdmSymbols<Policy>(*engine, samples);
+        }
+    }
+    BitBuffer outputBinary;
+    selectSamplesPerSymbol<Policy>();
+    m_basebandSymbolLength = m_basebandSamplesPerSymbol;
+
+    std::array<double, Policy::TONE_COUNT> toneIndices = Policy::getToneIndices(m_parameters);
+    std::array<Oscillator, Policy::TONE_COUNT> references;
+    for (size_t tone = 0; tone < Policy::TONE_COUNT; ++tone)
+    {
+        references[tone] = getBasebandOscillator(toneIndices[tone], DEFAULT_PHASE);
+    }
+
+    if constexpr (Policy::PULSE_SHAPING)
+    {
+        PulseShaper shaper(PulseFilterCache::getInstance().getFilter(m_pulseShaping, m_basebandSamplesPerSymbol));
+        if (shaper.isEnabled())
+        {
+            std::vector<std::complex<double>> points = shaper.match(p_signal);
+            for (std::complex<double> &point : points)
+            {
+                point *= std::conj(references[0].value());
+            }
+            return decideEnvelopePoints<Policy>(points, m_basebandSamplesPerSymbol);
+        }
     }
-    return "";
-}
\ No newline at end of file
+
+    for (size_t symbolIdx = 0; symbolIdx < p_signal.size(); symbolIdx += m_basebandSamplesPerSymbol)
+    {
+        // Sum x * cos (or x * sin) at passband equals half of Re (or -Im) of the baseband correlation
+        SymbolCorrelation<Policy::TONE_COUNT> correlation = {};
+        size_t symbolEnd = std::min(symbolIdx + m_basebandSamplesPerSymbol, p_signal.size());
+        for (size_t sampleIdx = symbolIdx; sampleIdx < symbolEnd; ++sampleIdx)
+        {
+            const std::complex<double> &signalValue = p_signal[sampleIdx];
+            if constexpr (Policy::USES_ENVELOPE)
+            {
+                correlation.envelope += BASEBAND_ENVELOPE_SCALE * std::abs(signalValue);
+            }
+            else
+            {
+                for (size_t tone = 0; tone < Policy::TONE_COUNT; ++tone)
+                {
+                    std::complex<double> product = signalValue * std::conj(references[tone].next());
+                    correlation.inPhase[tone] += product.real() / 2;
+                    if constexpr (Policy::USES_QUADRATURE)
+                    {
+                        correlation.quadrature[tone] -= product.imag() / 2;
+                    }
+                }
+            }
+        }
+        Policy::decide(correlation, m_basebandSamplesPerSymbol, m_parameters, outputBinary);
+    }
+    return outputBinary;
+}
+
+std::vector<double> Modulator::upconvert(const std::vector<std::complex<double>> &p_signal)
+{
+    std::vector<double> signal;
+    if (p_signal.empty())
+    {
+        return signal;
+    }
+    const size_t symbolCount = p_signal.size() / m_basebandSymbolLength;
+    signal.resize(symbolCount * m_samplesPerBit);
+
+    // The complex envelope is relative to a carrier starting at phase 0, the initial phase is part of the envelope
+    Oscillator carrier = getCarrierOscillator(DEFAULT_FREQUENCY_INDEX, 0.0);
+    // Interpolate inside a symbol only, blending the last samples of a symbol with the next symbol would
+    // shift the constellation points seen by the passband demodulator
+    const double step = static_cast<double>(m_basebandSymbolLength) / m_samplesPerBit;
+    for (size_t sampleIdx = 0; sampleIdx < signal.size(); ++sampleIdx)
+    {
+        size_t symbolStart = (sampleIdx / m_samplesPerBit) * m_basebandSymbolLength;
+        double position = (sampleIdx % m_samplesPerBit) * step;
+        size_t index = symbolStart + static_cast<size_t>(position);
+        size_t nextIndex = std::min(index + 1, symbolStart + m_basebandSymbolLength - 1);
+        double fraction = (nextIndex > index) ? position - static_cast<size_t>(position) : 0.0;
+        std::complex<double> envelope = p_signal[index] + (p_signal[nextIndex] - p_signal[index]) * fraction;
+        std::complex<double> phasor = carrier.next();
+        signal[sampleIdx] = envelope.real() * phasor.real() - envelope.imag() * phasor.imag();
+    }
+    return signal;
+}
+
+template std::vector<double> Modulator::modulate<double>(const ModulationScheme &p_scheme);
+template std::vector<float> Modulator::modulate<float>(const ModulationScheme &p_scheme);
+template std::vector<int16_t> Modulator::modulate<int16_t>(const ModulationScheme &p_scheme);
+
+template ModulationBatch<double> Modulator::modulateBatch<double>(const std::vector<BitBuffer> &p_messages,
+                                                                 const ModulationScheme &p_scheme);
+template ModulationBatch<float> Modulator::modulateBatch<float>(const std::vector<BitBuffer> &p_messages,
+                                                               const ModulationScheme &p_scheme);
+template ModulationBatch<int16_t> Modulator::modulateBatch<int16_t>(const std::vector<BitBuffer> &p_messages,
+                                                                   const ModulationScheme &p_scheme);
+
+template BitBuffer Modulator::demodulate<double>(const std::vector<double> &p_signal, const ModulationScheme &p_scheme);
+template BitBuffer Modulator::demodulate<float>(const std::vector<float> &p_signal, const ModulationScheme &p_scheme);
+template BitBuffer Modulator::demodulate<int16_t>(const std::vector<int16_t> &p_signal, const ModulationScheme &p_scheme);
+
+template BitBuffer Modulator::receiveTiled<double>(ModulationSession &p_session, const ModulationScheme &p_scheme,
+                                                   LinkStatistics &p_statistics,
+                                                   const std::function<void(const double *, size_t)> &p_export);
+template BitBuffer Modulator::receiveTiled<float>(ModulationSession &p_session, const ModulationScheme &p_scheme,
+                                                  LinkStatistics &p_statistics,
+                                                  const std::function<void(const float *, size_t)> &p_export);
+template BitBuffer Modulator::receiveTiled<int16_t>(ModulationSession &p_session, const ModulationScheme &p_scheme,
+                                                    LinkStatistics &p_statistics,
+                                                    const std::function<void(const int16_t *, size_t)> &p_export);
+
+template DemodulationStream<double> Modulator::startDemodulation<double>(const ModulationScheme &p_scheme);
+template DemodulationStream<float> Modulator::startDemodulation<float>(const ModulationScheme &p_scheme);
+template DemodulationStream<int16_t> Modulator::startDemodulation<int16_t>(const ModulationScheme &p_scheme);
+
+template BitBuffer Modulator::demodulateChunk<double>(DemodulationStream<double> &p_stream, const double *p_signal,
+                                                      const size_t p_count);
+template BitBuffer Modulator::demodulateChunk<float>(DemodulationStream<float> &p_stream, const float *p_signal,
+                                                     const size_t p_count);
+template BitBuffer Modulator::demodulateChunk<int16_t>(DemodulationStream<int16_t> &p_stream, const int16_t *p_signal,
+                                                       const size_t p_count);
+
+template BitBuffer Modulator::finishDemodulation<double>(DemodulationStream<double> &p_stream);
+template BitBuffer Modulator::finishDemodulation<float>(DemodulationStream<float> &p_stream);
+template BitBuffer Modulator::finishDemodulation<int16_t>(DemodulationStream<int16_t> &p_stream);
+
+template std::vector<BitBuffer> Modulator::demodulateGrid<double>(const std::vector<double> &p_signal, const ResourceGrid &p_grid,
+                                                                  const ModulationScheme &p_scheme);
+template std::vector<BitBuffer> Modulator::demodulateGrid<float>(const std::vector<float> &p_signal, const ResourceGrid &p_grid,
+                                                                 const ModulationScheme &p_scheme);
+template std::vector<BitBuffer> Modulator::demodulateGrid<int16_t>(const std::vector<int16_t> &p_signal, const ResourceGrid &p_grid,
+                                                                   const ModulationScheme &p_scheme);
+
+template void Modulator::addNoise<double>(std::vector<double> &p_signal);
+template void Modulator::addNoise<float>(std::vector<float> &p_signal);
+template void Modulator::addNoise<int16_t>(std::vector<int16_t> &p_signal);
@@ -0,0 +1,71 @@
+#include "ofdm.h"
+#include <algorithm>
+#include <cmath>
+
+OfdmEngine::OfdmEngine(const unsigned int p_subcarriers, const size_t p_fftSize, const size_t p_prefixLength,
+                       const size_t p_carrierBin, const double p_initialPhase)
+    : m_subcarriers(p_subcarriers), m_prefixLength(p_prefixLength), m_carrierBin(p_carrierBin), m_initialPhase(p_initialPhase),
+      m_plan(FftPlanCache::getInstance().getPlan(p_fftSize))
+{
+}
+
+unsigned int OfdmEngine::getSubcarriers() const
+{
+    return m_subcarriers;
+}
+
+size_t OfdmEngine::getSymbolLength() const
+{
+    return m_plan->getSize() + m_prefixLength;
+}
+
+size_t OfdmEngine::getSymbolCount(const size_t p_pointCount) const
+{
+    return (p_pointCount + m_subcarriers - 1) / m_subcarriers;
+}
+
+size_t OfdmEngine::getBin(const unsigned int p_subcarrier) const
+{
+    const size_t fftSize = m_plan->getSize();
+    long offset = static_cast<long>(p_subcarrier) - static_cast<long>(m_subcarriers / 2);
+    return (m_carrierBin + fftSize + offset) % fftSize;
+}
+
+std::complex<double> OfdmEngine::getSymbolPhasor(const size_t p_symbolIdx) const
+{
+    // Reduce the carrier cycles modulo the FFT size in integers, the phase stays exact for long messages
+    const size_t fftSize = m_plan->getSize();
+    size_t start = (p_symbolIdx * getSymbolLength() + m_prefixLength) % fftSize;
+    size_t turns = (start * m_carrierBin) % fftSize;
+    return std::polar(1.0, m_initialPhase + 2 * M_PI * turns / fftSize);
+}
+
+void OfdmEngine::modulateSymbol(const std::complex<double> *p_points, const size_t p_count, const size_t p_symbolIdx,
+                                std::complex<double> *p_samples) const
+{
+    // The points are scaled by 1 / sqrt(subcarriers), the signal power matches a single carrier
+    const size_t fftSize = m_plan->getSize();
+    std::complex<double> *useful = p_samples + m_prefixLength;
+    std::fill(useful, useful + fftSize, std::complex<double>());
+    const std::complex<double> phasor = getSymbolPhasor(p_symbolIdx) / std::sqrt(static_cast<double>(m_subcarriers));
+    for (size_t subcarrier = 0; subcarrier < std::min<size_t>(p_count, m_subcarriers); ++subcarrier)
+    {
+        useful[getBin(subcarrier)] = p_points[subcarrier] * phasor;
+    }
+    m_plan->inverse(useful);
+    std::copy(useful + fftSize - m_prefixLength, useful + fftSize, p_samples);
+}
+
+void OfdmEngine::demodulateSymbol(std::complex<double> *p_samples, const size_t p_symbolIdx, std::complex<double> *p_points) const
+{
+    // A real passband signal splits every subcarrier between its bin and the mirrored one, hence the factor 2
+    const size_t fftSize = m_plan->getSize();
+    std::complex<double> *useful = p_samples + m_prefixLength;
+    m_plan->forward(useful);
+    const double scale = ((m_carrierBin > 0) ? 2.0 : 1.0) * std::sqrt(static_cast<double>(m_subcarriers)) / fftSize;
+    const std::complex<double> phasor = std::conj(getSymbolPhasor(p_symbolIdx)) * scale;
+    for (unsigned int subcarrier = 0; subcarrier < m_subcarriers; ++subcarrier)
+    {
+        p_points[subcarrier] = useful[getBin(subcarrier)] * phasor;
+    }
+}
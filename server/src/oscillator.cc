@@ -0,0 +1,71 @@
+#include "oscillator.h"
+
+Oscillator::Oscillator() : Oscillator(0.0, 1.0)
+{
+}
+
+Oscillator::Oscillator(const double p_frequency, const double p_sampleRate, const double p_phase) : m_trigMode(TrigMode::LIBM)
+{
+    configure(p_frequency, p_sampleRate, p_phase);
+}
+
+void Oscillator::configure(const double p_frequency, const double p_sampleRate, const double p_phase)
+{
+    // Only the fractional part of a cycle per sample matters, whole cycles wrap around the accumulator
+    double cyclesPerSample = p_frequency / p_sampleRate;
+    cyclesPerSample -= std::floor(cyclesPerSample);
+    double scaledIncrement = cyclesPerSample * OSCILLATOR_PHASE_SCALE;
+    m_phaseIncrement = (scaledIncrement < OSCILLATOR_PHASE_SCALE) ? static_cast<uint64_t>(scaledIncrement) : 0;
+    m_initialPhase = p_phase;
+    double initialTurns = p_phase / (2 * M_PI);
+    initialTurns -= std::floor(initialTurns);
+    double scaledOffset = initialTurns * OSCILLATOR_PHASE_SCALE;
+    m_phaseOffset = (scaledOffset < OSCILLATOR_PHASE_SCALE) ? static_cast<uint64_t>(scaledOffset) : 0;
+    // The rotation stays exact, a table error would be compounded by every sample between two anchors
+    m_rotation = std::polar(1.0, 2 * M_PI * m_phaseIncrement / OSCILLATOR_PHASE_SCALE);
+    reset();
+}
+
+void Oscillator::setTrigMode(const TrigMode p_mode)
+{
+    m_trigMode = p_mode;
+    renormalize();
+}
+
+void Oscillator::reset()
+{
+    m_phaseAccumulator = 0;
+    renormalize();
+}
+
+void Oscillator::skip(const uint64_t p_samples)
+{
+    // Unsigned overflow is the modulo 2*pi wrap of the phase
+    m_phaseAccumulator += p_samples * m_phaseIncrement;
+    renormalize();
+}
+
+double Oscillator::getPhase() const
+{
+    return 2 * M_PI * (m_phaseAccumulator / OSCILLATOR_PHASE_SCALE) + m_initialPhase;
+}
+
+double Oscillator::getPhaseError() const
+{
+    double error = std::arg(m_phasor * std::polar(1.0, -getPhase()));
+    return std::fabs(error);
+}
+
+void Oscillator::renormalize()
+{
+    if (m_trigMode == TrigMode::TABLE)
+    {
+        // Unsigned overflow is the modulo 2*pi wrap of the phase
+        m_phasor = lookupPhasor(m_phaseAccumulator + m_phaseOffset);
+    }
+    else
+    {
+        m_phasor = std::polar(1.0, getPhase());
+    }
+    m_samplesSinceRenormalize = 0;
+}
@@ -0,0 +1,64 @@
+#include "parallel.h"
+#include <algorithm>
+#include <exception>
+#include <thread>
+
+unsigned int resolveThreadCount(const unsigned int p_threadCount)
+{
+    if (p_threadCount > 0)
+    {
+        return p_threadCount;
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+std::vector<SymbolRange> splitSymbolRanges(const size_t p_symbolCount, const size_t p_samplesPerSymbol,
+                                           const unsigned int p_threadCount)
+{
+    size_t rangeCount = std::min<size_t>(p_threadCount, p_symbolCount * p_samplesPerSymbol / PARALLEL_MIN_SAMPLES);
+    rangeCount = std::max<size_t>(1, std::min(rangeCount, p_symbolCount));
+    std::vector<SymbolRange> ranges(rangeCount);
+    for (size_t rangeIdx = 0; rangeIdx < rangeCount; ++rangeIdx)
+    {
+        ranges[rangeIdx] = {p_symbolCount * rangeIdx / rangeCount, p_symbolCount * (rangeIdx + 1) / rangeCount};
+    }
+    return ranges;
+}
+
+void runParallel(const size_t p_taskCount, const std::function<void(size_t)> &p_task)
+{
+    if (p_taskCount == 1)
+    {
+        p_task(0);
+        return;
+    }
+    std::vector<std::exception_ptr> errors(p_taskCount);
+    auto guardedTask = [&p_task, &errors](size_t p_taskIdx)
+    {
+        try
+        {
+            p_task(p_taskIdx);
+        }
+        catch (...)
+        {
+            errors[p_taskIdx] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t taskIdx = 1; taskIdx < p_taskCount; ++taskIdx)
+    {
+        threads.emplace_back(guardedTask, taskIdx);
+    }
+    guardedTask(0);
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    for (const std::exception_ptr &error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
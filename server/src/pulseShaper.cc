@@ -0,0 +1,187 @@
+#include "pulseShaper.h"
+#include "simdKernels.h"
+#include <cmath>
+
+PulseFilterCache &PulseFilterCache::getInstance()
+{
+    static PulseFilterCache m_instance;
+    return m_instance;
+}
+
+std::shared_ptr<const PulseFilter> PulseFilterCache::getFilter(const PulseShapingParameters &p_parameters,
+                                                               unsigned int p_samplesPerSymbol)
+{
+    if (p_parameters.shape == PulseShape::RECTANGULAR || p_samplesPerSymbol == 0)
+    {
+        return nullptr;
+    }
+    auto key = std::make_tuple(p_parameters.shape, p_parameters.factor, p_parameters.span, p_samplesPerSymbol);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto entry = m_filters.find(key);
+        if (entry != m_filters.end())
+        {
+            return entry->second;
+        }
+    }
+
+    // Build outside the lock, concurrent misses on the same key only cost a duplicated build
+    std::shared_ptr<const PulseFilter> filter = buildFilter(p_parameters, p_samplesPerSymbol);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_filters.size() >= PULSE_FILTER_CACHE_MAX_ENTRIES)
+    {
+        m_filters.clear();
+    }
+    m_filters[key] = filter;
+    return filter;
+}
+
+std::shared_ptr<const PulseFilter> PulseFilterCache::buildFilter(const PulseShapingParameters &p_parameters,
+                                                                 unsigned int p_samplesPerSymbol)
+{
+    auto filter = std::make_shared<PulseFilter>();
+    filter->samplesPerSymbol = p_samplesPerSymbol;
+    filter->span = p_parameters.span;
+    const size_t tapCount = static_cast<size_t>(p_parameters.span) * p_samplesPerSymbol;
+    const double peak = p_parameters.span / 2;
+
+    // sigma of a Gaussian filter with a -3 dB bandwidth of BT / T, in symbols
+    const double sigma = std::sqrt(std::log(2.0)) / (2 * M_PI * p_parameters.factor);
+    double energy = 0;
+    filter->taps.resize(tapCount);
+    for (size_t tapIdx = 0; tapIdx < tapCount; ++tapIdx)
+    {
+        double time = static_cast<double>(tapIdx) / p_samplesPerSymbol - peak;
+        filter->taps[tapIdx] = (p_parameters.shape == PulseShape::GAUSSIAN)
+                                   ? std::exp(-time * time / (2 * sigma * sigma))
+                                   : getRootRaisedCosine(time, p_parameters.factor);
+        energy += filter->taps[tapIdx] * filter->taps[tapIdx];
+    }
+    const double scale = std::sqrt(p_samplesPerSymbol / energy);
+    for (double &tap : filter->taps)
+    {
+        tap *= scale;
+    }
+
+    filter->branches.assign(p_samplesPerSymbol, std::vector<double>(p_parameters.span));
+    for (unsigned int branch = 0; branch < p_samplesPerSymbol; ++branch)
+    {
+        for (unsigned int tapIdx = 0; tapIdx < p_parameters.span; ++tapIdx)
+        {
+            filter->branches[branch][p_parameters.span - 1 - tapIdx] = filter->taps[tapIdx * p_samplesPerSymbol + branch];
+        }
+    }
+    return filter;
+}
+
+double PulseFilterCache::getRootRaisedCosine(double p_time, double p_rolloff)
+{
+    if (std::fabs(p_time) < 1e-9)
+    {
+        return 1 + p_rolloff * (4 / M_PI - 1);
+    }
+    // The general formula is 0 / 0 at t = +-1 / (4 * rolloff), use its limit there
+    if (p_rolloff > 0 && std::fabs(std::fabs(p_time) - 1 / (4 * p_rolloff)) < 1e-9)
+    {
+        return p_rolloff / std::sqrt(2.0) *
+               ((1 + 2 / M_PI) * std::sin(M_PI / (4 * p_rolloff)) + (1 - 2 / M_PI) * std::cos(M_PI / (4 * p_rolloff)));
+    }
+    double numerator = std::sin(M_PI * p_time * (1 - p_rolloff)) + 4 * p_rolloff * p_time * std::cos(M_PI * p_time * (1 + p_rolloff));
+    double denominator = M_PI * p_time * (1 - std::pow(4 * p_rolloff * p_time, 2));
+    return numerator / denominator;
+}
+
+PulseShaper::PulseShaper()
+{
+}
+
+PulseShaper::PulseShaper(std::shared_ptr<const PulseFilter> p_filter) : m_filter(std::move(p_filter))
+{
+}
+
+bool PulseShaper::isEnabled() const
+{
+    return m_filter != nullptr;
+}
+
+unsigned int PulseShaper::getSpan() const
+{
+    return m_filter ? m_filter->span : 1;
+}
+
+int PulseShaper::getWindowOffset() const
+{
+    return m_filter ? 1 - static_cast<int>(m_filter->span / 2) : 0;
+}
+
+void PulseShaper::shapeSymbol(const double *p_windowI, const double *p_windowQ, std::complex<double> *p_envelope) const
+{
+    const SimdKernels &kernels = SimdKernels::getInstance();
+    for (unsigned int branch = 0; branch < m_filter->samplesPerSymbol; ++branch)
+    {
+        const double *taps = m_filter->branches[branch].data();
+        p_envelope[branch] = {kernels.dot(taps, p_windowI, m_filter->span), kernels.dot(taps, p_windowQ, m_filter->span)};
+    }
+}
+
+std::vector<std::complex<double>> PulseShaper::shape(const std::vector<std::complex<double>> &p_points) const
+{
+    const size_t symbolCount = p_points.size();
+    std::vector<std::complex<double>> signal(symbolCount * m_filter->samplesPerSymbol);
+    if (symbolCount == 0)
+    {
+        return signal;
+    }
+
+    // Lay the points out as wrapped I and Q rows, the window of symbol k then starts at element k of each row
+    const size_t span = m_filter->span;
+    const long offset = getWindowOffset();
+    std::vector<double> pointsI(symbolCount + span - 1);
+    std::vector<double> pointsQ(symbolCount + span - 1);
+    for (size_t rowIdx = 0; rowIdx < pointsI.size(); ++rowIdx)
+    {
+        long symbolIdx = (static_cast<long>(rowIdx) + offset) % static_cast<long>(symbolCount);
+        const std::complex<double> &point = p_points[(symbolIdx < 0) ? symbolIdx + symbolCount : symbolIdx];
+        pointsI[rowIdx] = point.real();
+        pointsQ[rowIdx] = point.imag();
+    }
+    for (size_t symbolIdx = 0; symbolIdx < symbolCount; ++symbolIdx)
+    {
+        shapeSymbol(pointsI.data() + symbolIdx, pointsQ.data() + symbolIdx, signal.data() + symbolIdx * m_filter->samplesPerSymbol);
+    }
+    return signal;
+}
+
+std::vector<std::complex<double>> PulseShaper::match(const std::vector<std::complex<double>> &p_signal) const
+{
+    const size_t samplesPerSymbol = m_filter->samplesPerSymbol;
+    const size_t symbolCount = p_signal.size() / samplesPerSymbol;
+    std::vector<std::complex<double>> points(symbolCount);
+    if (symbolCount == 0)
+    {
+        return points;
+    }
+
+    // The pulse of symbol k peaks at sample k * samplesPerSymbol, its taps start span / 2 symbols earlier
+    const size_t total = symbolCount * samplesPerSymbol;
+    const size_t tapCount = m_filter->taps.size();
+    const size_t lead = (m_filter->span / 2) * samplesPerSymbol;
+    std::vector<double> samplesI(total + tapCount);
+    std::vector<double> samplesQ(total + tapCount);
+    for (size_t rowIdx = 0; rowIdx < samplesI.size(); ++rowIdx)
+    {
+        const std::complex<double> &sample = p_signal[(rowIdx + total - lead % total) % total];
+        samplesI[rowIdx] = sample.real();
+        samplesQ[rowIdx] = sample.imag();
+    }
+    const SimdKernels &kernels = SimdKernels::getInstance();
+    const double *taps = m_filter->taps.data();
+    for (size_t symbolIdx = 0; symbolIdx < symbolCount; ++symbolIdx)
+    {
+        size_t start = symbolIdx * samplesPerSymbol;
+        points[symbolIdx] = std::complex<double>(kernels.dot(taps, samplesI.data() + start, tapCount),
+                                                 kernels.dot(taps, samplesQ.data() + start, tapCount)) /
+                            static_cast<double>(samplesPerSymbol);
+    }
+    return points;
+}
@@ -0,0 +1,89 @@
+#include "resampler.h"
+#include <cmath>
+#include <cstdint>
+
+FarrowResampler::FarrowResampler(const double p_inputRate, const double p_outputRate)
+    : m_step(p_inputRate / p_outputRate), m_inputCount(0), m_outputCount(0), m_outputTotal(SIZE_MAX), m_history{}
+{
+}
+
+bool FarrowResampler::isPassThrough() const
+{
+    return m_step == 1.0;
+}
+
+void FarrowResampler::process(const double *p_input, const size_t p_count, std::vector<double> &p_output)
+{
+    if (isPassThrough())
+    {
+        p_output.insert(p_output.end(), p_input, p_input + p_count);
+        return;
+    }
+    for (size_t sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+    {
+        push(p_input[sampleIdx], p_output);
+    }
+}
+
+void FarrowResampler::flush(std::vector<double> &p_output)
+{
+    if (isPassThrough() || m_inputCount == 0)
+    {
+        return;
+    }
+    // Two more samples complete the neighbourhood of every output sample up to the end of the input
+    m_outputTotal = static_cast<size_t>(std::llround(m_inputCount / m_step));
+    double lastSample = m_history[RESAMPLER_TAPS - 1];
+    push(lastSample, p_output);
+    push(lastSample, p_output);
+}
+
+std::vector<double> FarrowResampler::resample(const std::vector<double> &p_input)
+{
+    std::vector<double> output;
+    if (isPassThrough())
+    {
+        return p_input;
+    }
+    output.reserve(static_cast<size_t>(std::llround(p_input.size() / m_step)));
+    process(p_input.data(), p_input.size(), output);
+    flush(output);
+    return output;
+}
+
+void FarrowResampler::push(const double p_sample, std::vector<double> &p_output)
+{
+    for (size_t tap = 0; tap + 1 < RESAMPLER_TAPS; ++tap)
+    {
+        m_history[tap] = m_history[tap + 1];
+    }
+    m_history[RESAMPLER_TAPS - 1] = p_sample;
+    ++m_inputCount;
+
+    // The history now holds x[k-3] .. x[k], so every output sample between x[k-2] and x[k-1] can be interpolated
+    const double endPosition = static_cast<double>(m_inputCount) - 2;
+    while (m_outputCount < m_outputTotal)
+    {
+        double position = m_outputCount * m_step;
+        if (position >= endPosition)
+        {
+            break;
+        }
+        p_output.push_back(interpolate(position - (endPosition - 1)));
+        ++m_outputCount;
+    }
+}
+
+double FarrowResampler::interpolate(const double p_mu) const
+{
+    // Cubic Lagrange polynomial through x[-1], x[0], x[1], x[2], written as a polynomial in mu (Farrow structure)
+    const double x0 = m_history[0];
+    const double x1 = m_history[1];
+    const double x2 = m_history[2];
+    const double x3 = m_history[3];
+    const double c0 = x1;
+    const double c1 = -x0 / 3 - x1 / 2 + x2 - x3 / 6;
+    const double c2 = x0 / 2 - x1 + x2 / 2;
+    const double c3 = (x3 - x0) / 6 + (x1 - x2) / 2;
+    return ((c3 * p_mu + c2) * p_mu + c1) * p_mu + c0;
+}
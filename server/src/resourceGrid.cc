@@ -0,0 +1,60 @@
+#include "resourceGrid.h"
+
+ResourceGrid::ResourceGrid(const unsigned int p_subcarriers, const unsigned int p_bitsPerPoint)
+    : m_subcarriers(p_subcarriers), m_bitsPerPoint(p_bitsPerPoint), m_nextElement(0)
+{
+}
+
+bool ResourceGrid::allocate(const int p_owner, const BitBuffer &p_binaryData)
+{
+    const size_t pointCount = p_binaryData.size() / m_bitsPerPoint;
+    if (pointCount == 0 || m_nextElement + pointCount > getCapacity())
+    {
+        return false;
+    }
+    m_allocations.push_back({p_owner, m_nextElement, pointCount});
+
+    // The grid always ends on a whole OFDM symbol, the new elements start out null
+    size_t lastElement = m_nextElement + pointCount;
+    size_t symbolCount = (lastElement + m_subcarriers - 1) / m_subcarriers;
+    if (m_elements.size() < symbolCount * m_subcarriers)
+    {
+        m_elements.resize(symbolCount * m_subcarriers, NULL_RESOURCE_ELEMENT);
+    }
+    for (size_t pointIdx = 0; pointIdx < pointCount; ++pointIdx)
+    {
+        m_elements[m_nextElement + pointIdx] = static_cast<int>(p_binaryData.getBits(pointIdx * m_bitsPerPoint, m_bitsPerPoint));
+    }
+    m_nextElement = (lastElement + RESOURCE_ELEMENT_GROUP_SIZE - 1) / RESOURCE_ELEMENT_GROUP_SIZE * RESOURCE_ELEMENT_GROUP_SIZE;
+    return true;
+}
+
+bool ResourceGrid::isEmpty() const
+{
+    return m_allocations.empty();
+}
+
+unsigned int ResourceGrid::getSubcarriers() const
+{
+    return m_subcarriers;
+}
+
+unsigned int ResourceGrid::getBitsPerPoint() const
+{
+    return m_bitsPerPoint;
+}
+
+size_t ResourceGrid::getCapacity() const
+{
+    return static_cast<size_t>(SLOT_SYMBOLS) * m_subcarriers;
+}
+
+const std::vector<GridAllocation> &ResourceGrid::getAllocations() const
+{
+    return m_allocations;
+}
+
+const std::vector<int> &ResourceGrid::getElements() const
+{
+    return m_elements;
+}
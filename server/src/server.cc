@@ -1,14 +1,26 @@
 #include "server.h"
+#include "simdKernels.h"
 #include <regex>
 #include <cstring>
 #include <fcntl.h>
 #include <errno.h>
+#include <filesystem>
 #include <vector>
 #include <complex>
 #include <sstream>
 
-bool saveInputFile(const std::vector<double> &p_inputWave);
-bool isBinaryString(std::string p_string);
+template <typename T>
+bool saveInputFile(const std::vector<T> &p_inputWave, FarrowResampler p_resampler);
+template <typename T>
+bool saveInputFile(ModulationSession &p_session, FarrowResampler p_resampler);
+template <typename T>
+void writeResampled(std::ofstream &p_file, FarrowResampler &p_resampler, const T *p_samples, const size_t p_count);
+void flushResampled(std::ofstream &p_file, FarrowResampler &p_resampler);
+std::string getInputFilePath();
+SampleType getSampleType();
+SimulationMode getSimulationMode();
+PipelineMode getPipelineMode();
+DownlinkMode getDownlinkMode();
 
 void initLogger()
 {
@@ -35,6 +47,7 @@ Server::Server() : m_serverRunning(true)
     initDB();
     m_carrier = std::make_unique<Carrier>();
     m_modulator = std::make_unique<Modulator>();
+    g_serverLogger.info(stringify("Modulation kernels use ", SimdKernels::getInstance().getLevelName(), " instructions"));
     m_antenna = std::make_unique<Antenna>();
 }
 
@@ -211,6 +224,9 @@ void Server::start()
                 handleClient(events[i].data.fd);
             }
         }
+
+        // The downlink payloads gathered during one wake-up go out together
+        scheduleDownlinks();
     }
 
     for (auto &th : m_threads)
@@ -281,7 +297,7 @@ void Server::handleCommand()
     }
 }
 
-std::string Server::handleClientCommand(const char *p_buffer)
+std::string Server::handleClientCommand(const char *p_buffer, const int &p_clientSocket)
 {
     std::string message;
     std::string bufferStr = p_buffer;
@@ -325,6 +341,8 @@ std::string Server::handleClientCommand(const char *p_buffer)
         else if (query == "release")
         {
             m_carrier.get()->releaseCarrier();
+            m_modulator.get()->setArithmetic(Arithmetic::FLOATING_POINT);
+            m_continuousDownlink.reset();
             message = "Release carrier setting";
         }
         else
@@ -346,32 +364,104 @@ std::string Server::handleClientCommand(const char *p_buffer)
                 message = "Missing binaryData";
                 return message;
             }
-            else if (!isBinaryString(binaryData))
+            // Several payloads separated by spaces are modulated as one batch, each is packed as it is validated
+            std::vector<std::string> asciiPayloads = {binaryData};
+            std::string asciiPayload;
+            while (strStream >> asciiPayload)
             {
-                message = "Data received is not a binary string";
-                return message;
+                asciiPayloads.push_back(asciiPayload);
+            }
+            unsigned int bitsPerSymbol = getSchemeBitsPerSymbol(m_carrier.get()->getScheme());
+            std::vector<BitBuffer> payloads(asciiPayloads.size());
+            for (size_t payloadIdx = 0; payloadIdx < asciiPayloads.size(); ++payloadIdx)
+            {
+                if (!BitBuffer::pack(asciiPayloads[payloadIdx], payloads[payloadIdx]))
+                {
+                    message = "Data received is not a binary string";
+                    return message;
+                }
+                std::cout << "Received binary data: " << asciiPayloads[payloadIdx] << std::endl;
+                if (payloads[payloadIdx].size() % bitsPerSymbol != 0)
+                {
+                    message = stringify("Binary data length must be a multiple of ", bitsPerSymbol, " for this network.");
+                    g_serverLogger.error(message);
+                    return message;
+                }
             }
-            std::cout << "Received binary data: " << binaryData << std::endl;
-            std::string passNetwork = m_carrier.get()->getNetwork();
-            if (passNetwork == "5G" && binaryData.length() % 4 != 0)
+            if (getDownlinkMode() == DownlinkMode::CONTINUOUS && !m_modulator.get()->usesResourceGrid(m_carrier.get()->getScheme()))
             {
-                message = "Binary data length must be a multiple of 4 for 16-QAM.";
-                g_serverLogger.error("Binary data length must be a multiple of 4 for 16-QAM.");
+                switch (getCarrierSampleType())
+                {
+                case SampleType::FLOAT32:
+                    continueDownlink<float>(payloads);
+                    break;
+                case SampleType::INT16:
+                    continueDownlink<int16_t>(payloads);
+                    break;
+                default:
+                    continueDownlink<double>(payloads);
+                    break;
+                }
+                return message;
             }
-            else
+            m_modulator.get()->setFrequency(m_carrier.get()->getFrequency());
+            if (m_modulator.get()->usesResourceGrid(m_carrier.get()->getScheme()))
             {
-                m_modulator.get()->setBinaryInput(binaryData);
-                m_modulator.get()->setFrequency(m_carrier.get()->getFrequency());
-                std::vector<double> signalModulated = m_modulator.get()->modulate(passNetwork);
-                if (saveInputFile(signalModulated))
+                // The command is queued whole or not at all, so no payload of it is sent without the others
+                for (const BitBuffer &data : payloads)
                 {
-                    g_serverLogger.info("Open file successfully");
-                    m_antenna.get()->visualizeData(false);
+                    if (data.size() / bitsPerSymbol > SLOT_SYMBOLS * m_modulator.get()->getOfdmSubcarriers())
+                    {
+                        message = "Binary data does not fit in one slot.";
+                        g_serverLogger.error(message);
+                        return message;
+                    }
                 }
-                else
+                for (const BitBuffer &data : payloads)
                 {
-                    g_serverLogger.error("Fail to open file for wave input data");
+                    m_pendingDownlinks.push_back({p_clientSocket, data});
                 }
+                return message;
+            }
+            if (payloads.size() > 1)
+            {
+                switch (getCarrierSampleType())
+                {
+                case SampleType::FLOAT32:
+                    transmitBatch<float>(payloads);
+                    break;
+                case SampleType::INT16:
+                    transmitBatch<int16_t>(payloads);
+                    break;
+                default:
+                    transmitBatch<double>(payloads);
+                    break;
+                }
+                return message;
+            }
+            m_modulator.get()->setBinaryInput(payloads.front());
+            ModulationSession signalModulated = m_modulator.get()->startModulation(m_carrier.get()->getScheme());
+            bool isSaved = false;
+            switch (getCarrierSampleType())
+            {
+            case SampleType::FLOAT32:
+                isSaved = saveInputFile<float>(signalModulated, m_modulator.get()->createOutputResampler());
+                break;
+            case SampleType::INT16:
+                isSaved = saveInputFile<int16_t>(signalModulated, m_modulator.get()->createOutputResampler());
+                break;
+            default:
+                isSaved = saveInputFile<double>(signalModulated, m_modulator.get()->createOutputResampler());
+                break;
+            }
+            if (isSaved)
+            {
+                g_serverLogger.info("Open file successfully");
+                m_antenna.get()->visualizeData(false);
+            }
+            else
+            {
+                g_serverLogger.error("Fail to open file for wave input data");
             }
         }
     }
@@ -382,28 +472,36 @@ std::string Server::handleClientCommand(const char *p_buffer)
             message = "Please setup network: 'server carrier setup <network> <frequency>";
             return message;
         }
-        int bitSize = 13;
-        if (m_carrier.get()->getNetwork() == "5G") {
-            bitSize *= 4;
-        }
+        // Send the same amount of symbols whatever the bits per symbol of the network
+        int bitSize = 13 * getSchemeBitsPerSymbol(m_carrier.get()->getScheme());
         std::string binaryGenerated = m_antenna.get()->randomBinaryMessageGenerator(bitSize);
-        m_modulator.get()->setBinaryInput(binaryGenerated);
+        BitBuffer binaryInput;
+        BitBuffer::pack(binaryGenerated, binaryInput);
+        m_modulator.get()->setBinaryInput(binaryInput);
         m_modulator.get()->setFrequency(m_carrier.get()->getFrequency());
-        std::vector<double> signalGenerated = m_modulator.get()->modulate(m_carrier.get()->getNetwork());
-        m_modulator.get()->addNoise(signalGenerated);
-        std::string demodBinaryData = m_modulator.get()->demodulate(signalGenerated, m_carrier.get()->getNetwork());
-        if (saveInputFile(signalGenerated))
+        BitBuffer demodBinaryData;
+        if (getSimulationMode() == SimulationMode::BASEBAND)
         {
-            m_antenna.get()->visualizeData(true);
-            g_serverLogger.info("Open file is successfull");
+            demodBinaryData = receiveBasebandUplink();
         }
         else
         {
-            g_serverLogger.error("Fail to open file for wave input data");
+            switch (getCarrierSampleType())
+            {
+            case SampleType::FLOAT32:
+                demodBinaryData = receiveUplink<float>();
+                break;
+            case SampleType::INT16:
+                demodBinaryData = receiveUplink<int16_t>();
+                break;
+            default:
+                demodBinaryData = receiveUplink<double>();
+                break;
+            }
         }
 
         g_serverLogger.info(binaryGenerated);
-        message = demodBinaryData;
+        message = demodBinaryData.toString();
     }
     else
     {
@@ -412,6 +510,251 @@ std::string Server::handleClientCommand(const char *p_buffer)
     return message;
 }
 
+void Server::scheduleDownlinks()
+{
+    if (m_pendingDownlinks.empty())
+    {
+        return;
+    }
+    const ModulationScheme scheme = m_carrier.get()->getScheme();
+    m_modulator.get()->setFrequency(m_carrier.get()->getFrequency());
+    if (!m_carrier.get()->getCarrierStatus() || !m_modulator.get()->usesResourceGrid(scheme))
+    {
+        g_serverLogger.error("The carrier changed, pending downlink payloads are dropped");
+        m_pendingDownlinks.clear();
+        return;
+    }
+
+    size_t nextDownlink = 0;
+    while (nextDownlink < m_pendingDownlinks.size())
+    {
+        ResourceGrid grid(m_modulator.get()->getOfdmSubcarriers(), getSchemeBitsPerSymbol(scheme));
+        size_t firstDownlink = nextDownlink;
+        while (nextDownlink < m_pendingDownlinks.size() &&
+               grid.allocate(m_pendingDownlinks[nextDownlink].clientSocket, m_pendingDownlinks[nextDownlink].binaryData))
+        {
+            ++nextDownlink;
+        }
+        if (grid.isEmpty())
+        {
+            // The subcarriers were reduced from the server CLI since the payload was accepted
+            g_serverLogger.error(stringify("Downlink payload of client ", m_pendingDownlinks[nextDownlink].clientSocket,
+                                           " does not fit in one slot"));
+            ++nextDownlink;
+            continue;
+        }
+        switch (getCarrierSampleType())
+        {
+        case SampleType::FLOAT32:
+            transmitSlot<float>(grid, firstDownlink);
+            break;
+        case SampleType::INT16:
+            transmitSlot<int16_t>(grid, firstDownlink);
+            break;
+        default:
+            transmitSlot<double>(grid, firstDownlink);
+            break;
+        }
+    }
+    m_pendingDownlinks.clear();
+}
+
+template <typename T>
+void Server::transmitSlot(const ResourceGrid &p_grid, const size_t p_firstDownlink)
+{
+    const ModulationScheme scheme = m_carrier.get()->getScheme();
+    ModulationSession session = m_modulator.get()->startGridModulation(p_grid, scheme);
+    std::vector<T> signalModulated(session.getTotalSamples());
+    session.produce(signalModulated.data(), signalModulated.size());
+
+    std::vector<BitBuffer> payloads = m_modulator.get()->demodulateGrid(signalModulated, p_grid, scheme);
+    for (size_t allocationIdx = 0; allocationIdx < payloads.size(); ++allocationIdx)
+    {
+        const PendingDownlink &downlink = m_pendingDownlinks[p_firstDownlink + allocationIdx];
+        if (payloads[allocationIdx] == downlink.binaryData)
+        {
+            g_serverLogger.info(stringify("Client ", downlink.clientSocket, " payload received in a slot of ",
+                                          payloads.size(), " clients"));
+        }
+        else
+        {
+            g_serverLogger.error(stringify("Client ", downlink.clientSocket, " payload received with errors: ",
+                                           payloads[allocationIdx].toString()));
+        }
+    }
+
+    if (saveInputFile(signalModulated, m_modulator.get()->createOutputResampler()))
+    {
+        g_serverLogger.info("Open file successfully");
+        m_antenna.get()->visualizeData(false);
+    }
+    else
+    {
+        g_serverLogger.error("Fail to open file for wave input data");
+    }
+}
+
+template <typename T>
+void Server::continueDownlink(const std::vector<BitBuffer> &p_payloads)
+{
+    const ModulationScheme scheme = m_carrier.get()->getScheme();
+    const size_t frequency = m_carrier.get()->getFrequency();
+    bool isContinued = m_continuousDownlink && m_continuousDownlink->scheme == scheme &&
+                       m_continuousDownlink->frequency == frequency;
+    if (!isContinued)
+    {
+        m_modulator.get()->setFrequency(frequency);
+        m_modulator.get()->setBinaryInput(p_payloads.front());
+        ModulationSession session = m_modulator.get()->startModulation(scheme);
+        // Shaped pulses carry over from one payload to the next instead of wrapping around every payload
+        session.setContinuous();
+        m_continuousDownlink.reset(new ContinuousDownlink{scheme, frequency, std::move(session),
+                                                          m_modulator.get()->createOutputResampler(), 0});
+    }
+
+    // A new waveform starts the input file over, a continued one replaces the tail written after the previous payloads
+    const std::string inputFilePath = getInputFilePath();
+    std::error_code error;
+    if (isContinued)
+    {
+        std::filesystem::resize_file(inputFilePath, m_continuousDownlink->tailOffset, error);
+    }
+    std::ofstream file(inputFilePath, isContinued ? std::ios::app : std::ios::trunc);
+    ModulationSession &session = m_continuousDownlink->session;
+    std::vector<T> chunk(MODULATION_CHUNK_SIZE);
+    for (size_t payloadIdx = 0; payloadIdx < p_payloads.size(); ++payloadIdx)
+    {
+        if (payloadIdx > 0 || isContinued)
+        {
+            session.append(p_payloads[payloadIdx]);
+        }
+        size_t count;
+        while ((count = session.produce(chunk.data(), chunk.size())) > 0)
+        {
+            if (file.is_open())
+            {
+                writeResampled(file, m_continuousDownlink->resampler, chunk.data(), count);
+            }
+        }
+    }
+    if (file.is_open())
+    {
+        // The tail is written from copies of the session and the resampler, so the file ends with the whole
+        // waveform while the next payload still continues from the last one
+        file.flush();
+        m_continuousDownlink->tailOffset = std::filesystem::file_size(inputFilePath, error);
+        ModulationSession tail = session;
+        FarrowResampler resampler = m_continuousDownlink->resampler;
+        if (error)
+        {
+            // The tail cannot be found again, the next payload starts a new waveform
+            m_continuousDownlink.reset();
+        }
+        tail.endStream();
+        size_t count;
+        while ((count = tail.produce(chunk.data(), chunk.size())) > 0)
+        {
+            writeResampled(file, resampler, chunk.data(), count);
+        }
+        flushResampled(file, resampler);
+        file.close();
+        g_serverLogger.info("Open file successfully");
+        m_antenna.get()->visualizeData(false);
+    }
+    else
+    {
+        g_serverLogger.error("Fail to open file for wave input data");
+    }
+}
+
+template <typename T>
+void Server::transmitBatch(const std::vector<BitBuffer> &p_payloads)
+{
+    ModulationBatch<T> batch = m_modulator.get()->modulateBatch<T>(p_payloads, m_carrier.get()->getScheme());
+    g_serverLogger.info(stringify("Modulated ", p_payloads.size(), " payloads in one batch of ", batch.samples.size(), " samples"));
+    if (saveInputFile(batch.samples, m_modulator.get()->createOutputResampler()))
+    {
+        g_serverLogger.info("Open file successfully");
+        m_antenna.get()->visualizeData(false);
+    }
+    else
+    {
+        g_serverLogger.error("Fail to open file for wave input data");
+    }
+}
+
+template <typename T>
+BitBuffer Server::receiveUplink()
+{
+    if (getPipelineMode() == PipelineMode::TILED)
+    {
+        return receiveTiledUplink<T>();
+    }
+    std::vector<T> signalGenerated = m_modulator.get()->modulate<T>(m_carrier.get()->getScheme());
+    m_modulator.get()->addNoise(signalGenerated);
+    BitBuffer demodBinaryData = m_modulator.get()->demodulate(signalGenerated, m_carrier.get()->getScheme());
+    if (saveInputFile(signalGenerated, m_modulator.get()->createOutputResampler()))
+    {
+        m_antenna.get()->visualizeData(true);
+        g_serverLogger.info("Open file is successfull");
+    }
+    else
+    {
+        g_serverLogger.error("Fail to open file for wave input data");
+    }
+    return demodBinaryData;
+}
+
+template <typename T>
+BitBuffer Server::receiveTiledUplink()
+{
+    const ModulationScheme scheme = m_carrier.get()->getScheme();
+    ModulationSession session = m_modulator.get()->startModulation(scheme);
+    FarrowResampler resampler = m_modulator.get()->createOutputResampler();
+    std::ofstream file(getInputFilePath());
+    std::function<void(const T *, size_t)> exportTile;
+    if (file.is_open())
+    {
+        exportTile = [&file, &resampler](const T *p_samples, size_t p_count) { writeResampled(file, resampler, p_samples, p_count); };
+    }
+
+    LinkStatistics statistics;
+    BitBuffer demodBinaryData = m_modulator.get()->receiveTiled(session, scheme, statistics, exportTile);
+    g_serverLogger.info(stringify("Uplink of ", statistics.sampleCount, " samples in ", statistics.tileCount, " tiles, mean power ",
+                                  statistics.energy / std::max<size_t>(statistics.sampleCount, 1), ", peak ",
+                                  statistics.peakAmplitude, ", ", statistics.bitErrors, " bit errors"));
+    if (file.is_open())
+    {
+        flushResampled(file, resampler);
+        file.close();
+        m_antenna.get()->visualizeData(true);
+        g_serverLogger.info("Open file is successfull");
+    }
+    else
+    {
+        g_serverLogger.error("Fail to open file for wave input data");
+    }
+    return demodBinaryData;
+}
+
+BitBuffer Server::receiveBasebandUplink()
+{
+    std::vector<std::complex<double>> signalGenerated = m_modulator.get()->modulateBaseband(m_carrier.get()->getScheme());
+    m_modulator.get()->addNoise(signalGenerated);
+    BitBuffer demodBinaryData = m_modulator.get()->demodulateBaseband(signalGenerated, m_carrier.get()->getScheme());
+    // The visualizer plots carrier samples, mix the noisy envelope up only for the plot
+    if (saveInputFile(m_modulator.get()->upconvert(signalGenerated), m_modulator.get()->createOutputResampler()))
+    {
+        m_antenna.get()->visualizeData(true);
+        g_serverLogger.info("Open file is successfull");
+    }
+    else
+    {
+        g_serverLogger.error("Fail to open file for wave input data");
+    }
+    return demodBinaryData;
+}
+
 void Server::handleClient(const int &p_clientSocket)
 {
     char buffer[BUFFER_SIZE] = {0};
@@ -427,7 +770,7 @@ void Server::handleClient(const int &p_clientSocket)
         buffer[bytesRead] = '\0';
 
         g_serverLogger.info(stringify("Received message: ", std::string(buffer)));
-        std::string message = handleClientCommand(buffer);
+        std::string message = handleClientCommand(buffer, p_clientSocket);
 
         // Convert message to char array
         strcpy(buffer, message.c_str());
@@ -469,6 +812,12 @@ void Server::handleDBCommand()
         {
             std::cout << "Fail to change data for database!" << "\n";
         }
+        else
+        {
+            // The sample rate, the oversampling, the pulse shape, OFDM or the sample type may have changed,
+            // the next DL command starts a new waveform with the new settings
+            m_continuousDownlink.reset();
+        }
     }
     else
         std::cout << "Invalid command - use help to list all the commands.\n";
@@ -497,6 +846,16 @@ std::string Server::handleClientGetDBCommand(const std::string &p_key)
     return message;
 }
 
+SampleType Server::getCarrierSampleType()
+{
+    // Fixed-point carriers compute on int16 samples whatever the configured sample type
+    if (m_carrier.get()->getArithmetic() == Arithmetic::FIXED_POINT)
+    {
+        return SampleType::INT16;
+    }
+    return getSampleType();
+}
+
 std::string Server::setNetworkForServer(const std::string &p_network, const ssize_t &p_freq)
 {
     std::string message;
@@ -506,7 +865,15 @@ std::string Server::setNetworkForServer(const std::string &p_network, const ssiz
         g_serverLogger.info("The server has support " + p_network + "!");
         if (m_carrier.get()->setNetwork(p_network))
         {
+            if (m_carrier.get()->getScheme() == ModulationScheme::UNKNOWN)
+            {
+                m_carrier.get()->releaseCarrier();
+                g_serverLogger.error(stringify("Unsupported constellation order for ", p_network, "!"));
+                return "Unsupported constellation order for " + p_network + " network";
+            }
             m_carrier.get()->setFrequency(p_freq);
+            m_modulator.get()->setArithmetic(m_carrier.get()->getArithmetic());
+            m_continuousDownlink.reset();
             message = "Successfully set up " + p_network + " network";
         }
         else
@@ -522,19 +889,90 @@ std::string Server::setNetworkForServer(const std::string &p_network, const ssiz
     return message;
 }
 
-bool saveInputFile(const std::vector<double> &p_inputWave)
+std::string getInputFilePath()
 {
     std::string inputFilePathKey = "/input";
     const char *inputFilePath = "";
     auto var = InMemDatabase::getInstance().getValue(inputFilePathKey);
     extractValue<char const *>(var, inputFilePath);
-    std::string strInputFilePath(inputFilePath);
-    std::ofstream file(strInputFilePath);
+    return std::string(inputFilePath);
+}
+
+SampleType getSampleType()
+{
+    try
+    {
+        const char *sampleType = "";
+        auto var = InMemDatabase::getInstance().getValue(SAMPLE_TYPE_KEY);
+        extractValue<char const *>(var, sampleType);
+        return parseSampleType(sampleType);
+    }
+    catch (const DBException &e)
+    {
+        return SampleType::DOUBLE;
+    }
+}
+
+DownlinkMode getDownlinkMode()
+{
+    try
+    {
+        const char *downlinkMode = "";
+        auto var = InMemDatabase::getInstance().getValue(DOWNLINK_MODE_KEY);
+        extractValue<char const *>(var, downlinkMode);
+        return (std::string(downlinkMode) == "continuous") ? DownlinkMode::CONTINUOUS : DownlinkMode::BURST;
+    }
+    catch (const DBException &e)
+    {
+        return DownlinkMode::BURST;
+    }
+}
+
+PipelineMode getPipelineMode()
+{
+    try
+    {
+        const char *pipelineMode = "";
+        auto var = InMemDatabase::getInstance().getValue(PIPELINE_MODE_KEY);
+        extractValue<char const *>(var, pipelineMode);
+        return (std::string(pipelineMode) == "tiled") ? PipelineMode::TILED : PipelineMode::MATERIALIZED;
+    }
+    catch (const DBException &e)
+    {
+        return PipelineMode::MATERIALIZED;
+    }
+}
+
+SimulationMode getSimulationMode()
+{
+    try
+    {
+        const char *simulationMode = "";
+        auto var = InMemDatabase::getInstance().getValue(SIMULATION_MODE_KEY);
+        extractValue<char const *>(var, simulationMode);
+        return (std::string(simulationMode) == "baseband") ? SimulationMode::BASEBAND : SimulationMode::PASSBAND;
+    }
+    catch (const DBException &e)
+    {
+        return SimulationMode::PASSBAND;
+    }
+}
+
+template <typename T>
+bool saveInputFile(const std::vector<T> &p_inputWave, FarrowResampler p_resampler)
+{
+    std::ofstream file(getInputFilePath());
     if (!file.is_open())
     {
         return false;
     }
-    for (auto value : p_inputWave)
+    // The visualizer reads physical signal values at /fs, whatever the sample type and simulation rate were
+    std::vector<double> inputWave(p_inputWave.size());
+    for (size_t sampleIdx = 0; sampleIdx < p_inputWave.size(); ++sampleIdx)
+    {
+        inputWave[sampleIdx] = SampleTraits<T>::toDouble(p_inputWave[sampleIdx]);
+    }
+    for (auto value : p_resampler.resample(inputWave))
     {
         file << value << std::endl;
     }
@@ -542,14 +980,48 @@ bool saveInputFile(const std::vector<double> &p_inputWave)
     return true;
 }
 
-bool isBinaryString(std::string p_string)
+template <typename T>
+bool saveInputFile(ModulationSession &p_session, FarrowResampler p_resampler)
 {
-    for (char cur_char : p_string)
+    std::ofstream file(getInputFilePath());
+    if (!file.is_open())
     {
-        if (cur_char != '0' && cur_char != '1')
-        {
-            return false;
-        }
+        return false;
+    }
+    // Samples are written as they are modulated, only one chunk is held in memory at a time
+    std::vector<T> chunk(MODULATION_CHUNK_SIZE);
+    size_t count;
+    while ((count = p_session.produce(chunk.data(), chunk.size())) > 0)
+    {
+        writeResampled(file, p_resampler, chunk.data(), count);
     }
+    flushResampled(file, p_resampler);
+    file.close();
     return true;
+}
+
+template <typename T>
+void writeResampled(std::ofstream &p_file, FarrowResampler &p_resampler, const T *p_samples, const size_t p_count)
+{
+    std::vector<double> values(p_count);
+    for (size_t sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+    {
+        values[sampleIdx] = SampleTraits<T>::toDouble(p_samples[sampleIdx]);
+    }
+    std::vector<double> resampled;
+    p_resampler.process(values.data(), p_count, resampled);
+    for (double value : resampled)
+    {
+        p_file << value << '\n';
+    }
+}
+
+void flushResampled(std::ofstream &p_file, FarrowResampler &p_resampler)
+{
+    std::vector<double> resampled;
+    p_resampler.flush(resampled);
+    for (double value : resampled)
+    {
+        p_file << value << '\n';
+    }
 }
\ No newline at end of file
@@ -0,0 +1,2028 @@
+#include "simdKernels.h"
+#include "sampleTraits.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_KERNELS_X86
+#endif
+
+namespace
+{
+    void synthesizeScalar(double *p_signal, size_t p_count, const std::complex<double> &p_carrier,
+                          const std::complex<double> &p_rotation, double p_inPhaseGain, double p_quadratureGain)
+    {
+        double re = p_carrier.real();
+        double im = p_carrier.imag();
+        const double stepRe = p_rotation.real();
+        const double stepIm = p_rotation.imag();
+        for (size_t sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+        {
+            p_signal[sampleIdx] = p_inPhaseGain * re + p_quadratureGain * im;
+            double nextRe = re * stepRe - im * stepIm;
+            im = re * stepIm + im * stepRe;
+            re = nextRe;
+        }
+    }
+
+    void combineScalar(double *p_signal, size_t p_count, const double *p_inPhase, const double *p_quadrature,
+                       double p_inPhaseGain, double p_quadratureGain)
+    {
+        for (size_t sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+        {
+            p_signal[sampleIdx] = p_inPhaseGain * p_inPhase[sampleIdx] + p_quadratureGain * p_quadrature[sampleIdx];
+        }
+    }
+
+    void combineFloatScalar(float *p_signal, size_t p_count, const float *p_inPhase, const float *p_quadrature,
+                            float p_inPhaseGain, float p_quadratureGain)
+    {
+        for (size_t sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+        {
+            p_signal[sampleIdx] = p_inPhaseGain * p_inPhase[sampleIdx] + p_quadratureGain * p_quadrature[sampleIdx];
+        }
+    }
+
+    double dotScalar(const double *p_first, const double *p_second, size_t p_count)
+    {
+        double sum = 0;
+        for (size_t sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+        {
+            sum += p_first[sampleIdx] * p_second[sampleIdx];
+        }
+        return sum;
+    }
+
+    void slideScalar(const double *p_signalI, const double *p_signalQ, size_t p_outputCount, const double *p_referenceI,
+                     const double *p_referenceQ, size_t p_tapCount, double *p_sumsI, double *p_sumsQ)
+    {
+        for (size_t outputIdx = 0; outputIdx < p_outputCount; ++outputIdx)
+        {
+            double sumI = 0;
+            double sumQ = 0;
+            for (size_t tapIdx = 0; tapIdx < p_tapCount; ++tapIdx)
+            {
+                double sampleI = p_signalI[outputIdx + tapIdx];
+                double sampleQ = p_signalQ[outputIdx + tapIdx];
+                sumI += sampleI * p_referenceI[tapIdx] + sampleQ * p_referenceQ[tapIdx];
+                sumQ += sampleQ * p_referenceI[tapIdx] - sampleI * p_referenceQ[tapIdx];
+            }
+            p_sumsI[outputIdx] = sumI;
+            p_sumsQ[outputIdx] = sumQ;
+        }
+    }
+
+    void correlateScalar(const double *p_signal, size_t p_symbolLength, size_t p_symbolCount, const double *p_inPhase,
+                         const double *p_quadrature, double *p_inPhaseSums, double *p_quadratureSums)
+    {
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const double *symbol = p_signal + symbolIdx * p_symbolLength;
+            double inPhase = 0;
+            double quadrature = 0;
+            for (size_t sampleIdx = 0; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                inPhase += symbol[sampleIdx] * p_inPhase[sampleIdx];
+                quadrature += symbol[sampleIdx] * p_quadrature[sampleIdx];
+            }
+            p_inPhaseSums[symbolIdx] = inPhase;
+            p_quadratureSums[symbolIdx] = quadrature;
+        }
+    }
+
+    void correlateFloatScalar(const float *p_signal, size_t p_symbolLength, size_t p_symbolCount, const float *p_inPhase,
+                              const float *p_quadrature, double *p_inPhaseSums, double *p_quadratureSums)
+    {
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const float *symbol = p_signal + symbolIdx * p_symbolLength;
+            float inPhase = 0;
+            float quadrature = 0;
+            for (size_t sampleIdx = 0; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                inPhase += symbol[sampleIdx] * p_inPhase[sampleIdx];
+                quadrature += symbol[sampleIdx] * p_quadrature[sampleIdx];
+            }
+            p_inPhaseSums[symbolIdx] = inPhase;
+            p_quadratureSums[symbolIdx] = quadrature;
+        }
+    }
+
+    void correlateQ15Scalar(const int16_t *p_signal, size_t p_symbolLength, size_t p_symbolCount, const int16_t *p_inPhase,
+                            const int16_t *p_quadrature, double *p_inPhaseSums, double *p_quadratureSums)
+    {
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const int16_t *symbol = p_signal + symbolIdx * p_symbolLength;
+            int64_t inPhase = 0;
+            int64_t quadrature = 0;
+            for (size_t sampleIdx = 0; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                inPhase += symbol[sampleIdx] * p_inPhase[sampleIdx];
+                quadrature += symbol[sampleIdx] * p_quadrature[sampleIdx];
+            }
+            p_inPhaseSums[symbolIdx] = inPhase;
+            p_quadratureSums[symbolIdx] = quadrature;
+        }
+    }
+
+    void envelopeScalar(const double *p_signal, size_t p_symbolLength, size_t p_symbolCount, double *p_sums)
+    {
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const double *symbol = p_signal + symbolIdx * p_symbolLength;
+            double envelope = 0;
+            for (size_t sampleIdx = 0; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                envelope += std::fabs(symbol[sampleIdx]);
+            }
+            p_sums[symbolIdx] = envelope;
+        }
+    }
+
+    void envelopeFloatScalar(const float *p_signal, size_t p_symbolLength, size_t p_symbolCount, double *p_sums)
+    {
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const float *symbol = p_signal + symbolIdx * p_symbolLength;
+            float envelope = 0;
+            for (size_t sampleIdx = 0; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                envelope += std::fabs(symbol[sampleIdx]);
+            }
+            p_sums[symbolIdx] = envelope;
+        }
+    }
+
+    void envelopeQ15Scalar(const int16_t *p_signal, size_t p_symbolLength, size_t p_symbolCount, double *p_sums)
+    {
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const int16_t *symbol = p_signal + symbolIdx * p_symbolLength;
+            int64_t envelope = 0;
+            for (size_t sampleIdx = 0; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                envelope += std::abs(symbol[sampleIdx]);
+            }
+            p_sums[symbolIdx] = envelope;
+        }
+    }
+
+    void goertzelScalar(const double *p_signal, size_t p_symbolLength, size_t p_symbolCount, const double *p_frequencies,
+                        size_t p_toneCount, double *p_powers)
+    {
+        for (size_t toneIdx = 0; toneIdx < p_toneCount; ++toneIdx)
+        {
+            const double coefficient = 2 * std::cos(p_frequencies[toneIdx]);
+            for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+            {
+                const double *symbol = p_signal + symbolIdx * p_symbolLength;
+                double state1 = 0;
+                double state2 = 0;
+                for (size_t sampleIdx = 0; sampleIdx < p_symbolLength; ++sampleIdx)
+                {
+                    double state0 = symbol[sampleIdx] + coefficient * state1 - state2;
+                    state2 = state1;
+                    state1 = state0;
+                }
+                p_powers[symbolIdx * p_toneCount + toneIdx] = state1 * state1 + state2 * state2 - coefficient * state1 * state2;
+            }
+        }
+    }
+
+    void combineQ15Scalar(int16_t *p_signal, size_t p_count, const int16_t *p_inPhase, const int16_t *p_quadrature,
+                          int16_t p_inPhaseGain, int16_t p_quadratureGain)
+    {
+        for (size_t sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+        {
+            int32_t sum = p_inPhaseGain * p_inPhase[sampleIdx] + p_quadratureGain * p_quadrature[sampleIdx];
+            p_signal[sampleIdx] = static_cast<int16_t>(std::clamp<int32_t>((sum + Q15_ROUNDING) >> 15, INT16_MIN, INT16_MAX));
+        }
+    }
+
+    /**
+     * @brief Reverse the bit order of a word, vector kernels gather the first character in bit 0 and packed series
+     * keep it in bit 63
+     */
+    uint64_t reverseBits(uint64_t p_word)
+    {
+        p_word = ((p_word >> 1) & 0x5555555555555555ULL) | ((p_word & 0x5555555555555555ULL) << 1);
+        p_word = ((p_word >> 2) & 0x3333333333333333ULL) | ((p_word & 0x3333333333333333ULL) << 2);
+        p_word = ((p_word >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((p_word & 0x0F0F0F0F0F0F0F0FULL) << 4);
+        return __builtin_bswap64(p_word);
+    }
+
+    bool packBitsScalar(const char *p_ascii, size_t p_count, uint64_t *p_words)
+    {
+        // '0' - '0' and '1' - '0' are the only differences below 2, every other character sets a higher bit
+        unsigned int invalid = 0;
+        for (size_t wordIdx = 0; wordIdx * 64 < p_count; ++wordIdx)
+        {
+            const char *chars = p_ascii + wordIdx * 64;
+            const size_t count = std::min<size_t>(64, p_count - wordIdx * 64);
+            uint64_t word = 0;
+            for (size_t charIdx = 0; charIdx < count; ++charIdx)
+            {
+                unsigned int digit = static_cast<unsigned char>(chars[charIdx]) - static_cast<unsigned int>('0');
+                invalid |= digit & ~1u;
+                word |= static_cast<uint64_t>(digit & 1) << (63 - charIdx);
+            }
+            p_words[wordIdx] = word;
+        }
+        return invalid == 0;
+    }
+
+    /**
+     * @brief Spread the carrier over the vector lanes: lane l starts at p_carrier * p_rotation^l
+     * and every lane is rotated by p_rotation^lanes per vector step
+     *
+     * @return p_rotation^lanes
+     */
+    std::complex<double> initLanes(double *p_laneRe, double *p_laneIm, size_t p_lanes,
+                                   const std::complex<double> &p_carrier, const std::complex<double> &p_rotation)
+    {
+        std::complex<double> lane = p_carrier;
+        std::complex<double> step = 1.0;
+        for (size_t laneIdx = 0; laneIdx < p_lanes; ++laneIdx)
+        {
+            p_laneRe[laneIdx] = lane.real();
+            p_laneIm[laneIdx] = lane.imag();
+            lane *= p_rotation;
+            step *= p_rotation;
+        }
+        return step;
+    }
+
+    /**
+     * @brief Write the samples left over after the last full vector from the current lane phasors
+     */
+    void finishLanes(double *p_signal, size_t p_count, const double *p_laneRe, const double *p_laneIm,
+                     double p_inPhaseGain, double p_quadratureGain)
+    {
+        for (size_t laneIdx = 0; laneIdx < p_count; ++laneIdx)
+        {
+            p_signal[laneIdx] = p_inPhaseGain * p_laneRe[laneIdx] + p_quadratureGain * p_laneIm[laneIdx];
+        }
+    }
+
+#ifdef SIMD_KERNELS_X86
+    /// @brief The most double lanes a vector holds
+    constexpr size_t GOERTZEL_MAX_LANES = 8;
+
+    /**
+     * @brief A tone of the polyphase Goertzel filter: lane l of a vector runs the samples l, l + lanes, l + 2 * lanes...
+     * of a symbol, a Goertzel filter at lanes * w, and the partial DFTs of the lanes are recombined with e^{-jwl}
+     */
+    struct GoertzelLanes
+    {
+        /// @brief 2 * cos(lanes * w), the recurrence coefficient of every lane
+        double coefficient;
+
+        /// @brief e^{-j * lanes * w}, turns the last two states of a lane into its partial DFT
+        std::complex<double> rotation;
+
+        /// @brief e^{-jwl} of every lane l
+        std::array<std::complex<double>, GOERTZEL_MAX_LANES> twiddles;
+    };
+
+    std::vector<GoertzelLanes> initGoertzelLanes(const double *p_frequencies, size_t p_toneCount, size_t p_lanes)
+    {
+        std::vector<GoertzelLanes> tones(p_toneCount);
+        for (size_t toneIdx = 0; toneIdx < p_toneCount; ++toneIdx)
+        {
+            const double frequency = p_frequencies[toneIdx];
+            tones[toneIdx].coefficient = 2 * std::cos(p_lanes * frequency);
+            tones[toneIdx].rotation = std::polar(1.0, -(p_lanes * frequency));
+            for (size_t laneIdx = 0; laneIdx < p_lanes; ++laneIdx)
+            {
+                tones[toneIdx].twiddles[laneIdx] = std::polar(1.0, -(laneIdx * frequency));
+            }
+        }
+        return tones;
+    }
+
+    /**
+     * @brief Sum the partial DFTs of the lanes of a tone, every lane ran the same amount of steps, so the phase of
+     * the last step is common to all of them and left out of the power
+     */
+    double combineGoertzelLanes(const GoertzelLanes &p_tone, const double *p_states1, const double *p_states2, size_t p_lanes)
+    {
+        std::complex<double> sum = 0;
+        for (size_t laneIdx = 0; laneIdx < p_lanes; ++laneIdx)
+        {
+            sum += p_tone.twiddles[laneIdx] * (p_states1[laneIdx] - p_tone.rotation * p_states2[laneIdx]);
+        }
+        return std::norm(sum);
+    }
+
+    __attribute__((target("sse2"))) void synthesizeSse2(double *p_signal, size_t p_count, const std::complex<double> &p_carrier,
+                                                        const std::complex<double> &p_rotation, double p_inPhaseGain, double p_quadratureGain)
+    {
+        constexpr size_t LANES = 2;
+        alignas(16) double laneRe[LANES];
+        alignas(16) double laneIm[LANES];
+        std::complex<double> step = initLanes(laneRe, laneIm, LANES, p_carrier, p_rotation);
+
+        __m128d re = _mm_load_pd(laneRe);
+        __m128d im = _mm_load_pd(laneIm);
+        const __m128d stepRe = _mm_set1_pd(step.real());
+        const __m128d stepIm = _mm_set1_pd(step.imag());
+        const __m128d gainI = _mm_set1_pd(p_inPhaseGain);
+        const __m128d gainQ = _mm_set1_pd(p_quadratureGain);
+        size_t sampleIdx = 0;
+        for (; sampleIdx + LANES <= p_count; sampleIdx += LANES)
+        {
+            _mm_storeu_pd(p_signal + sampleIdx, _mm_add_pd(_mm_mul_pd(gainI, re), _mm_mul_pd(gainQ, im)));
+            __m128d nextRe = _mm_sub_pd(_mm_mul_pd(re, stepRe), _mm_mul_pd(im, stepIm));
+            im = _mm_add_pd(_mm_mul_pd(re, stepIm), _mm_mul_pd(im, stepRe));
+            re = nextRe;
+        }
+        _mm_store_pd(laneRe, re);
+        _mm_store_pd(laneIm, im);
+        finishLanes(p_signal + sampleIdx, p_count - sampleIdx, laneRe, laneIm, p_inPhaseGain, p_quadratureGain);
+    }
+
+    __attribute__((target("sse2"))) void combineSse2(double *p_signal, size_t p_count, const double *p_inPhase, const double *p_quadrature,
+                                                     double p_inPhaseGain, double p_quadratureGain)
+    {
+        constexpr size_t LANES = 2;
+        const __m128d gainI = _mm_set1_pd(p_inPhaseGain);
+        const __m128d gainQ = _mm_set1_pd(p_quadratureGain);
+        size_t sampleIdx = 0;
+        for (; sampleIdx + LANES <= p_count; sampleIdx += LANES)
+        {
+            __m128d inPhase = _mm_mul_pd(gainI, _mm_loadu_pd(p_inPhase + sampleIdx));
+            __m128d quadrature = _mm_mul_pd(gainQ, _mm_loadu_pd(p_quadrature + sampleIdx));
+            _mm_storeu_pd(p_signal + sampleIdx, _mm_add_pd(inPhase, quadrature));
+        }
+        combineScalar(p_signal + sampleIdx, p_count - sampleIdx, p_inPhase + sampleIdx, p_quadrature + sampleIdx,
+                      p_inPhaseGain, p_quadratureGain);
+    }
+
+    __attribute__((target("sse2"))) void combineFloatSse2(float *p_signal, size_t p_count, const float *p_inPhase, const float *p_quadrature,
+                                                          float p_inPhaseGain, float p_quadratureGain)
+    {
+        constexpr size_t LANES = 4;
+        const __m128 gainI = _mm_set1_ps(p_inPhaseGain);
+        const __m128 gainQ = _mm_set1_ps(p_quadratureGain);
+        size_t sampleIdx = 0;
+        for (; sampleIdx + LANES <= p_count; sampleIdx += LANES)
+        {
+            __m128 inPhase = _mm_mul_ps(gainI, _mm_loadu_ps(p_inPhase + sampleIdx));
+            __m128 quadrature = _mm_mul_ps(gainQ, _mm_loadu_ps(p_quadrature + sampleIdx));
+            _mm_storeu_ps(p_signal + sampleIdx, _mm_add_ps(inPhase, quadrature));
+        }
+        combineFloatScalar(p_signal + sampleIdx, p_count - sampleIdx, p_inPhase + sampleIdx, p_quadrature + sampleIdx,
+                           p_inPhaseGain, p_quadratureGain);
+    }
+
+    __attribute__((target("sse2"))) double dotSse2(const double *p_first, const double *p_second, size_t p_count)
+    {
+        constexpr size_t LANES = 2;
+        alignas(16) double lanes[LANES];
+        __m128d sum = _mm_setzero_pd();
+        size_t sampleIdx = 0;
+        for (; sampleIdx + LANES <= p_count; sampleIdx += LANES)
+        {
+            sum = _mm_add_pd(sum, _mm_mul_pd(_mm_loadu_pd(p_first + sampleIdx), _mm_loadu_pd(p_second + sampleIdx)));
+        }
+        _mm_store_pd(lanes, sum);
+        return lanes[0] + lanes[1] + dotScalar(p_first + sampleIdx, p_second + sampleIdx, p_count - sampleIdx);
+    }
+
+    __attribute__((target("sse2"))) void slideSse2(const double *p_signalI, const double *p_signalQ, size_t p_outputCount,
+                                                   const double *p_referenceI, const double *p_referenceQ, size_t p_tapCount,
+                                                   double *p_sumsI, double *p_sumsQ)
+    {
+        constexpr size_t LANES = 2;
+        size_t outputIdx = 0;
+        // Two vectors of consecutive outputs stay in registers over all the taps, every tap is broadcast once
+        for (; outputIdx + 2 * LANES <= p_outputCount; outputIdx += 2 * LANES)
+        {
+            __m128d sumI0 = _mm_setzero_pd();
+            __m128d sumQ0 = _mm_setzero_pd();
+            __m128d sumI1 = _mm_setzero_pd();
+            __m128d sumQ1 = _mm_setzero_pd();
+            for (size_t tapIdx = 0; tapIdx < p_tapCount; ++tapIdx)
+            {
+                __m128d referenceI = _mm_set1_pd(p_referenceI[tapIdx]);
+                __m128d referenceQ = _mm_set1_pd(p_referenceQ[tapIdx]);
+                const double *windowI = p_signalI + outputIdx + tapIdx;
+                const double *windowQ = p_signalQ + outputIdx + tapIdx;
+                __m128d sampleI0 = _mm_loadu_pd(windowI);
+                __m128d sampleQ0 = _mm_loadu_pd(windowQ);
+                __m128d sampleI1 = _mm_loadu_pd(windowI + LANES);
+                __m128d sampleQ1 = _mm_loadu_pd(windowQ + LANES);
+                sumI0 = _mm_add_pd(sumI0, _mm_add_pd(_mm_mul_pd(sampleI0, referenceI), _mm_mul_pd(sampleQ0, referenceQ)));
+                sumQ0 = _mm_add_pd(sumQ0, _mm_sub_pd(_mm_mul_pd(sampleQ0, referenceI), _mm_mul_pd(sampleI0, referenceQ)));
+                sumI1 = _mm_add_pd(sumI1, _mm_add_pd(_mm_mul_pd(sampleI1, referenceI), _mm_mul_pd(sampleQ1, referenceQ)));
+                sumQ1 = _mm_add_pd(sumQ1, _mm_sub_pd(_mm_mul_pd(sampleQ1, referenceI), _mm_mul_pd(sampleI1, referenceQ)));
+            }
+            _mm_storeu_pd(p_sumsI + outputIdx, sumI0);
+            _mm_storeu_pd(p_sumsQ + outputIdx, sumQ0);
+            _mm_storeu_pd(p_sumsI + outputIdx + LANES, sumI1);
+            _mm_storeu_pd(p_sumsQ + outputIdx + LANES, sumQ1);
+        }
+        slideScalar(p_signalI + outputIdx, p_signalQ + outputIdx, p_outputCount - outputIdx, p_referenceI, p_referenceQ,
+                    p_tapCount, p_sumsI + outputIdx, p_sumsQ + outputIdx);
+    }
+
+    __attribute__((target("sse2"))) void correlateSse2(const double *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                                                       const double *p_inPhase, const double *p_quadrature,
+                                                       double *p_inPhaseSums, double *p_quadratureSums)
+    {
+        constexpr size_t LANES = 2;
+        alignas(16) double lanesI[LANES];
+        alignas(16) double lanesQ[LANES];
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const double *symbol = p_signal + symbolIdx * p_symbolLength;
+            __m128d sumI = _mm_setzero_pd();
+            __m128d sumQ = _mm_setzero_pd();
+            size_t sampleIdx = 0;
+            for (; sampleIdx + LANES <= p_symbolLength; sampleIdx += LANES)
+            {
+                __m128d samples = _mm_loadu_pd(symbol + sampleIdx);
+                sumI = _mm_add_pd(sumI, _mm_mul_pd(samples, _mm_loadu_pd(p_inPhase + sampleIdx)));
+                sumQ = _mm_add_pd(sumQ, _mm_mul_pd(samples, _mm_loadu_pd(p_quadrature + sampleIdx)));
+            }
+            _mm_store_pd(lanesI, sumI);
+            _mm_store_pd(lanesQ, sumQ);
+            double inPhase = lanesI[0] + lanesI[1];
+            double quadrature = lanesQ[0] + lanesQ[1];
+            for (; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                inPhase += symbol[sampleIdx] * p_inPhase[sampleIdx];
+                quadrature += symbol[sampleIdx] * p_quadrature[sampleIdx];
+            }
+            p_inPhaseSums[symbolIdx] = inPhase;
+            p_quadratureSums[symbolIdx] = quadrature;
+        }
+    }
+
+    __attribute__((target("sse2"))) void correlateFloatSse2(const float *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                                                            const float *p_inPhase, const float *p_quadrature,
+                                                            double *p_inPhaseSums, double *p_quadratureSums)
+    {
+        constexpr size_t LANES = 4;
+        alignas(16) float lanesI[LANES];
+        alignas(16) float lanesQ[LANES];
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const float *symbol = p_signal + symbolIdx * p_symbolLength;
+            __m128 sumI = _mm_setzero_ps();
+            __m128 sumQ = _mm_setzero_ps();
+            size_t sampleIdx = 0;
+            for (; sampleIdx + LANES <= p_symbolLength; sampleIdx += LANES)
+            {
+                __m128 samples = _mm_loadu_ps(symbol + sampleIdx);
+                sumI = _mm_add_ps(sumI, _mm_mul_ps(samples, _mm_loadu_ps(p_inPhase + sampleIdx)));
+                sumQ = _mm_add_ps(sumQ, _mm_mul_ps(samples, _mm_loadu_ps(p_quadrature + sampleIdx)));
+            }
+            _mm_store_ps(lanesI, sumI);
+            _mm_store_ps(lanesQ, sumQ);
+            float inPhase = (lanesI[0] + lanesI[1]) + (lanesI[2] + lanesI[3]);
+            float quadrature = (lanesQ[0] + lanesQ[1]) + (lanesQ[2] + lanesQ[3]);
+            for (; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                inPhase += symbol[sampleIdx] * p_inPhase[sampleIdx];
+                quadrature += symbol[sampleIdx] * p_quadrature[sampleIdx];
+            }
+            p_inPhaseSums[symbolIdx] = inPhase;
+            p_quadratureSums[symbolIdx] = quadrature;
+        }
+    }
+
+    __attribute__((target("sse2"))) void correlateQ15Sse2(const int16_t *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                                                          const int16_t *p_inPhase, const int16_t *p_quadrature,
+                                                          double *p_inPhaseSums, double *p_quadratureSums)
+    {
+        constexpr size_t LANES = 8;
+        alignas(16) int64_t lanesI[2];
+        alignas(16) int64_t lanesQ[2];
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const int16_t *symbol = p_signal + symbolIdx * p_symbolLength;
+            __m128i sumI = _mm_setzero_si128();
+            __m128i sumQ = _mm_setzero_si128();
+            size_t sampleIdx = 0;
+            for (; sampleIdx + LANES <= p_symbolLength; sampleIdx += LANES)
+            {
+                __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i *>(symbol + sampleIdx));
+                __m128i productsI = _mm_madd_epi16(samples, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_inPhase + sampleIdx)));
+                __m128i productsQ = _mm_madd_epi16(samples, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_quadrature + sampleIdx)));
+                // Sign extend the four pair sums to 64 bits, SSE2 has no pmovsxdq
+                __m128i signI = _mm_srai_epi32(productsI, 31);
+                __m128i signQ = _mm_srai_epi32(productsQ, 31);
+                sumI = _mm_add_epi64(sumI, _mm_unpacklo_epi32(productsI, signI));
+                sumI = _mm_add_epi64(sumI, _mm_unpackhi_epi32(productsI, signI));
+                sumQ = _mm_add_epi64(sumQ, _mm_unpacklo_epi32(productsQ, signQ));
+                sumQ = _mm_add_epi64(sumQ, _mm_unpackhi_epi32(productsQ, signQ));
+            }
+            _mm_store_si128(reinterpret_cast<__m128i *>(lanesI), sumI);
+            _mm_store_si128(reinterpret_cast<__m128i *>(lanesQ), sumQ);
+            int64_t inPhase = lanesI[0] + lanesI[1];
+            int64_t quadrature = lanesQ[0] + lanesQ[1];
+            for (; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                inPhase += symbol[sampleIdx] * p_inPhase[sampleIdx];
+                quadrature += symbol[sampleIdx] * p_quadrature[sampleIdx];
+            }
+            p_inPhaseSums[symbolIdx] = static_cast<double>(inPhase);
+            p_quadratureSums[symbolIdx] = static_cast<double>(quadrature);
+        }
+    }
+
+    __attribute__((target("sse2"))) void envelopeSse2(const double *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                                                      double *p_sums)
+    {
+        constexpr size_t LANES = 2;
+        alignas(16) double lanes[LANES];
+        const __m128d signMask = _mm_set1_pd(-0.0);
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const double *symbol = p_signal + symbolIdx * p_symbolLength;
+            __m128d sum = _mm_setzero_pd();
+            size_t sampleIdx = 0;
+            for (; sampleIdx + LANES <= p_symbolLength; sampleIdx += LANES)
+            {
+                sum = _mm_add_pd(sum, _mm_andnot_pd(signMask, _mm_loadu_pd(symbol + sampleIdx)));
+            }
+            _mm_store_pd(lanes, sum);
+            double envelope = lanes[0] + lanes[1];
+            for (; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                envelope += std::fabs(symbol[sampleIdx]);
+            }
+            p_sums[symbolIdx] = envelope;
+        }
+    }
+
+    __attribute__((target("sse2"))) void envelopeFloatSse2(const float *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                                                           double *p_sums)
+    {
+        constexpr size_t LANES = 4;
+        alignas(16) float lanes[LANES];
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const float *symbol = p_signal + symbolIdx * p_symbolLength;
+            __m128 sum = _mm_setzero_ps();
+            size_t sampleIdx = 0;
+            for (; sampleIdx + LANES <= p_symbolLength; sampleIdx += LANES)
+            {
+                sum = _mm_add_ps(sum, _mm_andnot_ps(signMask, _mm_loadu_ps(symbol + sampleIdx)));
+            }
+            _mm_store_ps(lanes, sum);
+            float envelope = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+            for (; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                envelope += std::fabs(symbol[sampleIdx]);
+            }
+            p_sums[symbolIdx] = envelope;
+        }
+    }
+
+    __attribute__((target("sse2"))) void envelopeQ15Sse2(const int16_t *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                                                         double *p_sums)
+    {
+        constexpr size_t LANES = 8;
+        alignas(16) int64_t lanes[2];
+        const __m128i one = _mm_set1_epi16(1);
+        const __m128i zero = _mm_setzero_si128();
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const int16_t *symbol = p_signal + symbolIdx * p_symbolLength;
+            __m128i sum = _mm_setzero_si128();
+            size_t sampleIdx = 0;
+            for (; sampleIdx + LANES <= p_symbolLength; sampleIdx += LANES)
+            {
+                __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i *>(symbol + sampleIdx));
+                // |x| is x * sign(x) summed in pairs to 32 bits, -32768 has no 16-bit magnitude
+                __m128i magnitudes = _mm_madd_epi16(samples, _mm_or_si128(_mm_srai_epi16(samples, 15), one));
+                sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(magnitudes, zero));
+                sum = _mm_add_epi64(sum, _mm_unpackhi_epi32(magnitudes, zero));
+            }
+            _mm_store_si128(reinterpret_cast<__m128i *>(lanes), sum);
+            int64_t envelope = lanes[0] + lanes[1];
+            for (; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                envelope += std::abs(symbol[sampleIdx]);
+            }
+            p_sums[symbolIdx] = static_cast<double>(envelope);
+        }
+    }
+
+    __attribute__((target("sse2"))) void goertzelSse2(const double *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                                                      const double *p_frequencies, size_t p_toneCount, double *p_powers)
+    {
+        // Every (symbol, tone) pair is a chain of the polyphase filter, four chains run together to hide the
+        // latency of the recurrence, and the lanes fill up whatever the amount of symbols
+        constexpr size_t LANES = 2;
+        constexpr size_t CHAINS = 4;
+        const std::vector<GoertzelLanes> tones = initGoertzelLanes(p_frequencies, p_toneCount, LANES);
+        const size_t steps = p_symbolLength / LANES;
+        const size_t rest = p_symbolLength % LANES;
+        const size_t pairCount = p_symbolCount * p_toneCount;
+        alignas(16) double states1[CHAINS][LANES];
+        alignas(16) double states2[CHAINS][LANES];
+        // The symbols are padded with zeros to whole vectors, zeros leave the DFT unchanged
+        alignas(16) double padded[CHAINS][LANES] = {};
+        for (size_t pairIdx = 0; pairIdx < pairCount; pairIdx += CHAINS)
+        {
+            // The chains past the last pair repeat it and are not stored
+            const double *symbols[CHAINS];
+            const GoertzelLanes *chainTones[CHAINS];
+            for (size_t chainIdx = 0; chainIdx < CHAINS; ++chainIdx)
+            {
+                const size_t chainPair = std::min(pairIdx + chainIdx, pairCount - 1);
+                symbols[chainIdx] = p_signal + (chainPair / p_toneCount) * p_symbolLength;
+                chainTones[chainIdx] = &tones[chainPair % p_toneCount];
+                std::copy_n(symbols[chainIdx] + steps * LANES, rest, padded[chainIdx]);
+            }
+            const __m128d coefficientA = _mm_set1_pd(chainTones[0]->coefficient);
+            const __m128d coefficientB = _mm_set1_pd(chainTones[1]->coefficient);
+            const __m128d coefficientC = _mm_set1_pd(chainTones[2]->coefficient);
+            const __m128d coefficientD = _mm_set1_pd(chainTones[3]->coefficient);
+            __m128d state1A = _mm_setzero_pd();
+            __m128d state2A = _mm_setzero_pd();
+            __m128d state1B = _mm_setzero_pd();
+            __m128d state2B = _mm_setzero_pd();
+            __m128d state1C = _mm_setzero_pd();
+            __m128d state2C = _mm_setzero_pd();
+            __m128d state1D = _mm_setzero_pd();
+            __m128d state2D = _mm_setzero_pd();
+            for (size_t stepIdx = 0; stepIdx < steps; ++stepIdx)
+            {
+                __m128d samplesA = _mm_loadu_pd(symbols[0] + stepIdx * LANES);
+                __m128d nextA = _mm_sub_pd(_mm_add_pd(samplesA, _mm_mul_pd(coefficientA, state1A)), state2A);
+                state2A = state1A;
+                state1A = nextA;
+                __m128d samplesB = _mm_loadu_pd(symbols[1] + stepIdx * LANES);
+                __m128d nextB = _mm_sub_pd(_mm_add_pd(samplesB, _mm_mul_pd(coefficientB, state1B)), state2B);
+                state2B = state1B;
+                state1B = nextB;
+                __m128d samplesC = _mm_loadu_pd(symbols[2] + stepIdx * LANES);
+                __m128d nextC = _mm_sub_pd(_mm_add_pd(samplesC, _mm_mul_pd(coefficientC, state1C)), state2C);
+                state2C = state1C;
+                state1C = nextC;
+                __m128d samplesD = _mm_loadu_pd(symbols[3] + stepIdx * LANES);
+                __m128d nextD = _mm_sub_pd(_mm_add_pd(samplesD, _mm_mul_pd(coefficientD, state1D)), state2D);
+                state2D = state1D;
+                state1D = nextD;
+            }
+            if (rest > 0)
+            {
+                __m128d samplesA = _mm_load_pd(padded[0]);
+                __m128d nextA = _mm_sub_pd(_mm_add_pd(samplesA, _mm_mul_pd(coefficientA, state1A)), state2A);
+                state2A = state1A;
+                state1A = nextA;
+                __m128d samplesB = _mm_load_pd(padded[1]);
+                __m128d nextB = _mm_sub_pd(_mm_add_pd(samplesB, _mm_mul_pd(coefficientB, state1B)), state2B);
+                state2B = state1B;
+                state1B = nextB;
+                __m128d samplesC = _mm_load_pd(padded[2]);
+                __m128d nextC = _mm_sub_pd(_mm_add_pd(samplesC, _mm_mul_pd(coefficientC, state1C)), state2C);
+                state2C = state1C;
+                state1C = nextC;
+                __m128d samplesD = _mm_load_pd(padded[3]);
+                __m128d nextD = _mm_sub_pd(_mm_add_pd(samplesD, _mm_mul_pd(coefficientD, state1D)), state2D);
+                state2D = state1D;
+                state1D = nextD;
+            }
+            _mm_store_pd(states1[0], state1A);
+            _mm_store_pd(states2[0], state2A);
+            _mm_store_pd(states1[1], state1B);
+            _mm_store_pd(states2[1], state2B);
+            _mm_store_pd(states1[2], state1C);
+            _mm_store_pd(states2[2], state2C);
+            _mm_store_pd(states1[3], state1D);
+            _mm_store_pd(states2[3], state2D);
+            for (size_t chainIdx = 0; chainIdx < CHAINS && pairIdx + chainIdx < pairCount; ++chainIdx)
+            {
+                p_powers[pairIdx + chainIdx] = combineGoertzelLanes(*chainTones[chainIdx], states1[chainIdx], states2[chainIdx], LANES);
+            }
+        }
+    }
+
+    __attribute__((target("sse2"))) void combineQ15Sse2(int16_t *p_signal, size_t p_count, const int16_t *p_inPhase, const int16_t *p_quadrature,
+                                                        int16_t p_inPhaseGain, int16_t p_quadratureGain)
+    {
+        constexpr size_t LANES = 8;
+        // Interleaved (I, Q) basis pairs times (gain I, gain Q) pairs, pmaddwd sums each pair into 32 bits
+        const __m128i gains = _mm_set1_epi32(static_cast<int32_t>((static_cast<uint32_t>(static_cast<uint16_t>(p_quadratureGain)) << 16) |
+                                                                  static_cast<uint16_t>(p_inPhaseGain)));
+        const __m128i rounding = _mm_set1_epi32(Q15_ROUNDING);
+        size_t sampleIdx = 0;
+        for (; sampleIdx + LANES <= p_count; sampleIdx += LANES)
+        {
+            __m128i inPhase = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_inPhase + sampleIdx));
+            __m128i quadrature = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_quadrature + sampleIdx));
+            __m128i low = _mm_madd_epi16(_mm_unpacklo_epi16(inPhase, quadrature), gains);
+            __m128i high = _mm_madd_epi16(_mm_unpackhi_epi16(inPhase, quadrature), gains);
+            low = _mm_srai_epi32(_mm_add_epi32(low, rounding), 15);
+            high = _mm_srai_epi32(_mm_add_epi32(high, rounding), 15);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(p_signal + sampleIdx), _mm_packs_epi32(low, high));
+        }
+        combineQ15Scalar(p_signal + sampleIdx, p_count - sampleIdx, p_inPhase + sampleIdx, p_quadrature + sampleIdx,
+                         p_inPhaseGain, p_quadratureGain);
+    }
+
+    __attribute__((target("sse2"))) bool packBitsSse2(const char *p_ascii, size_t p_count, uint64_t *p_words)
+    {
+        constexpr size_t LANES = 16;
+        const __m128i zero = _mm_set1_epi8('0');
+        const __m128i one = _mm_set1_epi8('1');
+        __m128i isBinary = _mm_cmpeq_epi8(zero, zero);
+        size_t wordIdx = 0;
+        for (; (wordIdx + 1) * 64 <= p_count; ++wordIdx)
+        {
+            uint64_t ones = 0;
+            for (size_t part = 0; part < 64 / LANES; ++part)
+            {
+                __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ascii + wordIdx * 64 + part * LANES));
+                __m128i isOne = _mm_cmpeq_epi8(chars, one);
+                isBinary = _mm_and_si128(isBinary, _mm_or_si128(_mm_cmpeq_epi8(chars, zero), isOne));
+                ones |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(isOne))) << (part * LANES);
+            }
+            p_words[wordIdx] = reverseBits(ones);
+        }
+        return _mm_movemask_epi8(isBinary) == 0xFFFF &&
+               packBitsScalar(p_ascii + wordIdx * 64, p_count - wordIdx * 64, p_words + wordIdx);
+    }
+
+    __attribute__((target("avx2"))) void synthesizeAvx2(double *p_signal, size_t p_count, const std::complex<double> &p_carrier,
+                                                        const std::complex<double> &p_rotation, double p_inPhaseGain, double p_quadratureGain)
+    {
+        constexpr size_t LANES = 4;
+        alignas(32) double laneRe[LANES];
+        alignas(32) double laneIm[LANES];
+        std::complex<double> step = initLanes(laneRe, laneIm, LANES, p_carrier, p_rotation);
+
+        __m256d re = _mm256_load_pd(laneRe);
+        __m256d im = _mm256_load_pd(laneIm);
+        const __m256d stepRe = _mm256_set1_pd(step.real());
+        const __m256d stepIm = _mm256_set1_pd(step.imag());
+        const __m256d gainI = _mm256_set1_pd(p_inPhaseGain);
+        const __m256d gainQ = _mm256_set1_pd(p_quadratureGain);
+        size_t sampleIdx = 0;
+        for (; sampleIdx + LANES <= p_count; sampleIdx += LANES)
+        {
+            _mm256_storeu_pd(p_signal + sampleIdx, _mm256_add_pd(_mm256_mul_pd(gainI, re), _mm256_mul_pd(gainQ, im)));
+            __m256d nextRe = _mm256_sub_pd(_mm256_mul_pd(re, stepRe), _mm256_mul_pd(im, stepIm));
+            im = _mm256_add_pd(_mm256_mul_pd(re, stepIm), _mm256_mul_pd(im, stepRe));
+            re = nextRe;
+        }
+        _mm256_store_pd(laneRe, re);
+        _mm256_store_pd(laneIm, im);
+        finishLanes(p_signal + sampleIdx, p_count - sampleIdx, laneRe, laneIm, p_inPhaseGain, p_quadratureGain);
+    }
+
+    __attribute__((target("avx2"))) void combineAvx2(double *p_signal, size_t p_count, const double *p_inPhase, const double *p_quadrature,
+                                                     double p_inPhaseGain, double p_quadratureGain)
+    {
+        constexpr size_t LANES = 4;
+        const __m256d gainI = _mm256_set1_pd(p_inPhaseGain);
+        const __m256d gainQ = _mm256_set1_pd(p_quadratureGain);
+        size_t sampleIdx = 0;
+        for (; sampleIdx + LANES <= p_count; sampleIdx += LANES)
+        {
+            __m256d inPhase = _mm256_mul_pd(gainI, _mm256_loadu_pd(p_inPhase + sampleIdx));
+            __m256d quadrature = _mm256_mul_pd(gainQ, _mm256_loadu_pd(p_quadrature + sampleIdx));
+            _mm256_storeu_pd(p_signal + sampleIdx, _mm256_add_pd(inPhase, quadrature));
+        }
+        combineScalar(p_signal + sampleIdx, p_count - sampleIdx, p_inPhase + sampleIdx, p_quadrature + sampleIdx,
+                      p_inPhaseGain, p_quadratureGain);
+    }
+
+    __attribute__((target("avx2"))) void combineFloatAvx2(float *p_signal, size_t p_count, const float *p_inPhase, const float *p_quadrature,
+                                                          float p_inPhaseGain, float p_quadratureGain)
+    {
+        constexpr size_t LANES = 8;
+        const __m256 gainI = _mm256_set1_ps(p_inPhaseGain);
+        const __m256 gainQ = _mm256_set1_ps(p_quadratureGain);
+        size_t sampleIdx = 0;
+        for (; sampleIdx + LANES <= p_count; sampleIdx += LANES)
+        {
+            __m256 inPhase = _mm256_mul_ps(gainI, _mm256_loadu_ps(p_inPhase + sampleIdx));
+            __m256 quadrature = _mm256_mul_ps(gainQ, _mm256_loadu_ps(p_quadrature + sampleIdx));
+            _mm256_storeu_ps(p_signal + sampleIdx, _mm256_add_ps(inPhase, quadrature));
+        }
+        combineFloatScalar(p_signal + sampleIdx, p_count - sampleIdx, p_inPhase + sampleIdx, p_quadrature + sampleIdx,
+                           p_inPhaseGain, p_quadratureGain);
+    }
+
+    __attribute__((target("avx2"))) double dotAvx2(const double *p_first, const double *p_second, size_t p_count)
+    {
+        constexpr size_t LANES = 4;
+        alignas(32) double lanes[LANES];
+        __m256d sum = _mm256_setzero_pd();
+        size_t sampleIdx = 0;
+        for (; sampleIdx + LANES <= p_count; sampleIdx += LANES)
+        {
+            sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_loadu_pd(p_first + sampleIdx), _mm256_loadu_pd(p_second + sampleIdx)));
+        }
+        _mm256_store_pd(lanes, sum);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) +
+               dotScalar(p_first + sampleIdx, p_second + sampleIdx, p_count - sampleIdx);
+    }
+
+    __attribute__((target("avx2"))) void slideAvx2(const double *p_signalI, const double *p_signalQ, size_t p_outputCount,
+                                                   const double *p_referenceI, const double *p_referenceQ, size_t p_tapCount,
+                                                   double *p_sumsI, double *p_sumsQ)
+    {
+        constexpr size_t LANES = 4;
+        size_t outputIdx = 0;
+        // Two vectors of consecutive outputs stay in registers over all the taps, every tap is broadcast once
+        for (; outputIdx + 2 * LANES <= p_outputCount; outputIdx += 2 * LANES)
+        {
+            __m256d sumI0 = _mm256_setzero_pd();
+            __m256d sumQ0 = _mm256_setzero_pd();
+            __m256d sumI1 = _mm256_setzero_pd();
+            __m256d sumQ1 = _mm256_setzero_pd();
+            for (size_t tapIdx = 0; tapIdx < p_tapCount; ++tapIdx)
+            {
+                __m256d referenceI = _mm256_set1_pd(p_referenceI[tapIdx]);
+                __m256d referenceQ = _mm256_set1_pd(p_referenceQ[tapIdx]);
+                const double *windowI = p_signalI + outputIdx + tapIdx;
+                const double *windowQ = p_signalQ + outputIdx + tapIdx;
+                __m256d sampleI0 = _mm256_loadu_pd(windowI);
+                __m256d sampleQ0 = _mm256_loadu_pd(windowQ);
+                __m256d sampleI1 = _mm256_loadu_pd(windowI + LANES);
+                __m256d sampleQ1 = _mm256_loadu_pd(windowQ + LANES);
+                sumI0 = _mm256_add_pd(sumI0, _mm256_add_pd(_mm256_mul_pd(sampleI0, referenceI), _mm256_mul_pd(sampleQ0, referenceQ)));
+                sumQ0 = _mm256_add_pd(sumQ0, _mm256_sub_pd(_mm256_mul_pd(sampleQ0, referenceI), _mm256_mul_pd(sampleI0, referenceQ)));
+                sumI1 = _mm256_add_pd(sumI1, _mm256_add_pd(_mm256_mul_pd(sampleI1, referenceI), _mm256_mul_pd(sampleQ1, referenceQ)));
+                sumQ1 = _mm256_add_pd(sumQ1, _mm256_sub_pd(_mm256_mul_pd(sampleQ1, referenceI), _mm256_mul_pd(sampleI1, referenceQ)));
+            }
+            _mm256_storeu_pd(p_sumsI + outputIdx, sumI0);
+            _mm256_storeu_pd(p_sumsQ + outputIdx, sumQ0);
+            _mm256_storeu_pd(p_sumsI + outputIdx + LANES, sumI1);
+            _mm256_storeu_pd(p_sumsQ + outputIdx + LANES, sumQ1);
+        }
+        slideScalar(p_signalI + outputIdx, p_signalQ + outputIdx, p_outputCount - outputIdx, p_referenceI, p_referenceQ,
+                    p_tapCount, p_sumsI + outputIdx, p_sumsQ + outputIdx);
+    }
+
+    __attribute__((target("avx2"))) void correlateAvx2(const double *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                                                       const double *p_inPhase, const double *p_quadrature,
+                                                       double *p_inPhaseSums, double *p_quadratureSums)
+    {
+        constexpr size_t LANES = 4;
+        alignas(32) double lanesI[LANES];
+        alignas(32) double lanesQ[LANES];
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const double *symbol = p_signal + symbolIdx * p_symbolLength;
+            __m256d sumI = _mm256_setzero_pd();
+            __m256d sumQ = _mm256_setzero_pd();
+            size_t sampleIdx = 0;
+            for (; sampleIdx + LANES <= p_symbolLength; sampleIdx += LANES)
+            {
+                __m256d samples = _mm256_loadu_pd(symbol + sampleIdx);
+                sumI = _mm256_add_pd(sumI, _mm256_mul_pd(samples, _mm256_loadu_pd(p_inPhase + sampleIdx)));
+                sumQ = _mm256_add_pd(sumQ, _mm256_mul_pd(samples, _mm256_loadu_pd(p_quadrature + sampleIdx)));
+            }
+            _mm256_store_pd(lanesI, sumI);
+            _mm256_store_pd(lanesQ, sumQ);
+            double inPhase = (lanesI[0] + lanesI[1]) + (lanesI[2] + lanesI[3]);
+            double quadrature = (lanesQ[0] + lanesQ[1]) + (lanesQ[2] + lanesQ[3]);
+            for (; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                inPhase += symbol[sampleIdx] * p_inPhase[sampleIdx];
+                quadrature += symbol[sampleIdx] * p_quadrature[sampleIdx];
+            }
+            p_inPhaseSums[symbolIdx] = inPhase;
+            p_quadratureSums[symbolIdx] = quadrature;
+        }
+    }
+
+    __attribute__((target("avx2"))) void correlateFloatAvx2(const float *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                                                            const float *p_inPhase, const float *p_quadrature,
+                                                            double *p_inPhaseSums, double *p_quadratureSums)
+    {
+        constexpr size_t LANES = 8;
+        alignas(32) float lanesI[LANES];
+        alignas(32) float lanesQ[LANES];
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const float *symbol = p_signal + symbolIdx * p_symbolLength;
+            __m256 sumI = _mm256_setzero_ps();
+            __m256 sumQ = _mm256_setzero_ps();
+            size_t sampleIdx = 0;
+            for (; sampleIdx + LANES <= p_symbolLength; sampleIdx += LANES)
+            {
+                __m256 samples = _mm256_loadu_ps(symbol + sampleIdx);
+                sumI = _mm256_add_ps(sumI, _mm256_mul_ps(samples, _mm256_loadu_ps(p_inPhase + sampleIdx)));
+                sumQ = _mm256_add_ps(sumQ, _mm256_mul_ps(samples, _mm256_loadu_ps(p_quadrature + sampleIdx)));
+            }
+            _mm256_store_ps(lanesI, sumI);
+            _mm256_store_ps(lanesQ, sumQ);
+            float inPhase = ((lanesI[0] + lanesI[1]) + (lanesI[2] + lanesI[3])) + ((lanesI[4] + lanesI[5]) + (lanesI[6] + lanesI[7]));
+            float quadrature = ((lanesQ[0] + lanesQ[1]) + (lanesQ[2] + lanesQ[3])) + ((lanesQ[4] + lanesQ[5]) + (lanesQ[6] + lanesQ[7]));
+            for (; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                inPhase += symbol[sampleIdx] * p_inPhase[sampleIdx];
+                quadrature += symbol[sampleIdx] * p_quadrature[sampleIdx];
+            }
+            p_inPhaseSums[symbolIdx] = inPhase;
+            p_quadratureSums[symbolIdx] = quadrature;
+        }
+    }
+
+    __attribute__((target("avx2"))) void correlateQ15Avx2(const int16_t *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                                                          const int16_t *p_inPhase, const int16_t *p_quadrature,
+                                                          double *p_inPhaseSums, double *p_quadratureSums)
+    {
+        constexpr size_t LANES = 16;
+        alignas(32) int64_t lanesI[4];
+        alignas(32) int64_t lanesQ[4];
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const int16_t *symbol = p_signal + symbolIdx * p_symbolLength;
+            __m256i sumI = _mm256_setzero_si256();
+            __m256i sumQ = _mm256_setzero_si256();
+            size_t sampleIdx = 0;
+            for (; sampleIdx + LANES <= p_symbolLength; sampleIdx += LANES)
+            {
+                __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(symbol + sampleIdx));
+                __m256i productsI = _mm256_madd_epi16(samples, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_inPhase + sampleIdx)));
+                __m256i productsQ = _mm256_madd_epi16(samples, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_quadrature + sampleIdx)));
+                sumI = _mm256_add_epi64(sumI, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(productsI)));
+                sumI = _mm256_add_epi64(sumI, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(productsI, 1)));
+                sumQ = _mm256_add_epi64(sumQ, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(productsQ)));
+                sumQ = _mm256_add_epi64(sumQ, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(productsQ, 1)));
+            }
+            _mm256_store_si256(reinterpret_cast<__m256i *>(lanesI), sumI);
+            _mm256_store_si256(reinterpret_cast<__m256i *>(lanesQ), sumQ);
+            int64_t inPhase = (lanesI[0] + lanesI[1]) + (lanesI[2] + lanesI[3]);
+            int64_t quadrature = (lanesQ[0] + lanesQ[1]) + (lanesQ[2] + lanesQ[3]);
+            for (; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                inPhase += symbol[sampleIdx] * p_inPhase[sampleIdx];
+                quadrature += symbol[sampleIdx] * p_quadrature[sampleIdx];
+            }
+            p_inPhaseSums[symbolIdx] = static_cast<double>(inPhase);
+            p_quadratureSums[symbolIdx] = static_cast<double>(quadrature);
+        }
+    }
+
+    __attribute__((target("avx2"))) void envelopeAvx2(const double *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                                                      double *p_sums)
+    {
+        constexpr size_t LANES = 4;
+        alignas(32) double lanes[LANES];
+        const __m256d signMask = _mm256_set1_pd(-0.0);
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const double *symbol = p_signal + symbolIdx * p_symbolLength;
+            __m256d sum = _mm256_setzero_pd();
+            size_t sampleIdx = 0;
+            for (; sampleIdx + LANES <= p_symbolLength; sampleIdx += LANES)
+            {
+                sum = _mm256_add_pd(sum, _mm256_andnot_pd(signMask, _mm256_loadu_pd(symbol + sampleIdx)));
+            }
+            _mm256_store_pd(lanes, sum);
+            double envelope = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+            for (; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                envelope += std::fabs(symbol[sampleIdx]);
+            }
+            p_sums[symbolIdx] = envelope;
+        }
+    }
+
+    __attribute__((target("avx2"))) void envelopeFloatAvx2(const float *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                                                           double *p_sums)
+    {
+        constexpr size_t LANES = 8;
+        alignas(32) float lanes[LANES];
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const float *symbol = p_signal + symbolIdx * p_symbolLength;
+            __m256 sum = _mm256_setzero_ps();
+            size_t sampleIdx = 0;
+            for (; sampleIdx + LANES <= p_symbolLength; sampleIdx += LANES)
+            {
+                sum = _mm256_add_ps(sum, _mm256_andnot_ps(signMask, _mm256_loadu_ps(symbol + sampleIdx)));
+            }
+            _mm256_store_ps(lanes, sum);
+            float envelope = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+            for (; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                envelope += std::fabs(symbol[sampleIdx]);
+            }
+            p_sums[symbolIdx] = envelope;
+        }
+    }
+
+    __attribute__((target("avx2"))) void envelopeQ15Avx2(const int16_t *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                                                         double *p_sums)
+    {
+        constexpr size_t LANES = 16;
+        alignas(32) int64_t lanes[4];
+        const __m256i one = _mm256_set1_epi16(1);
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const int16_t *symbol = p_signal + symbolIdx * p_symbolLength;
+            __m256i sum = _mm256_setzero_si256();
+            size_t sampleIdx = 0;
+            for (; sampleIdx + LANES <= p_symbolLength; sampleIdx += LANES)
+            {
+                __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(symbol + sampleIdx));
+                // |x| is x * sign(x) summed in pairs to 32 bits, -32768 has no 16-bit magnitude
+                __m256i magnitudes = _mm256_madd_epi16(samples, _mm256_or_si256(_mm256_srai_epi16(samples, 15), one));
+                sum = _mm256_add_epi64(sum, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(magnitudes)));
+                sum = _mm256_add_epi64(sum, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(magnitudes, 1)));
+            }
+            _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), sum);
+            int64_t envelope = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+            for (; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                envelope += std::abs(symbol[sampleIdx]);
+            }
+            p_sums[symbolIdx] = static_cast<double>(envelope);
+        }
+    }
+
+    __attribute__((target("avx2"))) void goertzelAvx2(const double *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                                                      const double *p_frequencies, size_t p_toneCount, double *p_powers)
+    {
+        // Every (symbol, tone) pair is a chain of the polyphase filter, four chains run together to hide the
+        // latency of the recurrence, and the lanes fill up whatever the amount of symbols
+        constexpr size_t LANES = 4;
+        constexpr size_t CHAINS = 4;
+        const std::vector<GoertzelLanes> tones = initGoertzelLanes(p_frequencies, p_toneCount, LANES);
+        const size_t steps = p_symbolLength / LANES;
+        const size_t rest = p_symbolLength % LANES;
+        const size_t pairCount = p_symbolCount * p_toneCount;
+        alignas(32) double states1[CHAINS][LANES];
+        alignas(32) double states2[CHAINS][LANES];
+        // The symbols are padded with zeros to whole vectors, zeros leave the DFT unchanged
+        alignas(32) double padded[CHAINS][LANES] = {};
+        for (size_t pairIdx = 0; pairIdx < pairCount; pairIdx += CHAINS)
+        {
+            // The chains past the last pair repeat it and are not stored
+            const double *symbols[CHAINS];
+            const GoertzelLanes *chainTones[CHAINS];
+            for (size_t chainIdx = 0; chainIdx < CHAINS; ++chainIdx)
+            {
+                const size_t chainPair = std::min(pairIdx + chainIdx, pairCount - 1);
+                symbols[chainIdx] = p_signal + (chainPair / p_toneCount) * p_symbolLength;
+                chainTones[chainIdx] = &tones[chainPair % p_toneCount];
+                std::copy_n(symbols[chainIdx] + steps * LANES, rest, padded[chainIdx]);
+            }
+            const __m256d coefficientA = _mm256_set1_pd(chainTones[0]->coefficient);
+            const __m256d coefficientB = _mm256_set1_pd(chainTones[1]->coefficient);
+            const __m256d coefficientC = _mm256_set1_pd(chainTones[2]->coefficient);
+            const __m256d coefficientD = _mm256_set1_pd(chainTones[3]->coefficient);
+            __m256d state1A = _mm256_setzero_pd();
+            __m256d state2A = _mm256_setzero_pd();
+            __m256d state1B = _mm256_setzero_pd();
+            __m256d state2B = _mm256_setzero_pd();
+            __m256d state1C = _mm256_setzero_pd();
+            __m256d state2C = _mm256_setzero_pd();
+            __m256d state1D = _mm256_setzero_pd();
+            __m256d state2D = _mm256_setzero_pd();
+            for (size_t stepIdx = 0; stepIdx < steps; ++stepIdx)
+            {
+                __m256d samplesA = _mm256_loadu_pd(symbols[0] + stepIdx * LANES);
+                __m256d nextA = _mm256_sub_pd(_mm256_add_pd(samplesA, _mm256_mul_pd(coefficientA, state1A)), state2A);
+                state2A = state1A;
+                state1A = nextA;
+                __m256d samplesB = _mm256_loadu_pd(symbols[1] + stepIdx * LANES);
+                __m256d nextB = _mm256_sub_pd(_mm256_add_pd(samplesB, _mm256_mul_pd(coefficientB, state1B)), state2B);
+                state2B = state1B;
+                state1B = nextB;
+                __m256d samplesC = _mm256_loadu_pd(symbols[2] + stepIdx * LANES);
+                __m256d nextC = _mm256_sub_pd(_mm256_add_pd(samplesC, _mm256_mul_pd(coefficientC, state1C)), state2C);
+                state2C = state1C;
+                state1C = nextC;
+                __m256d samplesD = _mm256_loadu_pd(symbols[3] + stepIdx * LANES);
+                __m256d nextD = _mm256_sub_pd(_mm256_add_pd(samplesD, _mm256_mul_pd(coefficientD, state1D)), state2D);
+                state2D = state1D;
+                state1D = nextD;
+            }
+            if (rest > 0)
+            {
+                __m256d samplesA = _mm256_load_pd(padded[0]);
+                __m256d nextA = _mm256_sub_pd(_mm256_add_pd(samplesA, _mm256_mul_pd(coefficientA, state1A)), state2A);
+                state2A = state1A;
+                state1A = nextA;
+                __m256d samplesB = _mm256_load_pd(padded[1]);
+                __m256d nextB = _mm256_sub_pd(_mm256_add_pd(samplesB, _mm256_mul_pd(coefficientB, state1B)), state2B);
+                state2B = state1B;
+                state1B = nextB;
+                __m256d samplesC = _mm256_load_pd(padded[2]);
+                __m256d nextC = _mm256_sub_pd(_mm256_add_pd(samplesC, _mm256_mul_pd(coefficientC, state1C)), state2C);
+                state2C = state1C;
+                state1C = nextC;
+                __m256d samplesD = _mm256_load_pd(padded[3]);
+                __m256d nextD = _mm256_sub_pd(_mm256_add_pd(samplesD, _mm256_mul_pd(coefficientD, state1D)), state2D);
+                state2D = state1D;
+                state1D = nextD;
+            }
+            _mm256_store_pd(states1[0], state1A);
+            _mm256_store_pd(states2[0], state2A);
+            _mm256_store_pd(states1[1], state1B);
+            _mm256_store_pd(states2[1], state2B);
+            _mm256_store_pd(states1[2], state1C);
+            _mm256_store_pd(states2[2], state2C);
+            _mm256_store_pd(states1[3], state1D);
+            _mm256_store_pd(states2[3], state2D);
+            for (size_t chainIdx = 0; chainIdx < CHAINS && pairIdx + chainIdx < pairCount; ++chainIdx)
+            {
+                p_powers[pairIdx + chainIdx] = combineGoertzelLanes(*chainTones[chainIdx], states1[chainIdx], states2[chainIdx], LANES);
+            }
+        }
+    }
+
+    __attribute__((target("avx2"))) void combineQ15Avx2(int16_t *p_signal, size_t p_count, const int16_t *p_inPhase, const int16_t *p_quadrature,
+                                                        int16_t p_inPhaseGain, int16_t p_quadratureGain)
+    {
+        constexpr size_t LANES = 16;
+        const __m256i gains = _mm256_set1_epi32(static_cast<int32_t>((static_cast<uint32_t>(static_cast<uint16_t>(p_quadratureGain)) << 16) |
+                                                                     static_cast<uint16_t>(p_inPhaseGain)));
+        const __m256i rounding = _mm256_set1_epi32(Q15_ROUNDING);
+        size_t sampleIdx = 0;
+        for (; sampleIdx + LANES <= p_count; sampleIdx += LANES)
+        {
+            __m256i inPhase = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_inPhase + sampleIdx));
+            __m256i quadrature = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_quadrature + sampleIdx));
+            // Unpack and pack both work within 128-bit halves, so the samples come back in order
+            __m256i low = _mm256_madd_epi16(_mm256_unpacklo_epi16(inPhase, quadrature), gains);
+            __m256i high = _mm256_madd_epi16(_mm256_unpackhi_epi16(inPhase, quadrature), gains);
+            low = _mm256_srai_epi32(_mm256_add_epi32(low, rounding), 15);
+            high = _mm256_srai_epi32(_mm256_add_epi32(high, rounding), 15);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(p_signal + sampleIdx), _mm256_packs_epi32(low, high));
+        }
+        // The scalar tail is a tail call the compiler emits no vzeroupper for, legacy SSE code after it would pay
+        // the AVX-SSE transition on every instruction
+        _mm256_zeroupper();
+        combineQ15Scalar(p_signal + sampleIdx, p_count - sampleIdx, p_inPhase + sampleIdx, p_quadrature + sampleIdx,
+                         p_inPhaseGain, p_quadratureGain);
+    }
+
+    __attribute__((target("avx2"))) bool packBitsAvx2(const char *p_ascii, size_t p_count, uint64_t *p_words)
+    {
+        constexpr size_t LANES = 32;
+        const __m256i zero = _mm256_set1_epi8('0');
+        const __m256i one = _mm256_set1_epi8('1');
+        __m256i isBinary = _mm256_cmpeq_epi8(zero, zero);
+        size_t wordIdx = 0;
+        for (; (wordIdx + 1) * 64 <= p_count; ++wordIdx)
+        {
+            __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_ascii + wordIdx * 64));
+            __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_ascii + wordIdx * 64 + LANES));
+            __m256i lowOnes = _mm256_cmpeq_epi8(low, one);
+            __m256i highOnes = _mm256_cmpeq_epi8(high, one);
+            isBinary = _mm256_and_si256(isBinary, _mm256_or_si256(_mm256_cmpeq_epi8(low, zero), lowOnes));
+            isBinary = _mm256_and_si256(isBinary, _mm256_or_si256(_mm256_cmpeq_epi8(high, zero), highOnes));
+            uint64_t ones = static_cast<uint32_t>(_mm256_movemask_epi8(lowOnes)) |
+                            (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(highOnes))) << LANES);
+            p_words[wordIdx] = reverseBits(ones);
+        }
+        bool isValid = static_cast<uint32_t>(_mm256_movemask_epi8(isBinary)) == 0xFFFFFFFFu;
+        _mm256_zeroupper();
+        return isValid && packBitsScalar(p_ascii + wordIdx * 64, p_count - wordIdx * 64, p_words + wordIdx);
+    }
+
+    __attribute__((target("avx512f"))) void synthesizeAvx512(double *p_signal, size_t p_count, const std::complex<double> &p_carrier,
+                                                             const std::complex<double> &p_rotation, double p_inPhaseGain, double p_quadratureGain)
+    {
+        constexpr size_t LANES = 8;
+        alignas(64) double laneRe[LANES];
+        alignas(64) double laneIm[LANES];
+        std::complex<double> step = initLanes(laneRe, laneIm, LANES, p_carrier, p_rotation);
+
+        __m512d re = _mm512_load_pd(laneRe);
+        __m512d im = _mm512_load_pd(laneIm);
+        const __m512d stepRe = _mm512_set1_pd(step.real());
+        const __m512d stepIm = _mm512_set1_pd(step.imag());
+        const __m512d gainI = _mm512_set1_pd(p_inPhaseGain);
+        const __m512d gainQ = _mm512_set1_pd(p_quadratureGain);
+        size_t sampleIdx = 0;
+        for (; sampleIdx + LANES <= p_count; sampleIdx += LANES)
+        {
+            _mm512_storeu_pd(p_signal + sampleIdx, _mm512_add_pd(_mm512_mul_pd(gainI, re), _mm512_mul_pd(gainQ, im)));
+            __m512d nextRe = _mm512_sub_pd(_mm512_mul_pd(re, stepRe), _mm512_mul_pd(im, stepIm));
+            im = _mm512_add_pd(_mm512_mul_pd(re, stepIm), _mm512_mul_pd(im, stepRe));
+            re = nextRe;
+        }
+        _mm512_store_pd(laneRe, re);
+        _mm512_store_pd(laneIm, im);
+        finishLanes(p_signal + sampleIdx, p_count - sampleIdx, laneRe, laneIm, p_inPhaseGain, p_quadratureGain);
+    }
+
+    __attribute__((target("avx512f"))) void combineAvx512(double *p_signal, size_t p_count, const double *p_inPhase, const double *p_quadrature,
+                                                          double p_inPhaseGain, double p_quadratureGain)
+    {
+        constexpr size_t LANES = 8;
+        const __m512d gainI = _mm512_set1_pd(p_inPhaseGain);
+        const __m512d gainQ = _mm512_set1_pd(p_quadratureGain);
+        size_t sampleIdx = 0;
+        for (; sampleIdx + LANES <= p_count; sampleIdx += LANES)
+        {
+            __m512d inPhase = _mm512_mul_pd(gainI, _mm512_loadu_pd(p_inPhase + sampleIdx));
+            __m512d quadrature = _mm512_mul_pd(gainQ, _mm512_loadu_pd(p_quadrature + sampleIdx));
+            _mm512_storeu_pd(p_signal + sampleIdx, _mm512_add_pd(inPhase, quadrature));
+        }
+        combineScalar(p_signal + sampleIdx, p_count - sampleIdx, p_inPhase + sampleIdx, p_quadrature + sampleIdx,
+                      p_inPhaseGain, p_quadratureGain);
+    }
+
+    __attribute__((target("avx512f"))) void combineFloatAvx512(float *p_signal, size_t p_count, const float *p_inPhase, const float *p_quadrature,
+                                                               float p_inPhaseGain, float p_quadratureGain)
+    {
+        constexpr size_t LANES = 16;
+        const __m512 gainI = _mm512_set1_ps(p_inPhaseGain);
+        const __m512 gainQ = _mm512_set1_ps(p_quadratureGain);
+        size_t sampleIdx = 0;
+        for (; sampleIdx + LANES <= p_count; sampleIdx += LANES)
+        {
+            __m512 inPhase = _mm512_mul_ps(gainI, _mm512_loadu_ps(p_inPhase + sampleIdx));
+            __m512 quadrature = _mm512_mul_ps(gainQ, _mm512_loadu_ps(p_quadrature + sampleIdx));
+            _mm512_storeu_ps(p_signal + sampleIdx, _mm512_add_ps(inPhase, quadrature));
+        }
+        combineFloatScalar(p_signal + sampleIdx, p_count - sampleIdx, p_inPhase + sampleIdx, p_quadrature + sampleIdx,
+                           p_inPhaseGain, p_quadratureGain);
+    }
+
+    __attribute__((target("avx512f"))) double dotAvx512(const double *p_first, const double *p_second, size_t p_count)
+    {
+        constexpr size_t LANES = 8;
+        alignas(64) double lanes[LANES];
+        __m512d sum = _mm512_setzero_pd();
+        size_t sampleIdx = 0;
+        for (; sampleIdx + LANES <= p_count; sampleIdx += LANES)
+        {
+            sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_loadu_pd(p_first + sampleIdx), _mm512_loadu_pd(p_second + sampleIdx)));
+        }
+        _mm512_store_pd(lanes, sum);
+        return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7])) +
+               dotScalar(p_first + sampleIdx, p_second + sampleIdx, p_count - sampleIdx);
+    }
+
+    __attribute__((target("avx512f"))) void slideAvx512(const double *p_signalI, const double *p_signalQ, size_t p_outputCount,
+                                                        const double *p_referenceI, const double *p_referenceQ, size_t p_tapCount,
+                                                        double *p_sumsI, double *p_sumsQ)
+    {
+        constexpr size_t LANES = 8;
+        size_t outputIdx = 0;
+        // Two vectors of consecutive outputs stay in registers over all the taps, every tap is broadcast once
+        for (; outputIdx + 2 * LANES <= p_outputCount; outputIdx += 2 * LANES)
+        {
+            __m512d sumI0 = _mm512_setzero_pd();
+            __m512d sumQ0 = _mm512_setzero_pd();
+            __m512d sumI1 = _mm512_setzero_pd();
+            __m512d sumQ1 = _mm512_setzero_pd();
+            for (size_t tapIdx = 0; tapIdx < p_tapCount; ++tapIdx)
+            {
+                __m512d referenceI = _mm512_set1_pd(p_referenceI[tapIdx]);
+                __m512d referenceQ = _mm512_set1_pd(p_referenceQ[tapIdx]);
+                const double *windowI = p_signalI + outputIdx + tapIdx;
+                const double *windowQ = p_signalQ + outputIdx + tapIdx;
+                __m512d sampleI0 = _mm512_loadu_pd(windowI);
+                __m512d sampleQ0 = _mm512_loadu_pd(windowQ);
+                __m512d sampleI1 = _mm512_loadu_pd(windowI + LANES);
+                __m512d sampleQ1 = _mm512_loadu_pd(windowQ + LANES);
+                sumI0 = _mm512_add_pd(sumI0, _mm512_add_pd(_mm512_mul_pd(sampleI0, referenceI), _mm512_mul_pd(sampleQ0, referenceQ)));
+                sumQ0 = _mm512_add_pd(sumQ0, _mm512_sub_pd(_mm512_mul_pd(sampleQ0, referenceI), _mm512_mul_pd(sampleI0, referenceQ)));
+                sumI1 = _mm512_add_pd(sumI1, _mm512_add_pd(_mm512_mul_pd(sampleI1, referenceI), _mm512_mul_pd(sampleQ1, referenceQ)));
+                sumQ1 = _mm512_add_pd(sumQ1, _mm512_sub_pd(_mm512_mul_pd(sampleQ1, referenceI), _mm512_mul_pd(sampleI1, referenceQ)));
+            }
+            _mm512_storeu_pd(p_sumsI + outputIdx, sumI0);
+            _mm512_storeu_pd(p_sumsQ + outputIdx, sumQ0);
+            _mm512_storeu_pd(p_sumsI + outputIdx + LANES, sumI1);
+            _mm512_storeu_pd(p_sumsQ + outputIdx + LANES, sumQ1);
+        }
+        slideScalar(p_signalI + outputIdx, p_signalQ + outputIdx, p_outputCount - outputIdx, p_referenceI, p_referenceQ,
+                    p_tapCount, p_sumsI + outputIdx, p_sumsQ + outputIdx);
+    }
+
+    __attribute__((target("avx512f"))) void correlateAvx512(const double *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                                                            const double *p_inPhase, const double *p_quadrature,
+                                                            double *p_inPhaseSums, double *p_quadratureSums)
+    {
+        constexpr size_t LANES = 8;
+        alignas(64) double lanesI[LANES];
+        alignas(64) double lanesQ[LANES];
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const double *symbol = p_signal + symbolIdx * p_symbolLength;
+            __m512d sumI = _mm512_setzero_pd();
+            __m512d sumQ = _mm512_setzero_pd();
+            size_t sampleIdx = 0;
+            for (; sampleIdx + LANES <= p_symbolLength; sampleIdx += LANES)
+            {
+                __m512d samples = _mm512_loadu_pd(symbol + sampleIdx);
+                sumI = _mm512_add_pd(sumI, _mm512_mul_pd(samples, _mm512_loadu_pd(p_inPhase + sampleIdx)));
+                sumQ = _mm512_add_pd(sumQ, _mm512_mul_pd(samples, _mm512_loadu_pd(p_quadrature + sampleIdx)));
+            }
+            _mm512_store_pd(lanesI, sumI);
+            _mm512_store_pd(lanesQ, sumQ);
+            double inPhase = ((lanesI[0] + lanesI[1]) + (lanesI[2] + lanesI[3])) + ((lanesI[4] + lanesI[5]) + (lanesI[6] + lanesI[7]));
+            double quadrature = ((lanesQ[0] + lanesQ[1]) + (lanesQ[2] + lanesQ[3])) + ((lanesQ[4] + lanesQ[5]) + (lanesQ[6] + lanesQ[7]));
+            for (; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                inPhase += symbol[sampleIdx] * p_inPhase[sampleIdx];
+                quadrature += symbol[sampleIdx] * p_quadrature[sampleIdx];
+            }
+            p_inPhaseSums[symbolIdx] = inPhase;
+            p_quadratureSums[symbolIdx] = quadrature;
+        }
+    }
+
+    __attribute__((target("avx512f"))) void correlateFloatAvx512(const float *p_signal, size_t p_symbolLength,
+                                                                 size_t p_symbolCount, const float *p_inPhase,
+                                                                 const float *p_quadrature, double *p_inPhaseSums,
+                                                                 double *p_quadratureSums)
+    {
+        constexpr size_t LANES = 16;
+        alignas(64) float lanesI[LANES];
+        alignas(64) float lanesQ[LANES];
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const float *symbol = p_signal + symbolIdx * p_symbolLength;
+            __m512 sumI = _mm512_setzero_ps();
+            __m512 sumQ = _mm512_setzero_ps();
+            size_t sampleIdx = 0;
+            for (; sampleIdx + LANES <= p_symbolLength; sampleIdx += LANES)
+            {
+                __m512 samples = _mm512_loadu_ps(symbol + sampleIdx);
+                sumI = _mm512_add_ps(sumI, _mm512_mul_ps(samples, _mm512_loadu_ps(p_inPhase + sampleIdx)));
+                sumQ = _mm512_add_ps(sumQ, _mm512_mul_ps(samples, _mm512_loadu_ps(p_quadrature + sampleIdx)));
+            }
+            _mm512_store_ps(lanesI, sumI);
+            _mm512_store_ps(lanesQ, sumQ);
+            float inPhase = 0;
+            float quadrature = 0;
+            for (size_t laneIdx = 0; laneIdx < LANES; ++laneIdx)
+            {
+                inPhase += lanesI[laneIdx];
+                quadrature += lanesQ[laneIdx];
+            }
+            for (; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                inPhase += symbol[sampleIdx] * p_inPhase[sampleIdx];
+                quadrature += symbol[sampleIdx] * p_quadrature[sampleIdx];
+            }
+            p_inPhaseSums[symbolIdx] = inPhase;
+            p_quadratureSums[symbolIdx] = quadrature;
+        }
+    }
+
+    __attribute__((target("avx512f"))) void envelopeAvx512(const double *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                                                           double *p_sums)
+    {
+        constexpr size_t LANES = 8;
+        alignas(64) double lanes[LANES];
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const double *symbol = p_signal + symbolIdx * p_symbolLength;
+            __m512d sum = _mm512_setzero_pd();
+            size_t sampleIdx = 0;
+            for (; sampleIdx + LANES <= p_symbolLength; sampleIdx += LANES)
+            {
+                sum = _mm512_add_pd(sum, _mm512_abs_pd(_mm512_loadu_pd(symbol + sampleIdx)));
+            }
+            _mm512_store_pd(lanes, sum);
+            double envelope = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+            for (; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                envelope += std::fabs(symbol[sampleIdx]);
+            }
+            p_sums[symbolIdx] = envelope;
+        }
+    }
+
+    __attribute__((target("avx512f"))) void envelopeFloatAvx512(const float *p_signal, size_t p_symbolLength,
+                                                                size_t p_symbolCount, double *p_sums)
+    {
+        constexpr size_t LANES = 16;
+        alignas(64) float lanes[LANES];
+        for (size_t symbolIdx = 0; symbolIdx < p_symbolCount; ++symbolIdx)
+        {
+            const float *symbol = p_signal + symbolIdx * p_symbolLength;
+            __m512 sum = _mm512_setzero_ps();
+            size_t sampleIdx = 0;
+            for (; sampleIdx + LANES <= p_symbolLength; sampleIdx += LANES)
+            {
+                sum = _mm512_add_ps(sum, _mm512_abs_ps(_mm512_loadu_ps(symbol + sampleIdx)));
+            }
+            _mm512_store_ps(lanes, sum);
+            float envelope = 0;
+            for (size_t laneIdx = 0; laneIdx < LANES; ++laneIdx)
+            {
+                envelope += lanes[laneIdx];
+            }
+            for (; sampleIdx < p_symbolLength; ++sampleIdx)
+            {
+                envelope += std::fabs(symbol[sampleIdx]);
+            }
+            p_sums[symbolIdx] = envelope;
+        }
+    }
+    __attribute__((target("avx512f"))) void goertzelAvx512(const double *p_signal, size_t p_symbolLength, size_t p_symbolCount,
+                                                           const double *p_frequencies, size_t p_toneCount, double *p_powers)
+    {
+        // Every (symbol, tone) pair is a chain of the polyphase filter, four chains run together to hide the
+        // latency of the recurrence, and the lanes fill up whatever the amount of symbols
+        constexpr size_t LANES = 8;
+        constexpr size_t CHAINS = 4;
+        const std::vector<GoertzelLanes> tones = initGoertzelLanes(p_frequencies, p_toneCount, LANES);
+        const size_t steps = p_symbolLength / LANES;
+        const size_t rest = p_symbolLength % LANES;
+        const size_t pairCount = p_symbolCount * p_toneCount;
+        alignas(64) double states1[CHAINS][LANES];
+        alignas(64) double states2[CHAINS][LANES];
+        // The symbols are padded with zeros to whole vectors, zeros leave the DFT unchanged
+        alignas(64) double padded[CHAINS][LANES] = {};
+        for (size_t pairIdx = 0; pairIdx < pairCount; pairIdx += CHAINS)
+        {
+            // The chains past the last pair repeat it and are not stored
+            const double *symbols[CHAINS];
+            const GoertzelLanes *chainTones[CHAINS];
+            for (size_t chainIdx = 0; chainIdx < CHAINS; ++chainIdx)
+            {
+                const size_t chainPair = std::min(pairIdx + chainIdx, pairCount - 1);
+                symbols[chainIdx] = p_signal + (chainPair / p_toneCount) * p_symbolLength;
+                chainTones[chainIdx] = &tones[chainPair % p_toneCount];
+                std::copy_n(symbols[chainIdx] + steps * LANES, rest, padded[chainIdx]);
+            }
+            const __m512d coefficientA = _mm512_set1_pd(chainTones[0]->coefficient);
+            const __m512d coefficientB = _mm512_set1_pd(chainTones[1]->coefficient);
+            const __m512d coefficientC = _mm512_set1_pd(chainTones[2]->coefficient);
+            const __m512d coefficientD = _mm512_set1_pd(chainTones[3]->coefficient);
+            __m512d state1A = _mm512_setzero_pd();
+            __m512d state2A = _mm512_setzero_pd();
+            __m512d state1B = _mm512_setzero_pd();
+            __m512d state2B = _mm512_setzero_pd();
+            __m512d state1C = _mm512_setzero_pd();
+            __m512d state2C = _mm512_setzero_pd();
+            __m512d state1D = _mm512_setzero_pd();
+            __m512d state2D = _mm512_setzero_pd();
+            for (size_t stepIdx = 0; stepIdx < steps; ++stepIdx)
+            {
+                __m512d samplesA = _mm512_loadu_pd(symbols[0] + stepIdx * LANES);
+                __m512d nextA = _mm512_sub_pd(_mm512_add_pd(samplesA, _mm512_mul_pd(coefficientA, state1A)), state2A);
+                state2A = state1A;
+                state1A = nextA;
+                __m512d samplesB = _mm512_loadu_pd(symbols[1] + stepIdx * LANES);
+                __m512d nextB = _mm512_sub_pd(_mm512_add_pd(samplesB, _mm512_mul_pd(coefficientB, state1B)), state2B);
+                state2B = state1B;
+                state1B = nextB;
+                __m512d samplesC = _mm512_loadu_pd(symbols[2] + stepIdx * LANES);
+                __m512d nextC = _mm512_sub_pd(_mm512_add_pd(samplesC, _mm512_mul_pd(coefficientC, state1C)), state2C);
+                state2C = state1C;
+                state1C = nextC;
+                __m512d samplesD = _mm512_loadu_pd(symbols[3] + stepIdx * LANES);
+                __m512d nextD = _mm512_sub_pd(_mm512_add_pd(samplesD, _mm512_mul_pd(coefficientD, state1D)), state2D);
+                state2D = state1D;
+                state1D = nextD;
+            }
+            if (rest > 0)
+            {
+                __m512d samplesA = _mm512_load_pd(padded[0]);
+                __m512d nextA = _mm512_sub_pd(_mm512_add_pd(samplesA, _mm512_mul_pd(coefficientA, state1A)), state2A);
+                state2A = state1A;
+                state1A = nextA;
+                __m512d samplesB = _mm512_load_pd(padded[1]);
+                __m512d nextB = _mm512_sub_pd(_mm512_add_pd(samplesB, _mm512_mul_pd(coefficientB, state1B)), state2B);
+                state2B = state1B;
+                state1B = nextB;
+                __m512d samplesC = _mm512_load_pd(padded[2]);
+                __m512d nextC = _mm512_sub_pd(_mm512_add_pd(samplesC, _mm512_mul_pd(coefficientC, state1C)), state2C);
+                state2C = state1C;
+                state1C = nextC;
+                __m512d samplesD = _mm512_load_pd(padded[3]);
+                __m512d nextD = _mm512_sub_pd(_mm512_add_pd(samplesD, _mm512_mul_pd(coefficientD, state1D)), state2D);
+                state2D = state1D;
+                state1D = nextD;
+            }
+            _mm512_store_pd(states1[0], state1A);
+            _mm512_store_pd(states2[0], state2A);
+            _mm512_store_pd(states1[1], state1B);
+            _mm512_store_pd(states2[1], state2B);
+            _mm512_store_pd(states1[2], state1C);
+            _mm512_store_pd(states2[2], state2C);
+            _mm512_store_pd(states1[3], state1D);
+            _mm512_store_pd(states2[3], state2D);
+            for (size_t chainIdx = 0; chainIdx < CHAINS && pairIdx + chainIdx < pairCount; ++chainIdx)
+            {
+                p_powers[pairIdx + chainIdx] = combineGoertzelLanes(*chainTones[chainIdx], states1[chainIdx], states2[chainIdx], LANES);
+            }
+        }
+    }
+#endif
+}
+
+SimdKernels::SimdKernels()
+{
+    m_level = detectLevel();
+    // Step down one instruction set at a time until the kernels agree with the scalar reference
+    while (m_level != SimdLevel::SCALAR && !verifyKernels(m_level))
+    {
+        m_level = static_cast<SimdLevel>(static_cast<int>(m_level) - 1);
+    }
+    m_synthesize = getSynthesizeKernel(m_level);
+    m_combine = getCombineKernel(m_level);
+    m_combineFloat = getCombineFloatKernel(m_level);
+    m_dot = getDotKernel(m_level);
+    m_combineQ15 = getCombineQ15Kernel(m_level);
+    m_correlate = getCorrelateKernel(m_level);
+    m_correlateFloat = getCorrelateFloatKernel(m_level);
+    m_correlateQ15 = getCorrelateQ15Kernel(m_level);
+    m_sumEnvelopes = getEnvelopeKernel(m_level);
+    m_sumEnvelopesFloat = getEnvelopeFloatKernel(m_level);
+    m_sumEnvelopesQ15 = getEnvelopeQ15Kernel(m_level);
+    m_goertzel = getGoertzelKernel(m_level);
+    m_slide = getSlideKernel(m_level);
+    m_packBits = getPackBitsKernel(m_level);
+}
+
+const SimdKernels &SimdKernels::getInstance()
+{
+    static SimdKernels m_instance;
+    return m_instance;
+}
+
+SimdLevel SimdKernels::getLevel() const
+{
+    return m_level;
+}
+
+const char *SimdKernels::getLevelName() const
+{
+    switch (m_level)
+    {
+    case SimdLevel::SSE2:
+        return "SSE2";
+    case SimdLevel::AVX2:
+        return "AVX2";
+    case SimdLevel::AVX512:
+        return "AVX-512";
+    default:
+        return "scalar";
+    }
+}
+
+SimdLevel SimdKernels::detectLevel()
+{
+#ifdef SIMD_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return SimdLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return SimdLevel::SSE2;
+    }
+#endif
+    return SimdLevel::SCALAR;
+}
+
+SynthesizeKernel SimdKernels::getSynthesizeKernel(SimdLevel p_level)
+{
+    switch (p_level)
+    {
+#ifdef SIMD_KERNELS_X86
+    case SimdLevel::SSE2:
+        return synthesizeSse2;
+    case SimdLevel::AVX2:
+        return synthesizeAvx2;
+    case SimdLevel::AVX512:
+        return synthesizeAvx512;
+#endif
+    default:
+        return synthesizeScalar;
+    }
+}
+
+CombineKernel SimdKernels::getCombineKernel(SimdLevel p_level)
+{
+    switch (p_level)
+    {
+#ifdef SIMD_KERNELS_X86
+    case SimdLevel::SSE2:
+        return combineSse2;
+    case SimdLevel::AVX2:
+        return combineAvx2;
+    case SimdLevel::AVX512:
+        return combineAvx512;
+#endif
+    default:
+        return combineScalar;
+    }
+}
+
+CombineFloatKernel SimdKernels::getCombineFloatKernel(SimdLevel p_level)
+{
+    switch (p_level)
+    {
+#ifdef SIMD_KERNELS_X86
+    case SimdLevel::SSE2:
+        return combineFloatSse2;
+    case SimdLevel::AVX2:
+        return combineFloatAvx2;
+    case SimdLevel::AVX512:
+        return combineFloatAvx512;
+#endif
+    default:
+        return combineFloatScalar;
+    }
+}
+
+DotKernel SimdKernels::getDotKernel(SimdLevel p_level)
+{
+    switch (p_level)
+    {
+#ifdef SIMD_KERNELS_X86
+    case SimdLevel::SSE2:
+        return dotSse2;
+    case SimdLevel::AVX2:
+        return dotAvx2;
+    case SimdLevel::AVX512:
+        return dotAvx512;
+#endif
+    default:
+        return dotScalar;
+    }
+}
+
+CombineQ15Kernel SimdKernels::getCombineQ15Kernel(SimdLevel p_level)
+{
+    switch (p_level)
+    {
+#ifdef SIMD_KERNELS_X86
+    case SimdLevel::SSE2:
+        return combineQ15Sse2;
+    case SimdLevel::AVX2:
+    case SimdLevel::AVX512:
+        return combineQ15Avx2;
+#endif
+    default:
+        return combineQ15Scalar;
+    }
+}
+
+CorrelateKernel SimdKernels::getCorrelateKernel(SimdLevel p_level)
+{
+    switch (p_level)
+    {
+#ifdef SIMD_KERNELS_X86
+    case SimdLevel::SSE2:
+        return correlateSse2;
+    case SimdLevel::AVX2:
+        return correlateAvx2;
+    case SimdLevel::AVX512:
+        return correlateAvx512;
+#endif
+    default:
+        return correlateScalar;
+    }
+}
+
+CorrelateFloatKernel SimdKernels::getCorrelateFloatKernel(SimdLevel p_level)
+{
+    switch (p_level)
+    {
+#ifdef SIMD_KERNELS_X86
+    case SimdLevel::SSE2:
+        return correlateFloatSse2;
+    case SimdLevel::AVX2:
+        return correlateFloatAvx2;
+    case SimdLevel::AVX512:
+        return correlateFloatAvx512;
+#endif
+    default:
+        return correlateFloatScalar;
+    }
+}
+
+CorrelateQ15Kernel SimdKernels::getCorrelateQ15Kernel(SimdLevel p_level)
+{
+    switch (p_level)
+    {
+#ifdef SIMD_KERNELS_X86
+    case SimdLevel::SSE2:
+        return correlateQ15Sse2;
+    case SimdLevel::AVX2:
+    case SimdLevel::AVX512:
+        return correlateQ15Avx2;
+#endif
+    default:
+        return correlateQ15Scalar;
+    }
+}
+
+EnvelopeKernel SimdKernels::getEnvelopeKernel(SimdLevel p_level)
+{
+    switch (p_level)
+    {
+#ifdef SIMD_KERNELS_X86
+    case SimdLevel::SSE2:
+        return envelopeSse2;
+    case SimdLevel::AVX2:
+        return envelopeAvx2;
+    case SimdLevel::AVX512:
+        return envelopeAvx512;
+#endif
+    default:
+        return envelopeScalar;
+    }
+}
+
+EnvelopeFloatKernel SimdKernels::getEnvelopeFloatKernel(SimdLevel p_level)
+{
+    switch (p_level)
+    {
+#ifdef SIMD_KERNELS_X86
+    case SimdLevel::SSE2:
+        return envelopeFloatSse2;
+    case SimdLevel::AVX2:
+        return envelopeFloatAvx2;
+    case SimdLevel::AVX512:
+        return envelopeFloatAvx512;
+#endif
+    default:
+        return envelopeFloatScalar;
+    }
+}
+
+EnvelopeQ15Kernel SimdKernels::getEnvelopeQ15Kernel(SimdLevel p_level)
+{
+    switch (p_level)
+    {
+#ifdef SIMD_KERNELS_X86
+    case SimdLevel::SSE2:
+        return envelopeQ15Sse2;
+    case SimdLevel::AVX2:
+    case SimdLevel::AVX512:
+        return envelopeQ15Avx2;
+#endif
+    default:
+        return envelopeQ15Scalar;
+    }
+}
+
+SlideKernel SimdKernels::getSlideKernel(SimdLevel p_level)
+{
+    switch (p_level)
+    {
+#ifdef SIMD_KERNELS_X86
+    case SimdLevel::SSE2:
+        return slideSse2;
+    case SimdLevel::AVX2:
+        return slideAvx2;
+    case SimdLevel::AVX512:
+        return slideAvx512;
+#endif
+    default:
+        return slideScalar;
+    }
+}
+
+GoertzelKernel SimdKernels::getGoertzelKernel(SimdLevel p_level)
+{
+    switch (p_level)
+    {
+#ifdef SIMD_KERNELS_X86
+    case SimdLevel::SSE2:
+        return goertzelSse2;
+    case SimdLevel::AVX2:
+        return goertzelAvx2;
+    case SimdLevel::AVX512:
+        return goertzelAvx512;
+#endif
+    default:
+        return goertzelScalar;
+    }
+}
+
+PackBitsKernel SimdKernels::getPackBitsKernel(SimdLevel p_level)
+{
+    switch (p_level)
+    {
+#ifdef SIMD_KERNELS_X86
+    case SimdLevel::SSE2:
+        return packBitsSse2;
+    case SimdLevel::AVX2:
+    case SimdLevel::AVX512:
+        return packBitsAvx2;
+#endif
+    default:
+        return packBitsScalar;
+    }
+}
+
+bool SimdKernels::verifyKernels(SimdLevel p_level)
+{
+    // An odd length also exercises the partial vector at the end
+    const size_t count = SIMD_SELF_CHECK_SAMPLES + 3;
+    const std::complex<double> carrier = std::polar(1.0, -M_PI / 2);
+    const std::complex<double> rotation = std::polar(1.0, 2 * M_PI * 7.0 / 5000.0);
+    std::vector<double> reference(count);
+    std::vector<double> candidate(count);
+    std::vector<double> mixed(count);
+    auto isMatching = [&]()
+    {
+        for (size_t sampleIdx = 0; sampleIdx < count; ++sampleIdx)
+        {
+            if (std::fabs(reference[sampleIdx] - candidate[sampleIdx]) > SIMD_KERNEL_TOLERANCE)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    synthesizeScalar(reference.data(), count, carrier, rotation, 0.75, -0.25);
+    getSynthesizeKernel(p_level)(candidate.data(), count, carrier, rotation, 0.75, -0.25);
+    if (!isMatching())
+    {
+        return false;
+    }
+
+    // Mix the synthesized waveform with itself reversed, the references are the ones just verified
+    std::vector<double> reversed(reference.rbegin(), reference.rend());
+    combineScalar(mixed.data(), count, reference.data(), reversed.data(), 0.5, -1.5);
+    getCombineKernel(p_level)(candidate.data(), count, reference.data(), reversed.data(), 0.5, -1.5);
+    reference.swap(mixed);
+    if (!isMatching())
+    {
+        return false;
+    }
+
+    // The inner product sums in a different order, compare it relative to the amount of accumulated samples
+    if (std::fabs(dotScalar(reference.data(), reversed.data(), count) - getDotKernel(p_level)(reference.data(), reversed.data(), count)) >
+        SIMD_KERNEL_TOLERANCE * count)
+    {
+        return false;
+    }
+
+    // Cut the mixed waveform into symbols and correlate them against the synthesized and reversed ones, the sums
+    // of a symbol are compared relative to its length
+    const size_t symbolCount = count / SIMD_SELF_CHECK_SYMBOL_LENGTH;
+    std::vector<double> referenceSums(2 * symbolCount);
+    std::vector<double> candidateSums(2 * symbolCount);
+    auto isMatchingSums = [&](double p_tolerance)
+    {
+        for (size_t sumIdx = 0; sumIdx < referenceSums.size(); ++sumIdx)
+        {
+            if (std::fabs(referenceSums[sumIdx] - candidateSums[sumIdx]) > p_tolerance * SIMD_SELF_CHECK_SYMBOL_LENGTH)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+    correlateScalar(reference.data(), SIMD_SELF_CHECK_SYMBOL_LENGTH, symbolCount, mixed.data(), reversed.data(), referenceSums.data(),
+                    referenceSums.data() + symbolCount);
+    getCorrelateKernel(p_level)(reference.data(), SIMD_SELF_CHECK_SYMBOL_LENGTH, symbolCount, mixed.data(), reversed.data(),
+                                candidateSums.data(), candidateSums.data() + symbolCount);
+    if (!isMatchingSums(SIMD_KERNEL_TOLERANCE))
+    {
+        return false;
+    }
+    envelopeScalar(reference.data(), SIMD_SELF_CHECK_SYMBOL_LENGTH, symbolCount, referenceSums.data());
+    getEnvelopeKernel(p_level)(reference.data(), SIMD_SELF_CHECK_SYMBOL_LENGTH, symbolCount, candidateSums.data());
+    if (!isMatchingSums(SIMD_KERNEL_TOLERANCE))
+    {
+        return false;
+    }
+
+    // The tone bank runs an odd amount of tones over the symbols, the vector kernels split every symbol over their
+    // lanes and sum the powers in another order, they are compared relative to the strongest one
+    const std::vector<double> frequencies = {2 * M_PI / SIMD_SELF_CHECK_SYMBOL_LENGTH, 2 * M_PI * 2 / SIMD_SELF_CHECK_SYMBOL_LENGTH,
+                                             2 * M_PI * 3.5 / SIMD_SELF_CHECK_SYMBOL_LENGTH};
+    std::vector<double> referencePowers(symbolCount * frequencies.size());
+    std::vector<double> candidatePowers(symbolCount * frequencies.size());
+    goertzelScalar(reference.data(), SIMD_SELF_CHECK_SYMBOL_LENGTH, symbolCount, frequencies.data(), frequencies.size(),
+                   referencePowers.data());
+    getGoertzelKernel(p_level)(reference.data(), SIMD_SELF_CHECK_SYMBOL_LENGTH, symbolCount, frequencies.data(), frequencies.size(),
+                               candidatePowers.data());
+    const double strongest = *std::max_element(referencePowers.begin(), referencePowers.end());
+    for (size_t powerIdx = 0; powerIdx < referencePowers.size(); ++powerIdx)
+    {
+        if (std::fabs(referencePowers[powerIdx] - candidatePowers[powerIdx]) > SIMD_KERNEL_TOLERANCE * std::max(1.0, strongest))
+        {
+            return false;
+        }
+    }
+
+    // Slide the mixed waveform as a complex reference over the synthesized one, every output sums in another order
+    const size_t tapCount = SIMD_SELF_CHECK_SYMBOL_LENGTH + 1;
+    const size_t outputCount = count - tapCount + 1;
+    std::vector<double> referenceSlides(2 * outputCount);
+    std::vector<double> candidateSlides(2 * outputCount);
+    slideScalar(reference.data(), reversed.data(), outputCount, mixed.data(), mixed.data() + tapCount, tapCount,
+                referenceSlides.data(), referenceSlides.data() + outputCount);
+    getSlideKernel(p_level)(reference.data(), reversed.data(), outputCount, mixed.data(), mixed.data() + tapCount, tapCount,
+                            candidateSlides.data(), candidateSlides.data() + outputCount);
+    for (size_t slideIdx = 0; slideIdx < referenceSlides.size(); ++slideIdx)
+    {
+        if (std::fabs(referenceSlides[slideIdx] - candidateSlides[slideIdx]) > SIMD_KERNEL_TOLERANCE * tapCount)
+        {
+            return false;
+        }
+    }
+
+    std::vector<float> basisI(reference.begin(), reference.end());
+    std::vector<float> basisQ(reversed.begin(), reversed.end());
+    std::vector<float> referenceFloat(count);
+    std::vector<float> candidateFloat(count);
+    combineFloatScalar(referenceFloat.data(), count, basisI.data(), basisQ.data(), 0.5f, -1.5f);
+    getCombineFloatKernel(p_level)(candidateFloat.data(), count, basisI.data(), basisQ.data(), 0.5f, -1.5f);
+    for (size_t sampleIdx = 0; sampleIdx < count; ++sampleIdx)
+    {
+        if (std::fabs(referenceFloat[sampleIdx] - candidateFloat[sampleIdx]) > SIMD_FLOAT_KERNEL_TOLERANCE)
+        {
+            return false;
+        }
+    }
+    correlateFloatScalar(referenceFloat.data(), SIMD_SELF_CHECK_SYMBOL_LENGTH, symbolCount, basisI.data(), basisQ.data(),
+                         referenceSums.data(), referenceSums.data() + symbolCount);
+    getCorrelateFloatKernel(p_level)(referenceFloat.data(), SIMD_SELF_CHECK_SYMBOL_LENGTH, symbolCount, basisI.data(), basisQ.data(),
+                                     candidateSums.data(), candidateSums.data() + symbolCount);
+    if (!isMatchingSums(SIMD_FLOAT_KERNEL_TOLERANCE))
+    {
+        return false;
+    }
+    envelopeFloatScalar(referenceFloat.data(), SIMD_SELF_CHECK_SYMBOL_LENGTH, symbolCount, referenceSums.data());
+    getEnvelopeFloatKernel(p_level)(referenceFloat.data(), SIMD_SELF_CHECK_SYMBOL_LENGTH, symbolCount, candidateSums.data());
+    if (!isMatchingSums(SIMD_FLOAT_KERNEL_TOLERANCE))
+    {
+        return false;
+    }
+
+    // Full scale gains drive the mix into saturation, integer kernels must match bit for bit
+    std::vector<int16_t> basisQ15I(count);
+    std::vector<int16_t> basisQ15Q(count);
+    for (size_t sampleIdx = 0; sampleIdx < count; ++sampleIdx)
+    {
+        basisQ15I[sampleIdx] = toQ15(basisI[sampleIdx] / 4);
+        basisQ15Q[sampleIdx] = toQ15(basisQ[sampleIdx] / 4);
+    }
+    std::vector<int16_t> referenceQ15(count);
+    std::vector<int16_t> candidateQ15(count);
+    for (int16_t gain : {static_cast<int16_t>(12345), static_cast<int16_t>(INT16_MIN)})
+    {
+        combineQ15Scalar(referenceQ15.data(), count, basisQ15I.data(), basisQ15Q.data(), gain, INT16_MAX);
+        getCombineQ15Kernel(p_level)(candidateQ15.data(), count, basisQ15I.data(), basisQ15Q.data(), gain, INT16_MAX);
+        if (referenceQ15 != candidateQ15)
+        {
+            return false;
+        }
+    }
+    // The saturated mix holds INT16_MIN samples, whose magnitude does not fit in 16 bits
+    correlateQ15Scalar(referenceQ15.data(), SIMD_SELF_CHECK_SYMBOL_LENGTH, symbolCount, basisQ15I.data(), basisQ15Q.data(),
+                       referenceSums.data(), referenceSums.data() + symbolCount);
+    getCorrelateQ15Kernel(p_level)(referenceQ15.data(), SIMD_SELF_CHECK_SYMBOL_LENGTH, symbolCount, basisQ15I.data(), basisQ15Q.data(),
+                                   candidateSums.data(), candidateSums.data() + symbolCount);
+    if (referenceSums != candidateSums)
+    {
+        return false;
+    }
+    envelopeQ15Scalar(referenceQ15.data(), SIMD_SELF_CHECK_SYMBOL_LENGTH, symbolCount, referenceSums.data());
+    getEnvelopeQ15Kernel(p_level)(referenceQ15.data(), SIMD_SELF_CHECK_SYMBOL_LENGTH, symbolCount, candidateSums.data());
+    if (referenceSums != candidateSums)
+    {
+        return false;
+    }
+
+    // The signs of the test waveform make the binary series, a stray character must be caught in a full word
+    // as well as in the tail
+    std::string ascii(count, '0');
+    for (size_t sampleIdx = 0; sampleIdx < count; ++sampleIdx)
+    {
+        ascii[sampleIdx] = (referenceQ15[sampleIdx] > 0) ? '1' : '0';
+    }
+    const size_t wordCount = (count + 63) / 64;
+    std::vector<uint64_t> referenceWords(wordCount);
+    std::vector<uint64_t> candidateWords(wordCount);
+    if (!packBitsScalar(ascii.data(), count, referenceWords.data()) ||
+        !getPackBitsKernel(p_level)(ascii.data(), count, candidateWords.data()) || referenceWords != candidateWords)
+    {
+        return false;
+    }
+    for (size_t strayIdx : {static_cast<size_t>(5), count - 1})
+    {
+        std::string stray = ascii;
+        stray[strayIdx] = '2';
+        if (getPackBitsKernel(p_level)(stray.data(), count, candidateWords.data()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,136 @@
+#include "waveformCache.h"
+#include "oscillator.h"
+#include "sampleTraits.h"
+#include "simdKernels.h"
+#include <algorithm>
+
+WaveformCache &WaveformCache::getInstance()
+{
+    static WaveformCache m_instance;
+    return m_instance;
+}
+
+std::shared_ptr<const WaveformTemplate> WaveformCache::getTemplate(ModulationScheme p_scheme, double p_carrierFrequency, double p_sampleRate,
+                                                                   unsigned int p_samplesPerSymbol, double p_initialPhase,
+                                                                   const std::vector<double> &p_toneFrequencies,
+                                                                   const std::vector<SymbolShape> &p_alphabet)
+{
+    auto key = std::make_tuple(p_scheme, p_carrierFrequency, p_sampleRate);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto entry = m_templates.find(key);
+        if (entry != m_templates.end() &&
+            isMatching(*entry->second, p_samplesPerSymbol, p_initialPhase, p_toneFrequencies, p_alphabet))
+        {
+            return entry->second;
+        }
+    }
+
+    // Render outside the lock, concurrent misses on the same key only cost a duplicated build
+    std::shared_ptr<const WaveformTemplate> waveform = buildTemplate(p_sampleRate, p_samplesPerSymbol, p_initialPhase,
+                                                                     p_toneFrequencies, p_alphabet);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_templates.size() >= WAVEFORM_CACHE_MAX_ENTRIES)
+    {
+        m_templates.clear();
+    }
+    m_templates[key] = waveform;
+    return waveform;
+}
+
+void WaveformCache::invalidate()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_templates.clear();
+}
+
+size_t WaveformCache::size()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_templates.size();
+}
+
+std::shared_ptr<const WaveformTemplate> WaveformCache::buildTemplate(double p_sampleRate, unsigned int p_samplesPerSymbol,
+                                                                     double p_initialPhase,
+                                                                     const std::vector<double> &p_toneFrequencies,
+                                                                     const std::vector<SymbolShape> &p_alphabet)
+{
+    const SimdKernels &kernels = SimdKernels::getInstance();
+    auto waveform = std::make_shared<WaveformTemplate>();
+    waveform->sampleRate = p_sampleRate;
+    waveform->samplesPerSymbol = p_samplesPerSymbol;
+    waveform->initialPhase = p_initialPhase;
+    waveform->alphabet = p_alphabet;
+
+    for (double frequency : p_toneFrequencies)
+    {
+        SymbolTone tone;
+        tone.frequency = frequency;
+        tone.inPhase.resize(p_samplesPerSymbol);
+        tone.quadrature.resize(p_samplesPerSymbol);
+        Oscillator oscillator(frequency, p_sampleRate);
+        for (unsigned int sampleIdx = 0; sampleIdx < p_samplesPerSymbol; sampleIdx += OSCILLATOR_RENORMALIZE_INTERVAL)
+        {
+            unsigned int count = std::min(OSCILLATOR_RENORMALIZE_INTERVAL, p_samplesPerSymbol - sampleIdx);
+            kernels.synthesize(tone.inPhase.data() + sampleIdx, count, oscillator.value(), oscillator.getRotation(), 1.0, 0.0);
+            kernels.synthesize(tone.quadrature.data() + sampleIdx, count, oscillator.value(), oscillator.getRotation(), 0.0, 1.0);
+            oscillator.skip(count);
+        }
+        // A whole number of cycles per symbol means the tone phase is the same at every symbol boundary
+        double cyclesPerSymbol = frequency * p_samplesPerSymbol / p_sampleRate;
+        tone.isAligned = (cyclesPerSymbol == std::round(cyclesPerSymbol));
+        tone.inPhaseFloat.assign(tone.inPhase.begin(), tone.inPhase.end());
+        tone.quadratureFloat.assign(tone.quadrature.begin(), tone.quadrature.end());
+        tone.squares = 0.0;
+        for (unsigned int sampleIdx = 0; sampleIdx < p_samplesPerSymbol; ++sampleIdx)
+        {
+            std::complex<double> phasor(tone.inPhase[sampleIdx], tone.quadrature[sampleIdx]);
+            tone.squares += phasor * phasor;
+            tone.inPhaseQ15.push_back(toQ15(tone.inPhase[sampleIdx]));
+            tone.quadratureQ15.push_back(toQ15(tone.quadrature[sampleIdx]));
+        }
+        waveform->tones.emplace_back(std::move(tone));
+    }
+
+    // Symbols on aligned tones always start at the initial phase, so their samples never change
+    const std::complex<double> start = std::polar(1.0, p_initialPhase);
+    for (const SymbolShape &shape : p_alphabet)
+    {
+        std::vector<double> samples;
+        std::vector<int16_t> samplesFixed;
+        const SymbolTone &tone = waveform->tones[shape.tone];
+        if (tone.isAligned && p_alphabet.size() <= WAVEFORM_MAX_RENDERED_SYMBOLS)
+        {
+            double inPhaseGain = shape.inPhaseGain * start.real() + shape.quadratureGain * start.imag();
+            double quadratureGain = shape.quadratureGain * start.real() - shape.inPhaseGain * start.imag();
+            samples.resize(p_samplesPerSymbol);
+            kernels.combine(samples.data(), p_samplesPerSymbol, tone.inPhase.data(), tone.quadrature.data(), inPhaseGain, quadratureGain);
+            // Mixed by the same kernel as the symbols stitched at run time, so both paths give the same samples
+            samplesFixed.resize(p_samplesPerSymbol);
+            kernels.combine(samplesFixed.data(), p_samplesPerSymbol, tone.inPhaseQ15.data(), tone.quadratureQ15.data(),
+                            SampleTraits<int16_t>::fromDouble(inPhaseGain), SampleTraits<int16_t>::fromDouble(quadratureGain));
+        }
+        waveform->waveformsFloat.emplace_back(samples.begin(), samples.end());
+        waveform->waveforms.emplace_back(std::move(samples));
+        waveform->waveformsFixed.emplace_back(std::move(samplesFixed));
+    }
+    return waveform;
+}
+
+bool WaveformCache::isMatching(const WaveformTemplate &p_template, unsigned int p_samplesPerSymbol, double p_initialPhase,
+                               const std::vector<double> &p_toneFrequencies, const std::vector<SymbolShape> &p_alphabet)
+{
+    if (p_template.samplesPerSymbol != p_samplesPerSymbol || p_template.initialPhase != p_initialPhase ||
+        p_template.alphabet != p_alphabet || p_template.tones.size() != p_toneFrequencies.size())
+    {
+        return false;
+    }
+    for (size_t toneIdx = 0; toneIdx < p_toneFrequencies.size(); ++toneIdx)
+    {
+        if (p_template.tones[toneIdx].frequency != p_toneFrequencies[toneIdx])
+        {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,217 @@
+#include "testCommon.h"
+#include "simdKernels.h"
+
+namespace
+{
+    /// @brief The longest series packed, a few words past the widest SIMD block so every tail length is covered
+    constexpr size_t MAX_PACK_LENGTH = 200;
+
+    /// @brief The length of the series the random operations start from
+    constexpr size_t TEST_SERIES_LENGTH = 1000;
+
+    /// @brief The amount of random operations compared with the string reference
+    constexpr unsigned int RANDOM_OPERATION_COUNT = 20000;
+
+    /**
+     * @brief Generate a random ASCII binary series
+     *
+     * @param p_length - the amount of characters
+     * @param p_generator - the random generator
+     *
+     * @return a series of '0' and '1' characters
+     */
+    std::string generateAscii(const size_t p_length, std::default_random_engine &p_generator)
+    {
+        std::uniform_int_distribution<int> bit(0, 1);
+        std::string ascii(p_length, '0');
+        for (char &character : ascii)
+        {
+            character = static_cast<char>('0' + bit(p_generator));
+        }
+        return ascii;
+    }
+
+    /**
+     * @brief Count the characters of a received series from p_firstBit that differ from a sent one, past its end all count
+     *
+     * @param p_sent - the sent series
+     * @param p_received - the received series
+     * @param p_firstBit - index of the first received character to check
+     *
+     * @return the amount of bit errors
+     */
+    size_t countReferenceErrors(const std::string &p_sent, const std::string &p_received, const size_t p_firstBit)
+    {
+        size_t errors = 0;
+        for (size_t bitIdx = p_firstBit; bitIdx < p_received.size(); ++bitIdx)
+        {
+            errors += (bitIdx >= p_sent.size() || p_sent[bitIdx] != p_received[bitIdx]) ? 1 : 0;
+        }
+        return errors;
+    }
+
+    /**
+     * @brief Pack every length up to MAX_PACK_LENGTH, and reject a series with one invalid character at any position
+     *
+     * @param p_report - the report of the check
+     */
+    void checkPack(TestReport &p_report)
+    {
+        std::default_random_engine generator(1);
+        for (size_t length = 0; length <= MAX_PACK_LENGTH; ++length)
+        {
+            std::string ascii = generateAscii(length, generator);
+            BitBuffer bits;
+            bool isPacked = BitBuffer::pack(ascii, bits);
+            p_report.expect(isPacked && bits.toString() == ascii, stringify("a series of ", length, " bits does not pack"));
+
+            // Every bit after the last one must stay 0 for word compares, pushing them one by one gives the same words
+            BitBuffer pushed;
+            for (char character : ascii)
+            {
+                pushed.pushBits(static_cast<unsigned int>(character - '0'), 1);
+            }
+            p_report.expect(bits == pushed, stringify("a packed series of ", length, " bits differs from the pushed one"));
+        }
+
+        for (size_t length : {1ul, 15ul, 16ul, 17ul, 64ul, 100ul, MAX_PACK_LENGTH})
+        {
+            std::string ascii = generateAscii(length, generator);
+            size_t acceptedCount = 0;
+            for (size_t charIdx = 0; charIdx < length; ++charIdx)
+            {
+                for (char invalid : {'2', '/', ' ', 'a', '\0', '\x80'})
+                {
+                    std::string corrupted = ascii;
+                    corrupted[charIdx] = invalid;
+                    BitBuffer bits;
+                    if (BitBuffer::pack(corrupted, bits) || !bits.empty())
+                    {
+                        ++acceptedCount;
+                    }
+                }
+            }
+            p_report.expect(acceptedCount == 0,
+                            stringify(acceptedCount, " series of ", length, " bits with an invalid character are packed"));
+        }
+    }
+
+    /**
+     * @brief Apply random operations to a buffer and a string side by side and compare them after every one
+     *
+     * @param p_report - the report of the check
+     */
+    void checkOperations(TestReport &p_report)
+    {
+        std::default_random_engine generator(2);
+        std::string reference = generateAscii(TEST_SERIES_LENGTH, generator);
+        BitBuffer bits;
+        BitBuffer::pack(reference, bits);
+        std::uniform_int_distribution<unsigned int> operation(0, 5);
+        std::uniform_int_distribution<unsigned int> count(1, 32);
+        std::uniform_int_distribution<size_t> length(0, 3 * BIT_BUFFER_WORD_BITS);
+        unsigned int mismatchCount = 0;
+        for (unsigned int operationIdx = 0; operationIdx < RANDOM_OPERATION_COUNT; ++operationIdx)
+        {
+            // Kinds 4 and 5 only read, the series is kept around TEST_SERIES_LENGTH so every offset in a word is reached
+            const unsigned int kind = (reference.size() > 2 * TEST_SERIES_LENGTH) ? 2 : operation(generator);
+            if (kind == 0)
+            {
+                const unsigned int bitCount = count(generator);
+                std::string pushed = generateAscii(bitCount, generator);
+                bits.pushBits(static_cast<unsigned int>(std::stoull(pushed, nullptr, 2)), bitCount);
+                reference += pushed;
+            }
+            else if (kind == 1)
+            {
+                std::string appended = generateAscii(length(generator), generator);
+                BitBuffer appendedBits;
+                BitBuffer::pack(appended, appendedBits);
+                bits.append(appendedBits);
+                reference += appended;
+            }
+            else if (kind == 2)
+            {
+                const size_t size = std::uniform_int_distribution<size_t>(0, TEST_SERIES_LENGTH + 100)(generator);
+                bits.resize(size);
+                reference.resize(size, '0');
+            }
+            else if (kind == 3 && !reference.empty())
+            {
+                const size_t bitIdx = std::uniform_int_distribution<size_t>(0, reference.size() - 1)(generator);
+                const unsigned int value = count(generator) % 2;
+                bits.setBit(bitIdx, value);
+                reference[bitIdx] = static_cast<char>('0' + value);
+            }
+
+            // Read a random symbol and a random bit, then compare the whole series
+            if (!reference.empty())
+            {
+                const size_t bitIdx = std::uniform_int_distribution<size_t>(0, reference.size() - 1)(generator);
+                const unsigned int bitCount = std::min<size_t>(count(generator), reference.size() - bitIdx);
+                if (bits.getBits(bitIdx, bitCount) != std::stoull(reference.substr(bitIdx, bitCount), nullptr, 2) ||
+                    bits.getBit(bitIdx) != static_cast<unsigned int>(reference[bitIdx] - '0'))
+                {
+                    ++mismatchCount;
+                }
+            }
+            BitBuffer expected;
+            BitBuffer::pack(reference, expected);
+            if (bits.size() != reference.size() || bits.toString() != reference || bits != expected)
+            {
+                ++mismatchCount;
+            }
+        }
+        p_report.expect(mismatchCount == 0, stringify(mismatchCount, " of ", RANDOM_OPERATION_COUNT,
+                                                      " random operations differ from the string reference"));
+    }
+
+    /**
+     * @brief Count errors between random series of random lengths from every first bit, as the string reference does
+     *
+     * @param p_report - the report of the check
+     */
+    void checkCountErrors(TestReport &p_report)
+    {
+        std::default_random_engine generator(3);
+        std::uniform_int_distribution<size_t> length(0, 4 * BIT_BUFFER_WORD_BITS);
+        std::uniform_int_distribution<int> flip(0, 3);
+        unsigned int mismatchCount = 0;
+        unsigned int caseCount = 0;
+        for (unsigned int pairIdx = 0; pairIdx < 200; ++pairIdx)
+        {
+            std::string sent = generateAscii(length(generator), generator);
+            std::string received = sent;
+            received.resize(length(generator), '0');
+            for (char &character : received)
+            {
+                // One bit in four flipped, so errors fall in every word
+                character = (flip(generator) == 0) ? static_cast<char>('0' + '1' - character) : character;
+            }
+            BitBuffer sentBits;
+            BitBuffer receivedBits;
+            BitBuffer::pack(sent, sentBits);
+            BitBuffer::pack(received, receivedBits);
+            for (size_t firstBit = 0; firstBit <= received.size() + 1; ++firstBit)
+            {
+                ++caseCount;
+                if (sentBits.countErrors(receivedBits, firstBit) != countReferenceErrors(sent, received, firstBit))
+                {
+                    ++mismatchCount;
+                }
+            }
+        }
+        p_report.expect(mismatchCount == 0,
+                        stringify(mismatchCount, " of ", caseCount, " error counts differ from the string reference"));
+    }
+}
+
+int main()
+{
+    std::cout << "Packing with the " << SimdKernels::getInstance().getLevelName() << " kernels" << std::endl;
+    TestReport report;
+    checkPack(report);
+    checkOperations(report);
+    checkCountErrors(report);
+    return report.finish();
+}
@@ -0,0 +1,117 @@
+#include "testCommon.h"
+#include "modulator.h"
+#include "ofdm.h"
+#include "pulseShaper.h"
+
+namespace
+{
+    /// @brief The lengths of the appended messages in bits, whole symbols of every scheme
+    const std::vector<size_t> TEST_MESSAGE_BITS = {768, 144, 480};
+
+    /// @brief The lengths of the appended OFDM messages in bits, whole OFDM symbols of 64 16-QAM subcarriers but the last
+    const std::vector<size_t> TEST_OFDM_MESSAGE_BITS = {768, 1536, 144};
+
+    /**
+     * @brief Produce every remaining sample of a session at the end of a signal
+     *
+     * @tparam T - the sample type
+     * @param p_session - the session
+     * @param p_signal - the signal, extended
+     */
+    template <typename T>
+    void produceAll(ModulationSession &p_session, std::vector<T> &p_signal)
+    {
+        size_t offset = p_signal.size();
+        p_signal.resize(offset + p_session.getTotalSamples());
+        p_signal.resize(offset + p_session.produce(p_signal.data() + offset, p_session.getTotalSamples()));
+    }
+
+    /**
+     * @brief Append messages to one continuous session and compare the waveform with one continuous session over the
+     * joined messages, and with the joined message modulated at once when the stream is not delayed by shaped pulses
+     *
+     * @tparam T - the sample type
+     * @param p_report - the report of the check
+     * @param p_scheme - the scheme
+     * @param p_frequency - the carrier frequency
+     * @param p_name - the name of the case
+     * @param p_lengths - the lengths of the messages in bits
+     */
+    template <typename T>
+    void checkAppend(TestReport &p_report, const ModulationScheme p_scheme, const double p_frequency, const std::string &p_name,
+                     const std::vector<size_t> &p_lengths = TEST_MESSAGE_BITS)
+    {
+        Modulator modulator;
+        modulator.setFrequency(p_frequency);
+        modulator.setNoisy(false);
+        std::vector<BitBuffer> messages;
+        for (size_t messageIdx = 0; messageIdx < p_lengths.size(); ++messageIdx)
+        {
+            messages.push_back(generateTestMessage(p_lengths[messageIdx], messageIdx));
+        }
+
+        modulator.setBinaryInput(messages.front());
+        ModulationSession session = modulator.startModulation(p_scheme);
+        session.setContinuous();
+        std::vector<T> continued;
+        BitBuffer joined;
+        for (size_t messageIdx = 0; messageIdx < messages.size(); ++messageIdx)
+        {
+            if (messageIdx > 0)
+            {
+                session.append(messages[messageIdx]);
+                if (p_scheme == ModulationScheme::GMSK)
+                {
+                    // GMSK sent the flush symbols of the previous message, they are 0 bits of the joined message
+                    joined.resize(continued.size() / session.getSamplesPerSymbol());
+                }
+            }
+            produceAll(session, continued);
+            joined.append(messages[messageIdx]);
+        }
+        session.endStream();
+        produceAll(session, continued);
+
+        modulator.setBinaryInput(joined);
+        ModulationSession whole = modulator.startModulation(p_scheme);
+        whole.setContinuous();
+        std::vector<T> expected;
+        produceAll(whole, expected);
+        whole.endStream();
+        produceAll(whole, expected);
+        p_report.expect(continued == expected, stringify(p_name.c_str(), ": the appended waveform of ", continued.size(),
+                                                         " samples differs from the joined one of ", expected.size()));
+        std::vector<T> atOnce = modulator.modulate<T>(p_scheme);
+        p_report.expect(expected.size() != atOnce.size() || expected == atOnce,
+                        stringify(p_name.c_str(), ": the continuous waveform differs from the one modulated at once"));
+    }
+}
+
+int main()
+{
+    initTestDatabase();
+    TestReport report;
+    for (double frequency : {1.0, 3.0, 7.0})
+    {
+        for (ModulationScheme scheme : {ModulationScheme::ASK, ModulationScheme::PSK, ModulationScheme::FSK, ModulationScheme::QAM16,
+                                        ModulationScheme::PSK8, ModulationScheme::FSK8, ModulationScheme::GMSK})
+        {
+            std::string name = stringify(getSchemeName(scheme), " at ", frequency, " Hz");
+            checkAppend<double>(report, scheme, frequency, name + " in double");
+            checkAppend<int16_t>(report, scheme, frequency, name + " in int16");
+        }
+    }
+
+    // Shaped pulses carry across the messages, the tails of the last ones follow the end of the stream
+    setTestValue(PULSE_SHAPE_KEY, "char", "rrc");
+    checkAppend<double>(report, ModulationScheme::QPSK, 3, "QPSK with RRC pulses in double");
+    checkAppend<int16_t>(report, ModulationScheme::QAM16, 7, "16-QAM with RRC pulses in int16");
+    setTestValue(PULSE_SHAPE_KEY, "char", "gaussian");
+    checkAppend<double>(report, ModulationScheme::PSK, 1, "PSK with Gaussian pulses in double");
+    setTestValue(PULSE_SHAPE_KEY, "char", "rectangular");
+
+    // OFDM symbols stay timed from the first message
+    setTestValue(OFDM_SUBCARRIERS_KEY, "u32", "64");
+    checkAppend<double>(report, ModulationScheme::QAM16, 5, "OFDM 16-QAM in double", TEST_OFDM_MESSAGE_BITS);
+    return report.finish();
+}
@@ -0,0 +1,114 @@
+#include "testCommon.h"
+#include "correlator.h"
+#include <stdexcept>
+
+namespace
+{
+    /// @brief The longest signal correlated, several overlap-save blocks of the longest reference
+    constexpr size_t TEST_SIGNAL_SAMPLES = 5000;
+
+    /// @brief The largest difference with the naive correlation, relative to the square root of the reference length
+    constexpr double CORRELATION_TOLERANCE = 1e-10;
+
+    /**
+     * @brief Generate a reproducible complex Gaussian signal
+     *
+     * @param p_length - the amount of samples
+     * @param p_seed - the seed of the generator
+     *
+     * @return the signal
+     */
+    std::vector<std::complex<double>> generateSignal(const size_t p_length, const unsigned int p_seed)
+    {
+        std::default_random_engine generator(p_seed);
+        std::normal_distribution<double> distribution(0, 1);
+        std::vector<std::complex<double>> signal(p_length);
+        for (std::complex<double> &sample : signal)
+        {
+            sample = {distribution(generator), distribution(generator)};
+        }
+        return signal;
+    }
+
+    /**
+     * @brief Correlate sample by sample, the definition of Correlator
+     *
+     * @param p_signal - the signal
+     * @param p_reference - the reference
+     *
+     * @return the correlations, empty when the signal is shorter than the reference
+     */
+    std::vector<std::complex<double>> correlateNaive(const std::vector<std::complex<double>> &p_signal,
+                                                     const std::vector<std::complex<double>> &p_reference)
+    {
+        std::vector<std::complex<double>> output;
+        for (size_t outputIdx = 0; outputIdx + p_reference.size() <= p_signal.size(); ++outputIdx)
+        {
+            std::complex<double> sum = 0;
+            for (size_t tapIdx = 0; tapIdx < p_reference.size(); ++tapIdx)
+            {
+                sum += p_signal[outputIdx + tapIdx] * std::conj(p_reference[tapIdx]);
+            }
+            output.push_back(sum);
+        }
+        return output;
+    }
+
+    /**
+     * @brief Compare both methods with the naive correlation for one reference length and several signal lengths
+     *
+     * @param p_report - the report of the check
+     * @param p_tapCount - the reference length
+     */
+    void checkTaps(TestReport &p_report, const size_t p_tapCount)
+    {
+        std::vector<std::complex<double>> reference = generateSignal(p_tapCount, static_cast<unsigned int>(p_tapCount));
+        for (size_t sampleCount : {p_tapCount - 1, p_tapCount, p_tapCount + 1, TEST_SIGNAL_SAMPLES})
+        {
+            std::vector<std::complex<double>> signal = generateSignal(sampleCount, static_cast<unsigned int>(sampleCount));
+            std::vector<std::complex<double>> expected = correlateNaive(signal, reference);
+            for (CorrelationMethod method : {CorrelationMethod::DIRECT, CorrelationMethod::OVERLAP_SAVE})
+            {
+                std::vector<std::complex<double>> output = Correlator(reference, method).correlate(signal);
+                double difference = (output.size() == expected.size()) ? 0 : HUGE_VAL;
+                for (size_t outputIdx = 0; outputIdx < std::min(output.size(), expected.size()); ++outputIdx)
+                {
+                    difference = std::max(difference, std::abs(output[outputIdx] - expected[outputIdx]));
+                }
+                p_report.expect(difference <= CORRELATION_TOLERANCE * std::sqrt(static_cast<double>(p_tapCount)),
+                                stringify((method == CorrelationMethod::DIRECT) ? "direct" : "overlap-save", " correlation of ",
+                                          sampleCount, " samples against ", p_tapCount, " taps differs by ", difference));
+            }
+        }
+    }
+}
+
+int main()
+{
+    initTestDatabase();
+    TestReport report;
+    const size_t minFftTaps = CorrelationCrossover::getInstance().getMinFftTaps();
+    for (size_t tapCount : {1ul, 3ul, 64ul, minFftTaps - 1, minFftTaps, 1000ul})
+    {
+        checkTaps(report, tapCount);
+    }
+
+    // The method follows the crossover of the database
+    report.expect(minFftTaps > 0, "the crossover of the database is 0");
+    report.expect(Correlator(generateSignal(minFftTaps - 1, 0)).getMethod() == CorrelationMethod::DIRECT,
+                  stringify("a reference of ", minFftTaps - 1, " taps is not correlated directly"));
+    report.expect(Correlator(generateSignal(minFftTaps, 0)).getMethod() == CorrelationMethod::OVERLAP_SAVE,
+                  stringify("a reference of ", minFftTaps, " taps is not correlated on the FFT"));
+
+    bool isRejected = false;
+    try
+    {
+        Correlator correlator(std::vector<std::complex<double>>{});
+    }
+    catch (const std::invalid_argument &e)
+    {
+        isRejected = true;
+    }
+    report.expect(isRejected, "an empty reference is accepted");
+    return report.finish();
+}
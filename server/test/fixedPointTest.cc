@@ -0,0 +1,104 @@
+#include "testCommon.h"
+#include "modulator.h"
+#include "carrier.h"
+
+namespace
+{
+    /// @brief The bits of the messages, whole symbols of every scheme
+    constexpr size_t TEST_MESSAGE_BITS = 2400;
+
+    /// @brief The carrier frequency of the check, 500 samples per carrier cycle
+    constexpr double TEST_CARRIER_FREQUENCY = 10;
+
+    /// @brief The largest difference between a fixed-point and a floating point sample of one noiseless signal, in LSB
+    constexpr int MAX_MODULATION_LSB = 1;
+
+    /**
+     * @brief Compare the fixed-point and the floating point int16 paths of a scheme at several noise levels
+     *
+     * @param p_report - the report of the check
+     * @param p_scheme - the scheme
+     */
+    void checkScheme(TestReport &p_report, const ModulationScheme p_scheme)
+    {
+        Modulator modulator;
+        modulator.setFrequency(TEST_CARRIER_FREQUENCY);
+        modulator.setNoisy(false);
+        BitBuffer message = generateTestMessage(TEST_MESSAGE_BITS, static_cast<unsigned int>(p_scheme));
+        modulator.setBinaryInput(message);
+        modulator.setArithmetic(Arithmetic::FLOATING_POINT);
+        std::vector<int16_t> floatSignal = modulator.modulate<int16_t>(p_scheme);
+        modulator.setArithmetic(Arithmetic::FIXED_POINT);
+        std::vector<int16_t> fixedSignal = modulator.modulate<int16_t>(p_scheme);
+
+        int difference = (fixedSignal.size() == floatSignal.size()) ? 0 : INT16_MAX;
+        for (size_t sampleIdx = 0; sampleIdx < std::min(fixedSignal.size(), floatSignal.size()); ++sampleIdx)
+        {
+            difference = std::max(difference, std::abs(fixedSignal[sampleIdx] - floatSignal[sampleIdx]));
+        }
+        p_report.expect(difference <= MAX_MODULATION_LSB,
+                        stringify(getSchemeName(p_scheme), ": the fixed-point signal differs by ", difference, " LSB"));
+
+        for (double sigma : {0.5, 2.0, 4.0})
+        {
+            std::vector<int16_t> signal = floatSignal;
+            addTestNoise(signal, sigma, static_cast<unsigned int>(sigma * 10));
+            modulator.setArithmetic(Arithmetic::FLOATING_POINT);
+            BitBuffer floatBits = modulator.demodulate(signal, p_scheme);
+            modulator.setArithmetic(Arithmetic::FIXED_POINT);
+            BitBuffer fixedBits = modulator.demodulate(signal, p_scheme);
+            size_t floatErrors = message.countErrors(floatBits, 0);
+            size_t fixedErrors = message.countErrors(fixedBits, 0);
+            std::cout << getSchemeName(p_scheme) << " sigma " << sigma << ": " << floatErrors << " floating point and "
+                      << fixedErrors << " fixed-point bit errors" << std::endl;
+            p_report.expect(fixedBits.size() == floatBits.size() && floatBits.countErrors(fixedBits, 0) == 0,
+                            stringify(getSchemeName(p_scheme), " sigma ", sigma, ": ", floatBits.countErrors(fixedBits, 0),
+                                      " fixed-point decisions differ from floating point"));
+            p_report.expect(fixedErrors == floatErrors, stringify(getSchemeName(p_scheme), " sigma ", sigma, ": ", fixedErrors,
+                                                                  " fixed-point and ", floatErrors, " floating point bit errors"));
+            // 500 samples per symbol leave the coherent detectors error free at the lowest noise, the ASK envelope
+            // detector is biased by the noise power
+            p_report.expect(sigma > 0.5 || p_scheme == ModulationScheme::ASK || floatErrors == 0,
+                            stringify(getSchemeName(p_scheme), " sigma ", sigma, ": ", floatErrors, " bit errors"));
+        }
+    }
+
+    /**
+     * @brief Check which networks a /fixedPointCarriers setting runs in fixed point
+     *
+     * @param p_report - the report of the check
+     * @param p_setting - the value of /fixedPointCarriers
+     * @param p_fixedPointNetworks - the networks expected in fixed point, the others are expected in floating point
+     */
+    void checkCarrierSetting(TestReport &p_report, const std::string &p_setting, const std::vector<std::string> &p_fixedPointNetworks)
+    {
+        setTestValue(FIXED_POINT_CARRIERS_KEY, "char", p_setting);
+        for (const std::string network : {"2G", "3G", "4G", "5G"})
+        {
+            Carrier carrier;
+            carrier.setNetwork(network);
+            bool isFixedPoint = std::find(p_fixedPointNetworks.begin(), p_fixedPointNetworks.end(), network) != p_fixedPointNetworks.end();
+            p_report.expect((carrier.getArithmetic() == Arithmetic::FIXED_POINT) == isFixedPoint,
+                            stringify("/fixedPointCarriers \"", p_setting.c_str(), "\": ", network.c_str(), " is not in ",
+                                      isFixedPoint ? "fixed" : "floating", " point"));
+        }
+    }
+}
+
+int main()
+{
+    initTestDatabase();
+    TestReport report;
+    for (ModulationScheme scheme : {ModulationScheme::ASK, ModulationScheme::PSK, ModulationScheme::FSK, ModulationScheme::QAM16,
+                                    ModulationScheme::QPSK, ModulationScheme::PSK8, ModulationScheme::QAM64})
+    {
+        checkScheme(report, scheme);
+    }
+
+    // Networks are listed whole, a longer name that contains one does not select it
+    checkCarrierSetting(report, "none", {});
+    checkCarrierSetting(report, "3G,5G", {"3G", "5G"});
+    checkCarrierSetting(report, " 4G  2G ", {"2G", "4G"});
+    checkCarrierSetting(report, "4G-LTE 5G2G", {});
+    return report.finish();
+}
@@ -0,0 +1,82 @@
+#include "testCommon.h"
+#include "modulator.h"
+#include "ofdm.h"
+
+namespace
+{
+    /// @brief The lengths of the messages of a batch in bits, whole symbols of every scheme
+    const std::vector<size_t> TEST_MESSAGE_BITS = {24, 480, 48, 1200, 240};
+
+    /**
+     * @brief Modulate a batch and compare every slice with the message modulated on its own
+     *
+     * @tparam T - the sample type
+     * @param p_report - the report of the check
+     * @param p_scheme - the scheme
+     * @param p_typeName - the name of the sample type
+     */
+    template <typename T>
+    void checkBatch(TestReport &p_report, const ModulationScheme p_scheme, const char *p_typeName)
+    {
+        Modulator modulator;
+        modulator.setFrequency(7);
+        modulator.setNoisy(false);
+        std::vector<BitBuffer> messages;
+        for (size_t messageIdx = 0; messageIdx < TEST_MESSAGE_BITS.size(); ++messageIdx)
+        {
+            messages.push_back(generateTestMessage(TEST_MESSAGE_BITS[messageIdx], messageIdx));
+        }
+        ModulationBatch<T> batch = modulator.modulateBatch<T>(messages, p_scheme);
+
+        std::string name = stringify(getSchemeName(p_scheme), " ", p_typeName);
+        if (!p_report.expect(batch.offsets.size() == messages.size() + 1 && batch.offsets.front() == 0 &&
+                                 batch.offsets.back() == batch.samples.size(),
+                             stringify(name, ": the offsets do not split the batch")))
+        {
+            return;
+        }
+        for (size_t messageIdx = 0; messageIdx < messages.size(); ++messageIdx)
+        {
+            modulator.setBinaryInput(messages[messageIdx]);
+            std::vector<T> signal = modulator.modulate<T>(p_scheme);
+            std::vector<T> slice(batch.samples.begin() + batch.offsets[messageIdx], batch.samples.begin() + batch.offsets[messageIdx + 1]);
+            p_report.expect(slice == signal, stringify(name, ": slice ", messageIdx, " of ", slice.size(), " samples differs from the ",
+                                                       signal.size(), " samples of the message"));
+            BitBuffer received = modulator.demodulate(slice, p_scheme);
+            p_report.expect(received.size() == messages[messageIdx].size() && messages[messageIdx].countErrors(received, 0) == 0,
+                            stringify(name, ": slice ", messageIdx, " is not demodulated to its message"));
+        }
+        p_report.expect(modulator.modulateBatch<T>({}, p_scheme).offsets == std::vector<size_t>{0},
+                        stringify(name, ": an empty batch has samples"));
+    }
+
+    /**
+     * @brief Check a scheme in every sample type
+     *
+     * @param p_report - the report of the check
+     * @param p_scheme - the scheme
+     */
+    void checkScheme(TestReport &p_report, const ModulationScheme p_scheme)
+    {
+        checkBatch<double>(p_report, p_scheme, "double");
+        checkBatch<float>(p_report, p_scheme, "float");
+        checkBatch<int16_t>(p_report, p_scheme, "int16");
+    }
+}
+
+int main()
+{
+    initTestDatabase();
+    TestReport report;
+    for (ModulationScheme scheme : {ModulationScheme::ASK, ModulationScheme::PSK, ModulationScheme::FSK, ModulationScheme::QAM16,
+                                    ModulationScheme::QPSK, ModulationScheme::PSK8, ModulationScheme::QAM64, ModulationScheme::FSK4,
+                                    ModulationScheme::GMSK})
+    {
+        checkScheme(report, scheme);
+    }
+
+    // The OFDM sessions restart on every message too
+    setTestValue(OFDM_SUBCARRIERS_KEY, "u32", "48");
+    checkScheme(report, ModulationScheme::QAM16);
+    return report.finish();
+}
@@ -0,0 +1,100 @@
+#include "testCommon.h"
+#include "fft.h"
+#include "modulator.h"
+#include "ofdm.h"
+
+namespace
+{
+    /// @brief The largest transform size compared with the DFT
+    constexpr size_t MAX_TEST_FFT_SIZE = 1024;
+
+    /// @brief The largest difference between a bin and the DFT, relative to the size
+    constexpr double FFT_TOLERANCE = 1e-13;
+
+    /// @brief The bits of the modulated messages, whole symbols of every QAM order
+    constexpr size_t TEST_MESSAGE_BITS = 2400;
+
+    /**
+     * @brief Compare the forward and inverse transforms of one size with a direct DFT
+     *
+     * @param p_report - the report of the check
+     * @param p_size - the transform size
+     */
+    void checkTransform(TestReport &p_report, const size_t p_size)
+    {
+        std::default_random_engine generator(p_size);
+        std::normal_distribution<double> distribution(0, 1);
+        std::vector<std::complex<double>> samples(p_size);
+        for (std::complex<double> &sample : samples)
+        {
+            sample = {distribution(generator), distribution(generator)};
+        }
+        std::shared_ptr<const FftPlan> plan = FftPlanCache::getInstance().getPlan(p_size);
+        std::vector<std::complex<double>> spectrum = samples;
+        plan->forward(spectrum.data());
+
+        double forwardError = 0;
+        for (size_t binIdx = 0; binIdx < p_size; ++binIdx)
+        {
+            std::complex<double> bin = 0;
+            for (size_t sampleIdx = 0; sampleIdx < p_size; ++sampleIdx)
+            {
+                bin += samples[sampleIdx] * std::polar(1.0, -2 * M_PI * static_cast<double>(binIdx * sampleIdx % p_size) / p_size);
+            }
+            forwardError = std::max(forwardError, std::abs(bin - spectrum[binIdx]));
+        }
+        plan->inverse(spectrum.data());
+        double inverseError = 0;
+        for (size_t sampleIdx = 0; sampleIdx < p_size; ++sampleIdx)
+        {
+            inverseError = std::max(inverseError, std::abs(spectrum[sampleIdx] / static_cast<double>(p_size) - samples[sampleIdx]));
+        }
+        p_report.expect(forwardError < FFT_TOLERANCE * p_size,
+                        stringify("FFT of size ", p_size, " differs from the DFT by ", forwardError));
+        p_report.expect(inverseError < FFT_TOLERANCE, stringify("inverse FFT of size ", p_size, " differs by ", inverseError));
+    }
+
+    /**
+     * @brief Modulate and demodulate an OFDM message in passband and in baseband
+     *
+     * @param p_report - the report of the check
+     * @param p_subcarriers - the amount of subcarriers
+     * @param p_scheme - the QAM scheme of the subcarriers
+     */
+    void checkRoundTrip(TestReport &p_report, const unsigned int p_subcarriers, const ModulationScheme p_scheme)
+    {
+        setTestValue(OFDM_SUBCARRIERS_KEY, "u32", std::to_string(p_subcarriers));
+        Modulator modulator;
+        modulator.setFrequency(5);
+        BitBuffer message = generateTestMessage(TEST_MESSAGE_BITS, p_subcarriers);
+        modulator.setBinaryInput(message);
+        std::string name = stringify(getSchemeName(p_scheme), " on ", p_subcarriers, " subcarriers");
+        p_report.expect(modulator.usesResourceGrid(p_scheme) && modulator.getOfdmSubcarriers() == p_subcarriers,
+                        stringify(name, ": OFDM is not used"));
+
+        BitBuffer received = modulator.demodulate(modulator.modulate<double>(p_scheme), p_scheme);
+        p_report.expect(received.size() == message.size() && message.countErrors(received, 0) == 0,
+                        stringify(name, ": ", message.countErrors(received, 0), " bit errors in passband"));
+        received = modulator.demodulateBaseband(modulator.modulateBaseband(p_scheme), p_scheme);
+        p_report.expect(received.size() == message.size() && message.countErrors(received, 0) == 0,
+                        stringify(name, ": ", message.countErrors(received, 0), " bit errors in baseband"));
+    }
+}
+
+int main()
+{
+    initTestDatabase();
+    TestReport report;
+    for (size_t size = 1; size <= MAX_TEST_FFT_SIZE; size *= 2)
+    {
+        checkTransform(report, size);
+    }
+    for (unsigned int subcarriers : {16u, 48u, 64u})
+    {
+        for (ModulationScheme scheme : {ModulationScheme::QAM16, ModulationScheme::QAM64, ModulationScheme::QAM256})
+        {
+            checkRoundTrip(report, subcarriers, scheme);
+        }
+    }
+    return report.finish();
+}
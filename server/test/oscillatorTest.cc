@@ -0,0 +1,81 @@
+#include "testCommon.h"
+#include "oscillator.h"
+
+namespace
+{
+    /// @brief The sample rate of the oscillators, the server default
+    constexpr double TEST_SAMPLE_RATE = 5000;
+
+    /// @brief The amount of samples every oscillator runs for, more than an hour of signal at TEST_SAMPLE_RATE
+    constexpr uint64_t TEST_SAMPLE_COUNT = 20000000;
+
+    /// @brief The largest phase error between the rotated phasor and the phase accumulator
+    constexpr double MAX_PHASE_ERROR = 1e-14;
+
+    /// @brief The largest difference between a phasor and the libm phasor of the accumulator phase
+    constexpr double MAX_PHASOR_ERROR = 1e-13;
+
+    /// @brief The largest phase drift after TEST_SAMPLE_COUNT samples, from the rounding of the phase step
+    constexpr double MAX_CYCLE_DRIFT = 1e-10;
+
+    /**
+     * @brief Run an oscillator for TEST_SAMPLE_COUNT samples and check every phasor against its accumulator phase
+     *
+     * @param p_report - the report of the check
+     * @param p_frequency - the oscillator frequency
+     */
+    void checkDrift(TestReport &p_report, const double p_frequency)
+    {
+        Oscillator oscillator(p_frequency, TEST_SAMPLE_RATE, -M_PI / 2);
+        double phaseError = 0;
+        double phasorError = 0;
+        for (uint64_t sampleIdx = 0; sampleIdx < TEST_SAMPLE_COUNT; ++sampleIdx)
+        {
+            phaseError = std::max(phaseError, oscillator.getPhaseError());
+            phasorError = std::max(phasorError, std::abs(oscillator.value() - std::polar(1.0, oscillator.getPhase())));
+            oscillator.next();
+        }
+        p_report.expect(phaseError < MAX_PHASE_ERROR,
+                        stringify(p_frequency, " Hz: phase error reached ", phaseError, " rad after ", TEST_SAMPLE_COUNT, " samples"));
+        p_report.expect(phasorError < MAX_PHASOR_ERROR, stringify(p_frequency, " Hz: phasor error reached ", phasorError));
+
+        // Every tested frequency runs a whole number of cycles, the quantized phase step only drifts by 2^-65 cycle per sample
+        p_report.expect(std::abs(oscillator.value() - std::polar(1.0, -M_PI / 2)) < MAX_CYCLE_DRIFT,
+                        stringify(p_frequency, " Hz: the phase drifted from the initial phase after whole cycles"));
+    }
+
+    /**
+     * @brief Check that skipping samples lands on the phasor of generating them
+     *
+     * @param p_report - the report of the check
+     * @param p_frequency - the oscillator frequency
+     */
+    void checkSkip(TestReport &p_report, const double p_frequency)
+    {
+        Oscillator generated(p_frequency, TEST_SAMPLE_RATE, 0.3);
+        Oscillator skipped(p_frequency, TEST_SAMPLE_RATE, 0.3);
+        for (uint64_t count : {1ull, 1023ull, 1024ull, 1025ull, 100000ull})
+        {
+            for (uint64_t sampleIdx = 0; sampleIdx < count; ++sampleIdx)
+            {
+                generated.next();
+            }
+            skipped.skip(count);
+            p_report.expect(std::abs(generated.value() - skipped.value()) < MAX_PHASOR_ERROR &&
+                                generated.getPhase() == skipped.getPhase(),
+                            stringify(p_frequency, " Hz: skipping ", count, " samples differs from generating them"));
+        }
+    }
+}
+
+int main()
+{
+    TestReport report;
+    // Carriers of the antenna range (1 to 10 Hz), a fractional one, and the top 8-FSK tone of a 10 Hz carrier
+    for (double frequency : {3.0, 7.3, 80.0})
+    {
+        checkDrift(report, frequency);
+        checkSkip(report, frequency);
+    }
+    return report.finish();
+}
@@ -0,0 +1,119 @@
+#include "testCommon.h"
+#include "modulator.h"
+#include "parallel.h"
+#include "pulseShaper.h"
+
+namespace
+{
+    /// @brief The symbols of the messages, 600000 samples at TEST_CARRIER_FREQUENCY or 9 times PARALLEL_MIN_SAMPLES
+    constexpr size_t TEST_SYMBOL_COUNT = 1200;
+
+    /// @brief The carrier frequency of the check, 500 samples per carrier cycle
+    constexpr double TEST_CARRIER_FREQUENCY = 10;
+
+    /// @brief The standard deviation of the noise added before the demodulation, so some decisions are close
+    constexpr double TEST_NOISE_SIGMA = 2.0;
+
+    /**
+     * @brief Modulate and demodulate on one thread and on several, the results must not depend on the split
+     *
+     * @tparam T - the sample type
+     * @param p_report - the report of the check
+     * @param p_scheme - the scheme
+     * @param p_typeName - the name of the sample type
+     * @param p_threadCount - the amount of threads compared with one
+     * @param p_tolerance - the largest difference between a sample modulated on one thread and on several
+     */
+    template <typename T>
+    void checkThreads(TestReport &p_report, const ModulationScheme p_scheme, const char *p_typeName, const unsigned int p_threadCount,
+                      const double p_tolerance = 0)
+    {
+        BitBuffer message = generateTestMessage(TEST_SYMBOL_COUNT * getSchemeBitsPerSymbol(p_scheme),
+                                                static_cast<unsigned int>(p_scheme));
+        setTestValue(THREAD_COUNT_KEY, "u32", "1");
+        Modulator serial;
+        serial.setFrequency(TEST_CARRIER_FREQUENCY);
+        serial.setNoisy(false);
+        serial.setBinaryInput(message);
+        setTestValue(THREAD_COUNT_KEY, "u32", std::to_string(p_threadCount));
+        Modulator parallel;
+        parallel.setFrequency(TEST_CARRIER_FREQUENCY);
+        parallel.setNoisy(false);
+        parallel.setBinaryInput(message);
+
+        std::string name = stringify(getSchemeName(p_scheme), " ", p_typeName, " on ", p_threadCount, " threads");
+        std::vector<T> signal = serial.modulate<T>(p_scheme);
+        ModulationSession session = parallel.startModulation(p_scheme);
+        p_report.expect(splitSymbolRanges(session.getSymbolCount(), session.getSamplesPerSymbol(), p_threadCount).size() == p_threadCount,
+                        stringify(name, ": the ", signal.size(), " samples are not split over every thread"));
+        std::vector<T> parallelSignal = parallel.modulate<T>(p_scheme);
+        double difference = (parallelSignal.size() == signal.size()) ? 0 : HUGE_VAL;
+        for (size_t sampleIdx = 0; sampleIdx < std::min(signal.size(), parallelSignal.size()); ++sampleIdx)
+        {
+            difference = std::max(difference, std::abs(SampleTraits<T>::toDouble(parallelSignal[sampleIdx]) -
+                                                        SampleTraits<T>::toDouble(signal[sampleIdx])));
+        }
+        p_report.expect(difference <= p_tolerance, stringify(name, ": the modulated signal differs from one thread by ", difference));
+
+        addTestNoise(signal, TEST_NOISE_SIGMA, p_threadCount);
+        BitBuffer expected = serial.demodulate(signal, p_scheme);
+        BitBuffer received = parallel.demodulate(signal, p_scheme);
+        p_report.expect(received.size() == expected.size() && expected.countErrors(received, 0) == 0,
+                        stringify(name, ": ", expected.countErrors(received, 0), " decisions differ from one thread"));
+    }
+
+    /**
+     * @brief Check the noise of the symbol ranges of a noisy session: a range is reproduced by every copy of the
+     * session seeked to its first symbol, and ranges starting at different symbols do not share their noise
+     *
+     * @param p_report - the report of the check
+     * @param p_scheme - the scheme
+     */
+    void checkRangeNoise(TestReport &p_report, const ModulationScheme p_scheme)
+    {
+        Modulator modulator;
+        modulator.setFrequency(TEST_CARRIER_FREQUENCY);
+        modulator.setBinaryInput(generateTestMessage(TEST_SYMBOL_COUNT * getSchemeBitsPerSymbol(p_scheme), 0));
+        ModulationSession session = modulator.startModulation(p_scheme);
+        const size_t samplesPerSymbol = session.getSamplesPerSymbol();
+        const size_t firstSymbol = TEST_SYMBOL_COUNT / 2;
+        std::vector<std::vector<double>> ranges;
+        for (size_t symbolIdx : {firstSymbol, firstSymbol, firstSymbol + 1})
+        {
+            ModulationSession range = session;
+            range.seek(symbolIdx);
+            ranges.emplace_back(2 * samplesPerSymbol);
+            range.produce(ranges.back().data(), ranges.back().size());
+        }
+        const char *name = getSchemeName(p_scheme);
+        p_report.expect(ranges[0] == ranges[1], stringify(name, ": two copies seeked to one symbol produce different noise"));
+        // Both ranges cover the second symbol, only their noise tells them apart
+        p_report.expect(!std::equal(ranges[0].begin() + samplesPerSymbol, ranges[0].end(), ranges[2].begin()),
+                        stringify(name, ": ranges starting at neighbouring symbols produce the same noise"));
+    }
+}
+
+int main()
+{
+    initTestDatabase();
+    TestReport report;
+    for (ModulationScheme scheme : {ModulationScheme::ASK, ModulationScheme::PSK, ModulationScheme::FSK, ModulationScheme::QAM16,
+                                    ModulationScheme::QPSK, ModulationScheme::PSK8, ModulationScheme::QAM64, ModulationScheme::FSK8})
+    {
+        for (unsigned int threadCount : {2u, 3u, 7u})
+        {
+            checkThreads<double>(report, scheme, "double", threadCount);
+            checkThreads<float>(report, scheme, "float", threadCount);
+            checkThreads<int16_t>(report, scheme, "int16", threadCount);
+        }
+    }
+
+    checkRangeNoise(report, ModulationScheme::QPSK);
+    checkRangeNoise(report, ModulationScheme::FSK);
+
+    // Shaped symbols are produced from the points around them, the ranges share their edges. A range starts its
+    // carrier from the phase accumulator where one thread rotates it, so the samples only agree to rounding
+    setTestValue(PULSE_SHAPE_KEY, "char", "rrc");
+    checkThreads<double>(report, ModulationScheme::QPSK, "double, RRC pulses", 3, 1e-12);
+    return report.finish();
+}
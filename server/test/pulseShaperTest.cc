@@ -0,0 +1,151 @@
+#include "testCommon.h"
+#include "modulator.h"
+#include "pulseShaper.h"
+#include <random>
+
+namespace
+{
+    /// @brief The amount of symbols of the shaped messages
+    constexpr size_t TEST_SYMBOL_COUNT = 64;
+
+    /// @brief The bits of the modulated messages
+    constexpr size_t TEST_MESSAGE_BITS = 480;
+
+    /// @brief The largest difference between the polyphase interpolator and the convolution
+    constexpr double SHAPE_TOLERANCE = 1e-12;
+
+    /// @brief The largest difference between a matched point and the sent one, the ISI of the pulse truncated to its
+    /// span, well inside half the unit spacing of the points
+    constexpr double MATCH_TOLERANCE = 0.15;
+
+    /**
+     * @brief Shape a message by convolving the impulse train with the taps, the tails wrapping around the message
+     *
+     * @param p_filter - the pulse filter
+     * @param p_points - one complex point per symbol
+     *
+     * @return samplesPerSymbol complex samples per symbol
+     */
+    std::vector<std::complex<double>> convolve(const PulseFilter &p_filter, const std::vector<std::complex<double>> &p_points)
+    {
+        const size_t total = p_points.size() * p_filter.samplesPerSymbol;
+        const size_t lead = (p_filter.span / 2) * p_filter.samplesPerSymbol;
+        std::vector<std::complex<double>> signal(total);
+        for (size_t sampleIdx = 0; sampleIdx < total; ++sampleIdx)
+        {
+            for (size_t symbolIdx = 0; symbolIdx < p_points.size(); ++symbolIdx)
+            {
+                size_t tapIdx = (sampleIdx + lead + total - symbolIdx * p_filter.samplesPerSymbol) % total;
+                if (tapIdx < p_filter.taps.size())
+                {
+                    signal[sampleIdx] += p_points[symbolIdx] * p_filter.taps[tapIdx];
+                }
+            }
+        }
+        return signal;
+    }
+
+    /**
+     * @brief Generate random points on a 7 x 7 grid of unit spacing
+     *
+     * @param p_seed - the seed of the generator
+     *
+     * @return TEST_SYMBOL_COUNT points
+     */
+    std::vector<std::complex<double>> generatePoints(const unsigned int p_seed)
+    {
+        std::default_random_engine generator(p_seed);
+        std::uniform_int_distribution<int> level(-3, 3);
+        std::vector<std::complex<double>> points(TEST_SYMBOL_COUNT);
+        for (std::complex<double> &point : points)
+        {
+            point = {static_cast<double>(level(generator)), static_cast<double>(level(generator))};
+        }
+        return points;
+    }
+
+    /**
+     * @brief Compare the polyphase interpolator with the convolution
+     *
+     * @param p_report - the report of the check
+     * @param p_parameters - the pulse
+     * @param p_samplesPerSymbol - the oversampling
+     */
+    void checkInterpolator(TestReport &p_report, const PulseShapingParameters &p_parameters, const unsigned int p_samplesPerSymbol)
+    {
+        std::vector<std::complex<double>> points = generatePoints(p_samplesPerSymbol);
+        std::shared_ptr<const PulseFilter> filter = PulseFilterCache::getInstance().getFilter(p_parameters, p_samplesPerSymbol);
+        std::vector<std::complex<double>> signal = PulseShaper(filter).shape(points);
+        std::vector<std::complex<double>> expected = convolve(*filter, points);
+        double error = 0;
+        for (size_t sampleIdx = 0; sampleIdx < std::min(signal.size(), expected.size()); ++sampleIdx)
+        {
+            error = std::max(error, std::abs(signal[sampleIdx] - expected[sampleIdx]));
+        }
+        p_report.expect(signal.size() == expected.size() && error < SHAPE_TOLERANCE,
+                        stringify("shape ", static_cast<int>(p_parameters.shape), " at ", p_samplesPerSymbol,
+                                  " samples per symbol: interpolator differs from the convolution by ", error));
+    }
+
+    /**
+     * @brief Check the root raised cosine matched filter returns the shaped points
+     *
+     * @param p_report - the report of the check
+     * @param p_samplesPerSymbol - the oversampling
+     */
+    void checkMatchedFilter(TestReport &p_report, const unsigned int p_samplesPerSymbol)
+    {
+        std::vector<std::complex<double>> points = generatePoints(p_samplesPerSymbol);
+        PulseShaper shaper(PulseFilterCache::getInstance().getFilter(
+            {PulseShape::ROOT_RAISED_COSINE, DEFAULT_PULSE_ROLLOFF, DEFAULT_PULSE_SPAN}, p_samplesPerSymbol));
+        std::vector<std::complex<double>> received = shaper.match(shaper.shape(points));
+        double error = 0;
+        for (size_t symbolIdx = 0; symbolIdx < std::min(received.size(), points.size()); ++symbolIdx)
+        {
+            error = std::max(error, std::abs(received[symbolIdx] - points[symbolIdx]));
+        }
+        p_report.expect(received.size() == points.size() && error < MATCH_TOLERANCE,
+                        stringify("matched filter at ", p_samplesPerSymbol, " samples per symbol differs from the points by ", error));
+    }
+
+    /**
+     * @brief Modulate and demodulate a noiseless message with the pulse shape set in the database
+     *
+     * @param p_report - the report of the check
+     * @param p_shape - the shape name of the database
+     * @param p_scheme - the scheme
+     */
+    void checkRoundTrip(TestReport &p_report, const std::string &p_shape, const ModulationScheme p_scheme)
+    {
+        setTestValue(PULSE_SHAPE_KEY, "char", p_shape);
+        Modulator modulator;
+        modulator.setFrequency(3);
+        modulator.setNoisy(false);
+        BitBuffer message = generateTestMessage(TEST_MESSAGE_BITS, static_cast<unsigned int>(p_scheme));
+        modulator.setBinaryInput(message);
+        BitBuffer received = modulator.demodulate(modulator.modulate<double>(p_scheme), p_scheme);
+        size_t errors = message.countErrors(received, 0);
+        p_report.expect(received.size() == message.size() && errors == 0,
+                        stringify(p_shape.c_str(), " ", getSchemeName(p_scheme), ": ", errors, " bit errors"));
+    }
+}
+
+int main()
+{
+    initTestDatabase();
+    TestReport report;
+    for (unsigned int samplesPerSymbol : {4u, 8u, 50u})
+    {
+        checkInterpolator(report, {PulseShape::ROOT_RAISED_COSINE, DEFAULT_PULSE_ROLLOFF, DEFAULT_PULSE_SPAN}, samplesPerSymbol);
+        checkInterpolator(report, {PulseShape::GAUSSIAN, DEFAULT_PULSE_BANDWIDTH_TIME, DEFAULT_PULSE_SPAN}, samplesPerSymbol);
+        checkMatchedFilter(report, samplesPerSymbol);
+    }
+    for (const std::string shape : {"rrc", "gaussian"})
+    {
+        for (ModulationScheme scheme : {ModulationScheme::PSK, ModulationScheme::QPSK, ModulationScheme::PSK8, ModulationScheme::QAM16})
+        {
+            checkRoundTrip(report, shape, scheme);
+        }
+    }
+    return report.finish();
+}
@@ -0,0 +1,135 @@
+#include "testCommon.h"
+#include "modulator.h"
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    /// @brief The recorded signal, relative to the server directory
+    constexpr const char *RECORDED_INPUT_FILE = "sample/input.txt";
+
+    /// @brief The bits the scalar receiver decoded from the recorded signal, relative to the server directory
+    constexpr const char *EXPECTED_BITS_FILE = "test/data/inputBits.txt";
+
+    /// @brief The carrier of the recorded signal, 500 samples per cycle at the default /fs
+    constexpr double RECORDED_CARRIER_FREQUENCY = 10;
+
+    /// @brief The bits decoded from the recorded signal starting at one sample
+    struct ExpectedBits
+    {
+        /// @brief The name of the scheme, as given by getSchemeName
+        std::string scheme;
+
+        /// @brief The first sample of the recorded signal that is decoded
+        size_t firstSample;
+
+        /// @brief The decoded bits
+        std::string bits;
+    };
+
+    /**
+     * @brief Read the expected bits, '#' lines are comments
+     *
+     * @param p_path - the path of the file
+     *
+     * @return one entry per scheme and first sample, empty when the file cannot be read
+     */
+    std::vector<ExpectedBits> readExpectedBits(const std::string &p_path)
+    {
+        std::vector<ExpectedBits> entries;
+        std::ifstream file(p_path);
+        std::string line;
+        while (std::getline(file, line))
+        {
+            ExpectedBits entry;
+            std::istringstream fields(line);
+            if (!line.empty() && line[0] != '#' && fields >> entry.scheme >> entry.firstSample >> entry.bits)
+            {
+                entries.push_back(entry);
+            }
+        }
+        return entries;
+    }
+
+    /**
+     * @brief Convert the recorded signal to a sample type
+     *
+     * @tparam T - the sample type
+     * @param p_signal - the recorded signal
+     *
+     * @return the converted signal
+     */
+    template <typename T>
+    std::vector<T> convertSignal(const std::vector<double> &p_signal)
+    {
+        std::vector<T> signal(p_signal.size());
+        for (size_t sampleIdx = 0; sampleIdx < p_signal.size(); ++sampleIdx)
+        {
+            signal[sampleIdx] = SampleTraits<T>::fromDouble(p_signal[sampleIdx]);
+        }
+        return signal;
+    }
+
+    /**
+     * @brief Decode the recorded signal in one sample path and compare with the expected bits
+     *
+     * @tparam T - the sample type
+     * @param p_report - the report of the check
+     * @param p_signal - the recorded signal from the first sample of the entry
+     * @param p_scheme - the scheme
+     * @param p_expected - the expected bits
+     * @param p_arithmetic - the arithmetic of the int16 sample path
+     * @param p_name - the name of the sample path
+     */
+    template <typename T>
+    void checkDecoding(TestReport &p_report, const std::vector<double> &p_signal, const ModulationScheme p_scheme,
+                       const ExpectedBits &p_expected, const Arithmetic p_arithmetic, const char *p_name)
+    {
+        Modulator modulator;
+        modulator.setFrequency(RECORDED_CARRIER_FREQUENCY);
+        modulator.setArithmetic(p_arithmetic);
+        std::string received = modulator.demodulate(convertSignal<T>(p_signal), p_scheme).toString();
+        p_report.expect(received == p_expected.bits, stringify(p_expected.scheme.c_str(), " from sample ", p_expected.firstSample,
+                                                               " in ", p_name, ": decoded ", received.c_str(), " instead of ",
+                                                               p_expected.bits.c_str()));
+    }
+}
+
+int main()
+{
+    initTestDatabase();
+    TestReport report;
+    std::vector<double> recorded;
+    std::ifstream file(getTestSourcePath(RECORDED_INPUT_FILE));
+    double sample;
+    while (file >> sample)
+    {
+        recorded.push_back(sample);
+    }
+    std::vector<ExpectedBits> entries = readExpectedBits(getTestSourcePath(EXPECTED_BITS_FILE));
+    report.expect(!recorded.empty() && !entries.empty(), "the recorded signal or the expected bits cannot be read");
+
+    std::vector<ModulationScheme> schemes = {ModulationScheme::ASK,   ModulationScheme::PSK,   ModulationScheme::FSK,
+                                             ModulationScheme::QAM16, ModulationScheme::QPSK,  ModulationScheme::PSK8,
+                                             ModulationScheme::QAM64, ModulationScheme::QAM256, ModulationScheme::FSK4,
+                                             ModulationScheme::FSK8,  ModulationScheme::GMSK};
+    for (ModulationScheme scheme : schemes)
+    {
+        bool isCovered = false;
+        for (const ExpectedBits &entry : entries)
+        {
+            if (entry.scheme != getSchemeName(scheme) || entry.firstSample >= recorded.size())
+            {
+                continue;
+            }
+            isCovered = true;
+            std::vector<double> signal(recorded.begin() + entry.firstSample, recorded.end());
+            checkDecoding<double>(report, signal, scheme, entry, Arithmetic::FLOATING_POINT, "double");
+            checkDecoding<float>(report, signal, scheme, entry, Arithmetic::FLOATING_POINT, "float");
+            checkDecoding<int16_t>(report, signal, scheme, entry, Arithmetic::FLOATING_POINT, "int16");
+            checkDecoding<int16_t>(report, signal, scheme, entry, Arithmetic::FIXED_POINT, "fixed-point int16");
+        }
+        report.expect(isCovered, stringify(getSchemeName(scheme), " has no expected bits"));
+    }
+    return report.finish();
+}
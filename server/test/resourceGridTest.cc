@@ -0,0 +1,99 @@
+#include "testCommon.h"
+#include "modulator.h"
+#include "ofdm.h"
+#include "resourceGrid.h"
+
+namespace
+{
+    /// @brief The amount of subcarriers of the slots, four resource element groups
+    constexpr unsigned int TEST_SUBCARRIERS = 48;
+
+    /// @brief The payload lengths of the clients in constellation points: below, on and across group and symbol bounds
+    const std::vector<size_t> TEST_PAYLOAD_POINTS = {5, 12, 30, 100, 1, 47};
+
+    /**
+     * @brief Fill a slot with the test payloads and check the allocations
+     *
+     * @param p_report - the report of the check
+     * @param p_grid - the empty slot
+     * @param p_payloads - the payloads mapped, in allocation order
+     */
+    void fillGrid(TestReport &p_report, ResourceGrid &p_grid, std::vector<BitBuffer> &p_payloads)
+    {
+        for (size_t clientIdx = 0; clientIdx < TEST_PAYLOAD_POINTS.size(); ++clientIdx)
+        {
+            BitBuffer payload = generateTestMessage(TEST_PAYLOAD_POINTS[clientIdx] * p_grid.getBitsPerPoint(), clientIdx);
+            p_report.expect(p_grid.allocate(static_cast<int>(clientIdx), payload), stringify("client ", clientIdx, " is not mapped"));
+            p_payloads.push_back(payload);
+        }
+        const std::vector<GridAllocation> &allocations = p_grid.getAllocations();
+        p_report.expect(allocations.size() == p_payloads.size(), "an allocation is missing");
+        size_t nextElement = 0;
+        for (const GridAllocation &allocation : allocations)
+        {
+            p_report.expect(allocation.firstElement % RESOURCE_ELEMENT_GROUP_SIZE == 0 && allocation.firstElement >= nextElement,
+                            stringify("client ", allocation.owner, " starts at element ", allocation.firstElement));
+            for (size_t elementIdx = nextElement; elementIdx < allocation.firstElement; ++elementIdx)
+            {
+                p_report.expect(p_grid.getElements()[elementIdx] == NULL_RESOURCE_ELEMENT,
+                                stringify("element ", elementIdx, " between two clients is not null"));
+            }
+            nextElement = allocation.firstElement + allocation.pointCount;
+        }
+        p_report.expect(p_grid.getElements().size() % TEST_SUBCARRIERS == 0 && p_grid.getElements().size() >= nextElement,
+                        "the slot is not a whole number of OFDM symbols");
+
+        // A payload larger than the rest of the slot is refused and leaves the slot as it is
+        size_t elementCount = p_grid.getElements().size();
+        BitBuffer oversized = generateTestMessage(p_grid.getCapacity() * p_grid.getBitsPerPoint(), 0);
+        p_report.expect(!p_grid.allocate(-1, oversized) && p_grid.getAllocations().size() == p_payloads.size() &&
+                            p_grid.getElements().size() == elementCount,
+                        "an oversized payload changed the slot");
+    }
+
+    /**
+     * @brief Modulate a slot in one sample type and check every client gets its payload back
+     *
+     * @tparam T - the sample type
+     * @param p_report - the report of the check
+     * @param p_scheme - the QAM scheme
+     * @param p_typeName - the name of the sample type
+     */
+    template <typename T>
+    void checkGrid(TestReport &p_report, const ModulationScheme p_scheme, const char *p_typeName)
+    {
+        Modulator modulator;
+        modulator.setFrequency(5);
+        ResourceGrid grid(modulator.getOfdmSubcarriers(), getSchemeBitsPerSymbol(p_scheme));
+        std::vector<BitBuffer> payloads;
+        fillGrid(p_report, grid, payloads);
+
+        ModulationSession session = modulator.startGridModulation(grid, p_scheme);
+        std::vector<T> signal(session.getTotalSamples());
+        signal.resize(session.produce(signal.data(), signal.size()));
+        std::vector<BitBuffer> received = modulator.demodulateGrid(signal, grid, p_scheme);
+        p_report.expect(received.size() == payloads.size(), stringify(getSchemeName(p_scheme), " ", p_typeName, ": ",
+                                                                      received.size(), " payloads received"));
+        for (size_t clientIdx = 0; clientIdx < std::min(received.size(), payloads.size()); ++clientIdx)
+        {
+            p_report.expect(received[clientIdx].size() == payloads[clientIdx].size() &&
+                                payloads[clientIdx].countErrors(received[clientIdx], 0) == 0,
+                            stringify(getSchemeName(p_scheme), " ", p_typeName, ": client ", clientIdx, " received ",
+                                      payloads[clientIdx].countErrors(received[clientIdx], 0), " bit errors"));
+        }
+    }
+}
+
+int main()
+{
+    initTestDatabase();
+    setTestValue(OFDM_SUBCARRIERS_KEY, "u32", std::to_string(TEST_SUBCARRIERS));
+    TestReport report;
+    for (ModulationScheme scheme : {ModulationScheme::QAM16, ModulationScheme::QAM64, ModulationScheme::QAM256})
+    {
+        checkGrid<double>(report, scheme, "double");
+        checkGrid<float>(report, scheme, "float");
+        checkGrid<int16_t>(report, scheme, "int16");
+    }
+    return report.finish();
+}
@@ -0,0 +1,104 @@
+#include "testCommon.h"
+#include "modulator.h"
+
+namespace
+{
+    /// @brief The bits of the messages, whole symbols of every scheme
+    constexpr size_t TEST_MESSAGE_BITS = 480;
+
+    /// @brief The symbol schemes sent and received through the cached templates
+    const std::vector<ModulationScheme> TEST_SCHEMES = {ModulationScheme::ASK,   ModulationScheme::PSK,   ModulationScheme::FSK,
+                                                         ModulationScheme::QAM16, ModulationScheme::QPSK,  ModulationScheme::PSK8,
+                                                         ModulationScheme::QAM64, ModulationScheme::QAM256, ModulationScheme::FSK4,
+                                                         ModulationScheme::FSK8};
+
+    /**
+     * @brief Modulate a message without noise and check that it is demodulated without error
+     *
+     * @tparam T - the sample type
+     * @param p_report - the report of the check
+     * @param p_scheme - the scheme
+     * @param p_frequency - the carrier frequency
+     * @param p_arithmetic - the arithmetic of the int16 sample path
+     * @param p_name - the name of the sample path
+     */
+    template <typename T>
+    void checkRoundTrip(TestReport &p_report, const ModulationScheme p_scheme, const double p_frequency,
+                        const Arithmetic p_arithmetic, const char *p_name)
+    {
+        Modulator modulator;
+        modulator.setFrequency(p_frequency);
+        modulator.setNoisy(false);
+        modulator.setArithmetic(p_arithmetic);
+        BitBuffer message = generateTestMessage(TEST_MESSAGE_BITS, static_cast<unsigned int>(p_scheme));
+        modulator.setBinaryInput(message);
+        BitBuffer received = modulator.demodulate(modulator.modulate<T>(p_scheme), p_scheme);
+        p_report.expect(received.size() == message.size() && message.countErrors(received, 0) == 0,
+                        stringify(getSchemeName(p_scheme), " at ", p_frequency, " Hz in ", p_name, ": ",
+                                  message.countErrors(received, 0), " bit errors of ", received.size(), " bits"));
+    }
+
+    /**
+     * @brief Check that a second modulator reuses the templates built by a first one and gets the same results
+     *
+     * @param p_report - the report of the check
+     * @param p_scheme - the scheme
+     * @param p_frequency - the carrier frequency
+     */
+    void checkSharedTemplates(TestReport &p_report, const ModulationScheme p_scheme, const double p_frequency)
+    {
+        std::string name = stringify(getSchemeName(p_scheme), " at ", p_frequency, " Hz");
+        BitBuffer message = generateTestMessage(TEST_MESSAGE_BITS, static_cast<unsigned int>(p_scheme));
+        Modulator first;
+        first.setFrequency(p_frequency);
+        first.setNoisy(false);
+        first.setBinaryInput(message);
+        Modulator second;
+        second.setFrequency(p_frequency);
+        second.setNoisy(false);
+        second.setBinaryInput(message);
+
+        WaveformCache &cache = WaveformCache::getInstance();
+        const size_t emptySize = cache.size();
+        std::vector<double> signal = first.modulate(p_scheme);
+        BitBuffer received = first.demodulate(signal, p_scheme);
+        const size_t builtSize = cache.size();
+        p_report.expect(builtSize == emptySize + 1,
+                        stringify(name, ": the modulator and the demodulator built ", builtSize - emptySize, " templates"));
+
+        std::vector<double> sharedSignal = second.modulate(p_scheme);
+        BitBuffer sharedReceived = second.demodulate(sharedSignal, p_scheme);
+        p_report.expect(cache.size() == builtSize, stringify(name, ": a second modulator built its own templates"));
+        p_report.expect(sharedSignal == signal && sharedReceived == received,
+                        stringify(name, ": a second modulator differs from the first one"));
+    }
+}
+
+int main()
+{
+    initTestDatabase();
+    TestReport report;
+
+    // 7.3 Hz leaves a fraction of a carrier cycle per symbol, so symbols are stitched from the tone basis at a phase
+    for (double frequency : {3.0, 7.3})
+    {
+        for (ModulationScheme scheme : TEST_SCHEMES)
+        {
+            checkRoundTrip<double>(report, scheme, frequency, Arithmetic::FLOATING_POINT, "double");
+            checkRoundTrip<float>(report, scheme, frequency, Arithmetic::FLOATING_POINT, "float");
+            checkRoundTrip<int16_t>(report, scheme, frequency, Arithmetic::FLOATING_POINT, "int16");
+            checkRoundTrip<int16_t>(report, scheme, frequency, Arithmetic::FIXED_POINT, "fixed-point int16");
+        }
+    }
+
+    // The templates are keyed by scheme, carrier and sample rate, the cache is shared by every request
+    WaveformCache::getInstance().invalidate();
+    for (double frequency : {3.0, 7.3})
+    {
+        for (ModulationScheme scheme : TEST_SCHEMES)
+        {
+            checkSharedTemplates(report, scheme, frequency);
+        }
+    }
+    return report.finish();
+}
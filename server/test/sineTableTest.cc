@@ -0,0 +1,110 @@
+#include "testCommon.h"
+#include "oscillator.h"
+#include "sineTable.h"
+
+namespace
+{
+    /// @brief The amount of random phases compared on top of the sweep
+    constexpr size_t RANDOM_PHASE_COUNT = 1 << 20;
+
+    /// @brief The fractions of a table interval swept in every interval, in 1/8
+    constexpr unsigned int FRACTION_STEPS = 8;
+
+    /// @brief The amount of samples of the table-mode oscillators
+    constexpr unsigned int OSCILLATOR_SAMPLE_COUNT = 1 << 20;
+
+    /// @brief The worst errors seen by a check
+    struct LookupErrors
+    {
+        /// @brief The largest error on the cosine
+        double cosine;
+
+        /// @brief The largest error on the sine
+        double sine;
+    };
+
+    /**
+     * @brief Compare one table phasor with libm
+     *
+     * @param p_phase - the phase, one full cycle equals 2^64
+     * @param p_errors - the worst errors, updated
+     */
+    void comparePhasor(const uint64_t p_phase, LookupErrors &p_errors)
+    {
+        const double angle = 2 * M_PI * (static_cast<double>(p_phase) * 0x1p-64);
+        std::complex<double> phasor = lookupPhasor(p_phase);
+        p_errors.cosine = std::max(p_errors.cosine, std::abs(phasor.real() - std::cos(angle)));
+        p_errors.sine = std::max(p_errors.sine, std::abs(phasor.imag() - std::sin(angle)));
+    }
+
+    /**
+     * @brief Check the worst errors of a set of phases
+     *
+     * @param p_report - the report of the check
+     * @param p_errors - the worst errors
+     * @param p_name - what was swept
+     */
+    void expectWithinBound(TestReport &p_report, const LookupErrors &p_errors, const char *p_name)
+    {
+        std::cout << p_name << ": cosine error " << p_errors.cosine << ", sine error " << p_errors.sine << std::endl;
+        p_report.expect(p_errors.cosine <= SINE_TABLE_MAX_ERROR && p_errors.sine <= SINE_TABLE_MAX_ERROR,
+                        stringify(p_name, ": the table is off by ", std::max(p_errors.cosine, p_errors.sine)));
+    }
+}
+
+int main()
+{
+    TestReport report;
+
+    // Every interval of every quadrant at several fractions: the sine is read forwards and the cosine backwards
+    // from the same interval, the fraction bits are the ones below the index
+    const unsigned int indexShift = 62 - SINE_TABLE_BITS;
+    LookupErrors sweepErrors = {0, 0};
+    for (uint64_t quadrant = 0; quadrant < 4; ++quadrant)
+    {
+        for (uint64_t index = 0; index < SINE_TABLE_SIZE; ++index)
+        {
+            const uint64_t intervalStart = (quadrant << 62) | (index << indexShift);
+            for (unsigned int step = 0; step < FRACTION_STEPS; ++step)
+            {
+                comparePhasor(intervalStart + ((static_cast<uint64_t>(step) << indexShift) / FRACTION_STEPS), sweepErrors);
+            }
+            comparePhasor(intervalStart + ((static_cast<uint64_t>(1) << indexShift) - 1), sweepErrors);
+        }
+    }
+    expectWithinBound(report, sweepErrors, "interval sweep");
+
+    // The table points themselves and both sides of every quadrant boundary
+    LookupErrors boundaryErrors = {0, 0};
+    for (uint64_t quadrant = 0; quadrant < 4; ++quadrant)
+    {
+        comparePhasor(quadrant << 62, boundaryErrors);
+        comparePhasor((quadrant << 62) - 1, boundaryErrors);
+        comparePhasor((quadrant << 62) + 1, boundaryErrors);
+    }
+    expectWithinBound(report, boundaryErrors, "quadrant boundaries");
+
+    std::default_random_engine generator(1);
+    std::uniform_int_distribution<uint64_t> phase;
+    LookupErrors randomErrors = {0, 0};
+    for (size_t phaseIdx = 0; phaseIdx < RANDOM_PHASE_COUNT; ++phaseIdx)
+    {
+        comparePhasor(phase(generator), randomErrors);
+    }
+    expectWithinBound(report, randomErrors, "random phases");
+
+    // A table-mode oscillator re-anchors on the table, the rotations between anchors add rounding only
+    for (double frequency : {3.0, 7.3, 80.0})
+    {
+        Oscillator oscillator(frequency, 5000, -M_PI / 2);
+        oscillator.setTrigMode(TrigMode::TABLE);
+        double error = 0;
+        for (unsigned int sampleIdx = 0; sampleIdx < OSCILLATOR_SAMPLE_COUNT; ++sampleIdx)
+        {
+            error = std::max(error, std::abs(oscillator.value() - std::polar(1.0, oscillator.getPhase())));
+            oscillator.next();
+        }
+        report.expect(error <= 2 * SINE_TABLE_MAX_ERROR, stringify(frequency, " Hz table oscillator is off by ", error));
+    }
+    return report.finish();
+}
@@ -0,0 +1,112 @@
+#include "testCommon.h"
+#include "modulator.h"
+#include "ofdm.h"
+#include "pulseShaper.h"
+
+namespace
+{
+    /// @brief The bits of the messages, whole symbols of every scheme
+    constexpr size_t TEST_MESSAGE_BITS = 480;
+
+    /// @brief The carrier frequency of the check, not a divisor of /fs so symbols start at any carrier phase
+    constexpr double TEST_CARRIER_FREQUENCY = 7;
+
+    /// @brief The standard deviation of the noise added to the signal, so some decisions are close
+    constexpr double TEST_NOISE_SIGMA = 1.0;
+
+    /// @brief The samples cut from the end of the signal, so the last symbol is received in part
+    constexpr size_t TEST_RAGGED_TAIL = 37;
+
+    /// @brief The largest chunks of the passes in samples: far below, around and over the 714 samples of one symbol
+    const std::vector<size_t> TEST_MAX_CHUNKS = {16, 1000, 3000};
+
+    /**
+     * @brief Receive a signal in random chunks and compare the bits with the signal demodulated at once
+     *
+     * @tparam T - the sample type
+     * @param p_report - the report of the check
+     * @param p_scheme - the scheme
+     * @param p_name - the name of the case
+     * @param p_maxChunk - the largest chunk in samples
+     */
+    template <typename T>
+    void checkChunks(TestReport &p_report, const ModulationScheme p_scheme, const std::string &p_name, const size_t p_maxChunk)
+    {
+        Modulator modulator;
+        modulator.setFrequency(TEST_CARRIER_FREQUENCY);
+        modulator.setNoisy(false);
+        modulator.setBinaryInput(generateTestMessage(TEST_MESSAGE_BITS, static_cast<unsigned int>(p_scheme)));
+        std::vector<T> signal = modulator.modulate<T>(p_scheme);
+        signal.resize(signal.size() - TEST_RAGGED_TAIL);
+        addTestNoise(signal, TEST_NOISE_SIGMA, static_cast<unsigned int>(p_scheme));
+        BitBuffer expected = modulator.demodulate(signal, p_scheme);
+
+        DemodulationStream<T> stream = modulator.startDemodulation<T>(p_scheme);
+        std::default_random_engine generator(p_maxChunk);
+        std::uniform_int_distribution<size_t> chunkSize(0, p_maxChunk);
+        BitBuffer received;
+        size_t maxPending = 0;
+        for (size_t position = 0; position < signal.size();)
+        {
+            const size_t count = std::min(chunkSize(generator), signal.size() - position);
+            received.append(modulator.demodulateChunk(stream, signal.data() + position, count));
+            position += count;
+            maxPending = std::max(maxPending, stream.pending.size());
+        }
+        received.append(modulator.finishDemodulation(stream));
+
+        std::string name = stringify(p_name.c_str(), " in chunks of up to ", p_maxChunk, " samples");
+        p_report.expect(received.size() == expected.size() && expected.countErrors(received, 0) == 0,
+                        stringify(name, ": ", expected.countErrors(received, 0), " of ", expected.size(),
+                                  " bits differ from the whole signal, ", received.size(), " received"));
+        p_report.expect(!stream.isSymbolBySymbol || maxPending < stream.samplesPerSymbol,
+                        stringify(name, ": ", maxPending, " pending samples for symbols of ", stream.samplesPerSymbol));
+    }
+
+    /**
+     * @brief Receive a scheme in random chunks in every sample type
+     *
+     * @param p_report - the report of the check
+     * @param p_scheme - the scheme
+     * @param p_name - the name of the case
+     */
+    void checkScheme(TestReport &p_report, const ModulationScheme p_scheme, const std::string &p_name)
+    {
+        for (size_t maxChunk : TEST_MAX_CHUNKS)
+        {
+            checkChunks<double>(p_report, p_scheme, p_name + " in double", maxChunk);
+            checkChunks<float>(p_report, p_scheme, p_name + " in float", maxChunk);
+            checkChunks<int16_t>(p_report, p_scheme, p_name + " in int16", maxChunk);
+        }
+    }
+}
+
+int main()
+{
+    initTestDatabase();
+    TestReport report;
+
+    // Every scheme a carrier network can be configured with
+    const std::vector<std::pair<std::string, std::vector<unsigned long>>> networks = {
+        {"3G", {2, 4, 8}}, {"4G", {2, 4, 8}}, {"5G", {16, 64, 256}}};
+    for (const char *modulation : {"ask", "gmsk"})
+    {
+        checkScheme(report, getNetworkScheme("2G", 0, modulation), stringify("2G ", modulation));
+    }
+    for (const auto &network : networks)
+    {
+        for (unsigned long order : network.second)
+        {
+            ModulationScheme scheme = getNetworkScheme(network.first, order);
+            checkScheme(report, scheme, stringify(network.first.c_str(), " ", getSchemeName(scheme)));
+        }
+    }
+
+    // Shaped pulses and OFDM symbols are decided once the stream is finished
+    setTestValue(PULSE_SHAPE_KEY, "char", "rrc");
+    checkScheme(report, ModulationScheme::QPSK, "3G QPSK, RRC pulses");
+    setTestValue(PULSE_SHAPE_KEY, "char", "rectangular");
+    setTestValue(OFDM_SUBCARRIERS_KEY, "u32", "64");
+    checkScheme(report, ModulationScheme::QAM16, "5G OFDM 16-QAM");
+    return report.finish();
+}
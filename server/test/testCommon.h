@@ -0,0 +1,213 @@
+#pragma once
+#include "serverCommon.h"
+#include "bitBuffer.h"
+#include "modulationScheme.h"
+#include "sampleTraits.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/// @brief The environment variable holding the database directory, exported by make check
+constexpr const char *TEST_DATABASE_PATH_VARIABLE = "SERVER_DB_PATH";
+
+/// @brief The database directory when the variable is not set, a check is then run from the server directory
+constexpr const char *TEST_DEFAULT_DATABASE_PATH = "./db";
+
+/// @brief The environment variable holding the server source directory, for the recorded samples of the checks
+constexpr const char *TEST_SOURCE_PATH_VARIABLE = "SERVER_SOURCE_PATH";
+
+/// @brief The source directory when the variable is not set
+constexpr const char *TEST_DEFAULT_SOURCE_PATH = ".";
+
+/**
+ * @brief Load the server database the modulator reads its settings from, exit on failure
+ */
+inline void initTestDatabase()
+{
+    const char *path = std::getenv(TEST_DATABASE_PATH_VARIABLE);
+    if (!g_serverDatabase.initDB((path != nullptr) ? path : TEST_DEFAULT_DATABASE_PATH))
+    {
+        std::cerr << "Invalid database directory!" << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Get the path of a file of the server source tree
+ *
+ * @param p_relativePath - the path from the server directory, e.g. sample/input.txt
+ *
+ * @return the path from the directory the check runs in
+ */
+inline std::string getTestSourcePath(const std::string &p_relativePath)
+{
+    const char *path = std::getenv(TEST_SOURCE_PATH_VARIABLE);
+    return std::string((path != nullptr) ? path : TEST_DEFAULT_SOURCE_PATH) + "/" + p_relativePath;
+}
+
+/**
+ * @brief Override a database value in memory, the file is kept as is
+ *
+ * @param p_key - the key, it must exist in the database
+ * @param p_type - the type of the value, e.g. u32, f32 or char
+ * @param p_value - the new value
+ */
+inline void setTestValue(const std::string &p_key, const std::string &p_type, std::string p_value)
+{
+    InMemDatabase::getInstance().modify(p_key, p_type, p_value);
+}
+
+/**
+ * @brief Generate a reproducible random message
+ *
+ * @param p_length - the amount of bits
+ * @param p_seed - the seed of the generator, one seed always gives the same message
+ *
+ * @return the message
+ */
+inline BitBuffer generateTestMessage(const size_t p_length, const unsigned int p_seed)
+{
+    std::default_random_engine generator(p_seed);
+    std::uniform_int_distribution<unsigned int> bit(0, 1);
+    BitBuffer message;
+    for (size_t bitIdx = 0; bitIdx < p_length; ++bitIdx)
+    {
+        message.pushBits(bit(generator), 1);
+    }
+    return message;
+}
+
+/**
+ * @brief Add Gaussian noise to a signal, on top of the NOISE_LEVEL of the modulation session
+ *
+ * @tparam T - the sample type: double, float or int16_t (scaled by INT16_SAMPLE_SCALE)
+ * @param p_signal - the signal
+ * @param p_sigma - the standard deviation of the noise, relative to a unit carrier
+ * @param p_seed - the seed of the generator, one seed always gives the same noise
+ */
+template <typename T>
+void addTestNoise(std::vector<T> &p_signal, const double p_sigma, const unsigned int p_seed)
+{
+    std::default_random_engine generator(p_seed);
+    std::normal_distribution<double> distribution(0.0, p_sigma);
+    for (T &sample : p_signal)
+    {
+        sample = SampleTraits<T>::fromDouble(SampleTraits<T>::toDouble(sample) + distribution(generator));
+    }
+}
+
+/**
+ * @brief Get the name of a scheme for the reports
+ *
+ * @param p_scheme - the scheme
+ *
+ * @return the name, e.g. "16-QAM"
+ */
+inline const char *getSchemeName(const ModulationScheme p_scheme)
+{
+    switch (p_scheme)
+    {
+    case ModulationScheme::ASK:
+        return "ASK";
+    case ModulationScheme::PSK:
+        return "BPSK";
+    case ModulationScheme::FSK:
+        return "FSK";
+    case ModulationScheme::QAM16:
+        return "16-QAM";
+    case ModulationScheme::QPSK:
+        return "QPSK";
+    case ModulationScheme::PSK8:
+        return "8-PSK";
+    case ModulationScheme::QAM64:
+        return "64-QAM";
+    case ModulationScheme::QAM256:
+        return "256-QAM";
+    case ModulationScheme::FSK4:
+        return "4-FSK";
+    case ModulationScheme::FSK8:
+        return "8-FSK";
+    case ModulationScheme::GMSK:
+        return "GMSK";
+    default:
+        return "unknown";
+    }
+}
+
+/**
+ * @brief Time a function, the fastest of a few runs
+ *
+ * @param p_runs - the amount of runs
+ * @param p_function - the function
+ *
+ * @return the time in second
+ */
+template <typename Function>
+double timeFastest(const unsigned int p_runs, Function &&p_function)
+{
+    double fastest = HUGE_VAL;
+    for (unsigned int runIdx = 0; runIdx < p_runs; ++runIdx)
+    {
+        auto start = std::chrono::steady_clock::now();
+        p_function();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        fastest = std::min(fastest, elapsed.count());
+    }
+    return fastest;
+}
+
+/**
+ * @brief Counts the expectations of a check, prints the failed ones and turns the result into the exit status
+ */
+class TestReport
+{
+public:
+    /**
+     * @brief Default constructor, nothing checked yet
+     */
+    TestReport() : m_checkCount(0), m_failureCount(0)
+    {
+    }
+
+    /**
+     * @brief Check one expectation
+     *
+     * @param p_condition - true - the expectation holds
+     * @param p_description - what was compared, printed when it does not hold
+     *
+     * @return p_condition
+     */
+    bool expect(const bool p_condition, const std::string &p_description)
+    {
+        ++m_checkCount;
+        if (!p_condition)
+        {
+            ++m_failureCount;
+            std::cerr << "FAILED: " << p_description << std::endl;
+        }
+        return p_condition;
+    }
+
+    /**
+     * @brief Print the summary
+     *
+     * @return EXIT_SUCCESS when every expectation held, EXIT_FAILURE otherwise
+     */
+    int finish() const
+    {
+        std::cout << (m_checkCount - m_failureCount) << " of " << m_checkCount << " checks passed" << std::endl;
+        return (m_failureCount == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+private:
+    /// @brief The amount of checked expectations
+    size_t m_checkCount;
+
+    /// @brief The amount of expectations that did not hold
+    size_t m_failureCount;
+};
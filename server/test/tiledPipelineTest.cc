@@ -0,0 +1,81 @@
+#include "testCommon.h"
+#include "modulator.h"
+#include "pulseShaper.h"
+
+namespace
+{
+    /// @brief The bits of the messages, whole symbols of every scheme and several tiles long
+    constexpr size_t TEST_MESSAGE_BITS = 1200;
+
+    /// @brief The carrier frequency of the check
+    constexpr double TEST_CARRIER_FREQUENCY = 10;
+
+    /// @brief The largest relative difference between the tiled and the materialized energy, the summation order differs
+    constexpr double ENERGY_TOLERANCE = 1e-12;
+
+    /**
+     * @brief Receive a noiseless session tile by tile and compare every stage with the materialized signal
+     *
+     * @tparam T - the sample type
+     * @param p_report - the report of the check
+     * @param p_scheme - the scheme
+     * @param p_typeName - the name of the sample type
+     * @param p_isTiled - true - the scheme is received symbol by symbol in several tiles, false - in one tile
+     */
+    template <typename T>
+    void checkTiles(TestReport &p_report, const ModulationScheme p_scheme, const char *p_typeName, const bool p_isTiled)
+    {
+        Modulator modulator;
+        modulator.setFrequency(TEST_CARRIER_FREQUENCY);
+        modulator.setNoisy(false);
+        BitBuffer message = generateTestMessage(TEST_MESSAGE_BITS, static_cast<unsigned int>(p_scheme));
+        modulator.setBinaryInput(message);
+        std::vector<T> signal = modulator.modulate<T>(p_scheme);
+        BitBuffer expected = modulator.demodulate(signal, p_scheme);
+        double energy = 0;
+        double peakAmplitude = 0;
+        for (const T &sample : signal)
+        {
+            energy += SampleTraits<T>::toDouble(sample) * SampleTraits<T>::toDouble(sample);
+            peakAmplitude = std::max(peakAmplitude, std::abs(SampleTraits<T>::toDouble(sample)));
+        }
+
+        ModulationSession session = modulator.startModulation(p_scheme);
+        LinkStatistics statistics;
+        std::vector<T> exported;
+        BitBuffer received = modulator.receiveTiled<T>(session, p_scheme, statistics, [&exported](const T *p_samples, size_t p_count)
+                                                       { exported.insert(exported.end(), p_samples, p_samples + p_count); });
+
+        std::string name = stringify(getSchemeName(p_scheme), " ", p_typeName);
+        p_report.expect(exported == signal, stringify(name, ": the exported tiles differ from the modulated signal"));
+        p_report.expect(received.size() == expected.size() && expected.countErrors(received, 0) == 0,
+                        stringify(name, ": the tiled bits differ from the demodulated ones"));
+        p_report.expect(statistics.sampleCount == signal.size() && (p_isTiled ? statistics.tileCount > 1 : statistics.tileCount == 1),
+                        stringify(name, ": ", statistics.sampleCount, " samples in ", statistics.tileCount, " tiles"));
+        p_report.expect(std::abs(statistics.energy - energy) <= ENERGY_TOLERANCE * energy && statistics.peakAmplitude == peakAmplitude,
+                        stringify(name, ": energy ", statistics.energy, " and peak ", statistics.peakAmplitude, " instead of ",
+                                  energy, " and ", peakAmplitude));
+        p_report.expect(statistics.bitErrors == message.countErrors(received, 0) && statistics.bitErrors == 0,
+                        stringify(name, ": ", statistics.bitErrors, " bit errors counted"));
+    }
+}
+
+int main()
+{
+    initTestDatabase();
+    TestReport report;
+    for (ModulationScheme scheme : {ModulationScheme::ASK, ModulationScheme::PSK, ModulationScheme::FSK, ModulationScheme::QAM16,
+                                    ModulationScheme::QPSK, ModulationScheme::PSK8, ModulationScheme::QAM64, ModulationScheme::FSK8,
+                                    ModulationScheme::GMSK})
+    {
+        checkTiles<double>(report, scheme, "double", scheme != ModulationScheme::GMSK);
+        checkTiles<float>(report, scheme, "float", scheme != ModulationScheme::GMSK);
+        checkTiles<int16_t>(report, scheme, "int16", scheme != ModulationScheme::GMSK);
+    }
+
+    // Shaped pulses need the whole signal, it goes through the stages as one tile
+    setTestValue(PULSE_SHAPE_KEY, "char", "rrc");
+    checkTiles<double>(report, ModulationScheme::QPSK, "double, RRC pulses", false);
+    checkTiles<int16_t>(report, ModulationScheme::QAM16, "int16, RRC pulses", false);
+    return report.finish();
+}